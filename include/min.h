@@ -1687,8 +1687,19 @@ namespace min {
 
     namespace internal {
 
-	extern min::stub ** acc_stack;
-	extern min::stub ** volatile acc_stack_limit;
+	// Variables declared MIN_THREAD_LOCAL have one
+	// value per thread if MIN_MUTATOR_THREADS is 1
+	// (see min::mutator_thread below).
+	//
+#	if MIN_MUTATOR_THREADS
+#	    define MIN_THREAD_LOCAL __thread
+#	else
+#	    define MIN_THREAD_LOCAL
+#	endif
+
+	extern MIN_THREAD_LOCAL min::stub ** acc_stack;
+	extern MIN_THREAD_LOCAL min::stub ** volatile
+	    acc_stack_limit;
 	    // acc_stack points at the first unused
 	    // location in the acc stack.  If
 	    // acc_stack >= acc_stack_limit, an
@@ -1709,6 +1720,12 @@ namespace min {
 	    // acc_stack_limit =< acc_stack, and work
 	    // that leads to interrupts may be counted
 	    // by decreasing acc_stack_limit.
+	    //
+	    // If MIN_MUTATOR_THREADS is 1, each thread
+	    // has its own acc stack, and another thread
+	    // may set acc_stack_limit to NULL to make
+	    // this thread stop for a collector incre-
+	    // ment at its next interrupt check.
 
 	// Out of line function to execute interrupt.
 	// Provided by ACC as most interrupts merely
@@ -1841,6 +1858,39 @@ namespace min { namespace internal {
 	    acc_expand_stub_free_list ( n );
     }
 
+    // If MIN_MUTATOR_THREADS is 1, the stub free list,
+    // the fixed size block lists, the body regions,
+    // and the atom hash tables are shared by all muta-
+    // tor threads, and are only used while holding the
+    // allocator lock.  An allocator_lock holds the lock
+    // while it exists, and may be nested.  A thread
+    // never stops for the collector while holding the
+    // lock, so code holding it must not check for
+    // interrupts.  If MIN_MUTATOR_THREADS is 0, an
+    // allocator_lock does nothing.
+    //
+#   if MIN_MUTATOR_THREADS
+	void lock_allocator ( void );
+	void unlock_allocator ( void );
+
+	struct allocator_lock
+	{
+	    allocator_lock ( void )
+	    {
+		lock_allocator();
+	    }
+	    ~ allocator_lock ( void )
+	    {
+		unlock_allocator();
+	    }
+	};
+#   else
+	struct allocator_lock
+	{
+	    allocator_lock ( void ) {}
+	};
+#   endif
+
     // Hash tables for atoms.  There are two hash tables
     // for every kind of atom: the acc hash table for
     // non-ephemeral stubs and the aux hash table for
@@ -1875,23 +1925,188 @@ namespace min { namespace internal {
     // a stub from the aux hash table to the correspond-
     // ing acc hash table when the stub ceases to be
     // ephemeral.
+    //
+    // Xxx_hash_count is the number of stubs in the acc
+    // and aux hash tables for xxx.  When this becomes
+    // too large the acc doubles the size of the tables.
+    // The old tables are then saved in xxx_acc_hash_
+    // old and xxx_aux_hash_old, whose size is xxx_hash_
+    // old_size, and new tables are allocated for xxx_
+    // acc_hash and xxx_aux_hash.  Collector increments
+    // then move the lists of the old tables to the new
+    // tables, one old table index at a time, in order
+    // of increasing index.  Old table lists with index
+    // < xxx_hash_rehashed have been moved and are
+    // empty.  When all old lists have been moved, the
+    // old tables are freed and xxx_acc_hash_old is
+    // set to NULL.  Xxx_acc_hash_old is NULL whenever
+    // no resize is in progress, and xxx_hash_heads
+    // (see end of this file) is used to find the
+    // lists that hold a stub with a given hash.
 
     extern min::stub ** str_acc_hash;
     extern min::stub ** str_aux_hash;
     extern min::unsptr str_hash_size;
     extern min::unsptr str_hash_mask;
+    extern min::unsptr str_hash_count;
+    extern min::stub ** str_acc_hash_old;
+    extern min::stub ** str_aux_hash_old;
+    extern min::unsptr str_hash_old_size;
+    extern min::unsptr str_hash_rehashed;
 
 #   if MIN_IS_COMPACT
 	extern min::stub ** num_acc_hash;
 	extern min::stub ** num_aux_hash;
 	extern min::unsptr num_hash_size;
 	extern min::unsptr num_hash_mask;
+	extern min::unsptr num_hash_count;
+	extern min::stub ** num_acc_hash_old;
+	extern min::stub ** num_aux_hash_old;
+	extern min::unsptr num_hash_old_size;
+	extern min::unsptr num_hash_rehashed;
 #   endif
 
     extern min::stub ** lab_acc_hash;
     extern min::stub ** lab_aux_hash;
     extern min::unsptr lab_hash_size;
     extern min::unsptr lab_hash_mask;
+    extern min::unsptr lab_hash_count;
+    extern min::stub ** lab_acc_hash_old;
+    extern min::stub ** lab_aux_hash_old;
+    extern min::unsptr lab_hash_old_size;
+    extern min::unsptr lab_hash_rehashed;
+
+#   if MIN_FLAT_HASH_INDEX
+
+    // A hash index is an open addressing hash table
+    // whose entries hold the stubs in the lists of the
+    // acc and aux hash tables of a stub type xxx.
+    // Looking a stub up in the index touches one or
+    // two cache lines, instead of following a list
+    // through stub control words and HASHTABLE_AUX
+    // aux stubs.  The acc and aux hash table lists are
+    // still maintained, as the collector uses them to
+    // distinguish ephemeral stubs (in aux lists) from
+    // level 0 stubs (in acc lists).
+    //
+    // The index is a vector of buckets, each of which
+    // is 8 min::uns64 entries that fill one 64 byte
+    // cache line.  Each entry is either HASH_INDEX_
+    // EMPTY, HASH_INDEX_DELETED, or
+    //
+    //	  ( fingerprint << 48 ) + stub index
+    //
+    // where the stub index is the index of the stub
+    // relative to MINT::stub_base and the fingerprint
+    // is 16 bits computed from the stub's hash by
+    // hash_index_fingerprint.  A stub with hash h is in
+    // the first entry that is not deleted and not
+    // occupied by another stub of the buckets h & mask,
+    // (h+1) & mask, (h+2) & mask, ..., and is not in
+    // the index if an empty entry is found first.
+    //
+    // The index is grown (or rebuilt to remove deleted
+    // entries) when more than 3/4 of its entries are
+    // used.
+    //
+    struct hash_index
+    {
+	min::uns64 * buckets;
+	    // First entry of first bucket, aligned on
+	    // a 64 byte boundary.
+	min::uns64 * memory;
+	    // Memory allocated for buckets by new[].
+	min::unsptr mask;
+	    // Number of buckets - 1.  Number of
+	    // buckets is a power of 2.
+	min::unsptr used;
+	    // Number of entries that are not EMPTY.
+	min::unsptr live;
+	    // Number of entries that are not EMPTY or
+	    // DELETED.
+    };
+    const min::uns64 HASH_INDEX_EMPTY = 0;
+    const min::uns64 HASH_INDEX_DELETED = ~ 0ull;
+    const min::uns64 HASH_INDEX_STUB_MASK =
+        ( 1ull << 48 ) - 1;
+
+    extern hash_index str_hash_index;
+#   if MIN_IS_COMPACT
+	extern hash_index num_hash_index;
+#   endif
+    extern hash_index lab_hash_index;
+
+    inline min::uns64 hash_index_fingerprint
+	    ( min::uns32 hash )
+    {
+	return ( hash * 0x9E3779B9u ) >> 16;
+    }
+
+    // Iterate over the stubs in a hash index whose
+    // fingerprint matches that of a hash.  Usage:
+    //
+    //	  hash_index_probe probe ( index, hash );
+    //	  while ( min::stub * s = probe.next() )
+    //	      ... if s matches return s ...
+    //
+    // The index must not be modified while iterating.
+    //
+    struct hash_index_probe
+    {
+	hash_index & index;
+	min::uns64 fingerprint;
+	min::unsptr bucket;
+	unsigned i;
+
+	hash_index_probe
+		( hash_index & index, min::uns32 hash )
+	    : index ( index ),
+	      fingerprint
+	          ( hash_index_fingerprint ( hash ) ),
+	      bucket ( hash & index.mask ),
+	      i ( 0 ) {}
+
+	// Return the next stub with a matching finger-
+	// print, or NULL if there are no more.
+	//
+	min::stub * next ( void )
+	{
+	    if ( index.buckets == NULL ) return NULL;
+	    while ( true )
+	    {
+		if ( i == 8 )
+		{
+		    bucket = ( bucket + 1 ) & index.mask;
+		    i = 0;
+		}
+		min::uns64 e =
+		    index.buckets[8 * bucket + i ++];
+		if ( e == HASH_INDEX_EMPTY )
+		    return NULL;
+		if ( e != HASH_INDEX_DELETED
+		     &&
+		     ( e >> 48 ) == fingerprint )
+		    return   (min::stub *) stub_base
+			   + ( e & HASH_INDEX_STUB_MASK );
+	    }
+	}
+    };
+
+    // Insert stub s with the given hash into a hash
+    // index.  S must not already be in the index.
+    //
+    void hash_index_insert
+	    ( hash_index & index, min::uns32 hash,
+	      min::stub * s );
+
+    // Remove stub s with the given hash from a hash
+    // index.  MIN_ABORT if s is not in the index.
+    //
+    void hash_index_remove
+	    ( hash_index & index, min::uns32 hash,
+	      min::stub * s );
+
+#   endif // MIN_FLAT_HASH_INDEX
 
     // ACC flags to be set and cleared when a stub is
     // found in the hash table and returned as a
@@ -1982,7 +2197,7 @@ namespace min { namespace internal {
     // in MUP::acc_stack_mask.
     //
     extern min::uns64 acc_stack_mask;
-    extern min::stub ** acc_stack;
+    extern MIN_THREAD_LOCAL min::stub ** acc_stack;
 
 } }
 
@@ -2051,17 +2266,35 @@ namespace min { namespace unprotected {
     // ( s1, s2 ) for every stub pointer s2 in one of
     // the general values.
     //
+    // The flags of s1 are fetched once, and nothing is
+    // done for the n values if no flag of s1 is enabled
+    // in acc_stack_mask, which is the usual case.
+    //
     inline void acc_write_update
 	    ( const min::stub * s1,
 	      const min::gen * p, min::unsptr n )
     {
+	if ( s1 == ZERO_STUB ) return;
+        uns64 f1 = (    min::unprotected
+	                   ::control_of ( s1 )
+	             >> min::internal::ACC_FLAG_PAIRS )
+		 & min::internal::acc_stack_mask;
+	if ( f1 == 0 ) return;
+
         while ( n -- )
 	{
 	    min::gen g = * p ++;
-	    if ( min::is_stub ( g ) )
-	        acc_write_update
-		    ( s1, min::unprotected
-		             ::stub_of ( g ) );
+	    if ( ! min::is_stub ( g ) ) continue;
+	    const min::stub * s2 =
+	        min::unprotected::stub_of ( g );
+	    if (   min::unprotected::control_of ( s2 )
+	         & f1 )
+	    {
+		* min::internal::acc_stack ++ =
+		    (min::stub *) s1;
+		* min::internal::acc_stack ++ =
+		    (min::stub *) s2;
+	    }
 	}
     }
 
@@ -2083,8 +2316,26 @@ namespace min { namespace unprotected {
 	      const min::stub * const * p,
 	      min::unsptr n )
     {
+	if ( s1 == ZERO_STUB ) return;
+        uns64 f1 = (    min::unprotected
+	                   ::control_of ( s1 )
+	             >> min::internal::ACC_FLAG_PAIRS )
+		 & min::internal::acc_stack_mask;
+	if ( f1 == 0 ) return;
+
         while ( n -- )
-	    acc_write_update ( s1, * p ++ );
+	{
+	    const min::stub * s2 = * p ++;
+	    if ( s2 == NULL ) continue;
+	    if (   min::unprotected::control_of ( s2 )
+	         & f1 )
+	    {
+		* min::internal::acc_stack ++ =
+		    (min::stub *) s1;
+		* min::internal::acc_stack ++ =
+		    (min::stub *) s2;
+	    }
+	}
     }
 
 } }
@@ -2202,6 +2453,67 @@ namespace min { namespace internal {
     //
     extern min::uns64 new_acc_stub_flags;
 
+    // When MUP::acc_stubs_allocated reaches this value,
+    // new_acc_stub schedules an interrupt by setting
+    // acc_stack_limit = acc_stack.  Maintained by the
+    // acc to enforce MACC::allocation_budget; ~0 when
+    // no such interrupt is wanted.
+    //
+    extern min::uns64 acc_budget_limit;
+
+#   if MIN_MUTATOR_THREADS
+
+	// If MIN_MUTATOR_THREADS is 1, each thread takes
+	// acc stubs from its own stub buffer.  This is
+	// a run of stubs taken from the front of the
+	// free list MACC::stub_buffer_size at a time,
+	// which then precede the last_allocated_stub on
+	// the acc list.  Stubs are counted in MUP::acc_
+	// stubs_allocated when the buffer is refilled or
+	// the mutator threads are stopped.
+	//
+	// The control of the last_allocated_stub is
+	// changed by new_aux_stub and free_aux_stub, so
+	// that stub must not be handed out by new_acc_
+	// stub.  Therefore the last stub taken, the
+	// fence, is kept in the buffer until another
+	// run is taken.  The acc returns the stubs left
+	// in every buffer to the free list whenever it
+	// stops the mutator threads.
+	//
+	struct stub_buffer
+	{
+	    min::stub * next;
+		// Next stub to hand out.  Equals fence
+		// if count == 0.
+	    min::unsptr count;
+		// Number of stubs that may be handed
+		// out, not counting the fence.
+	    min::stub * fence;
+		// Last stub taken, or NULL if the buffer
+		// is empty.
+	    min::stub * previous;
+		// Stub whose control points at next.
+	    min::uns64 serial;
+		// Number of runs taken by all threads
+		// when the last run of this buffer was
+		// taken.
+	    min::unsptr allocated;
+		// Number of stubs handed out and not yet
+		// added to MUP::acc_stubs_allocated.
+	};
+	extern MIN_THREAD_LOCAL stub_buffer
+	    acc_stub_buffer;
+
+	// Out of line function to take a run of stubs
+	// for acc_stub_buffer and return a stub to be
+	// handed out, which may be the old fence.  Pro-
+	// vided by the acc.
+	//
+	min::stub * acc_refill_stub_buffer ( void );
+
+#   endif
+
 } }
 
 namespace min { namespace unprotected {
@@ -2224,21 +2536,49 @@ namespace min { namespace unprotected {
     // the non-type part of the stub control is main-
     // tained by the acc.
     //
+    // If MIN_MUTATOR_THREADS is 1 the stub is taken
+    // from the thread's stub buffer, and is not the
+    // last_allocated_stub.
+    //
     inline min::stub * new_acc_stub ( void )
     {
-	if ( internal::number_of_free_stubs == 0 )
-	    internal::acc_expand_stub_free_list ( 1 );
-
-	-- internal::number_of_free_stubs;
-	++ unprotected::acc_stubs_allocated;
-
-	uns64 c = unprotected::control_of
-		    ( internal::last_allocated_stub );
-	min::stub * s =
-	    unprotected::stub_of_acc_control ( c );
-	unprotected::set_flags_of
-	    ( s, internal::new_acc_stub_flags );
-	return internal::last_allocated_stub = s;
+#	if MIN_MUTATOR_THREADS
+	    internal::stub_buffer & b =
+		internal::acc_stub_buffer;
+	    min::stub * s;
+	    if ( b.count == 0 )
+		s = internal::acc_refill_stub_buffer();
+	    else
+	    {
+		s = b.next;
+		b.next = unprotected::stub_of_acc_control
+			     ( unprotected::control_of
+				   ( s ) );
+		-- b.count;
+		++ b.allocated;
+		b.previous = s;
+	    }
+	    unprotected::set_flags_of
+		( s, internal::new_acc_stub_flags );
+	    return s;
+#	else
+	    if ( internal::number_of_free_stubs == 0 )
+		internal::acc_expand_stub_free_list ( 1 );
+
+	    -- internal::number_of_free_stubs;
+	    if (    ++ unprotected::acc_stubs_allocated
+		 >= internal::acc_budget_limit )
+		internal::acc_stack_limit =
+		    internal::acc_stack;
+
+	    uns64 c = unprotected::control_of
+			( internal::last_allocated_stub );
+	    min::stub * s =
+		unprotected::stub_of_acc_control ( c );
+	    unprotected::set_flags_of
+		( s, internal::new_acc_stub_flags );
+	    return internal::last_allocated_stub = s;
+#	endif
     }
 
     // Function to return the next free stub while
@@ -2251,6 +2591,8 @@ namespace min { namespace unprotected {
     //
     inline min::stub * new_aux_stub ( void )
     {
+	internal::allocator_lock lock;
+
 	if ( internal::number_of_free_stubs == 0 )
 	    internal::acc_expand_stub_free_list ( 1 );
 
@@ -2282,6 +2624,8 @@ namespace min { namespace unprotected {
     //
     inline void free_aux_stub ( min::stub * s )
     {
+	internal::allocator_lock lock;
+
         unprotected::set_gen_of ( s, NONE() );
 	uns64 c = unprotected::control_of
 		( internal::last_allocated_stub );
@@ -2373,6 +2717,26 @@ namespace min { namespace internal {
     } fixed_block_lists
           [number_fixed_block_lists];
 
+    // fixed_block_runs[j] is a run of never used blocks
+    // of fixed_block_lists[j] that begin in one page of
+    // a region.  When the free list is empty, blocks
+    // are allocated from the run by bumping next.
+    //
+    // If MIN_MUTATOR_THREADS is 1, each thread has its
+    // own runs, and takes blocks from them before the
+    // free list, without the allocator lock.
+    //
+    extern MIN_THREAD_LOCAL struct fixed_block_run
+    {
+	min::uns8 * next;
+	min::uns8 * end;
+			// next == end if there is no
+			// run.
+	int locator;
+			// Locator of the page.
+    } fixed_block_runs
+          [number_fixed_block_lists];
+
     // Out of line allocators.  Only called by min::
     // new_body.
     //
@@ -2382,6 +2746,28 @@ namespace min { namespace internal {
 	( min::stub * s, min::unsptr n,
 	  fixed_block_list * fbl );
 
+    // Allocate the first block on the free list of fbl,
+    // which must not be empty, to s.
+    //
+    inline void new_free_fixed_body
+	( min::stub * s, fixed_block_list * fbl )
+    {
+	free_fixed_size_block * b =
+	    fbl->last_free->next;
+
+	fbl->last_free->next = b->next;
+	if ( -- fbl->count == 0 )
+	    fbl->last_free = NULL;
+
+	b->block_control =
+	    unprotected::renew_control_stub
+	        ( b->block_control, s );
+	unprotected::set_ptr_of
+	    ( s, & b->block_control + 1 );
+	unprotected::set_flags_of
+	       ( s, internal::ACC_FIXED_BODY_FLAG );
+    }
+
     extern min::unsptr min_fixed_block_size;
         // The smallest power of 2 not smaller than the
 	// size of min::internal::free_fixed_size_block.
@@ -2456,30 +2842,43 @@ namespace min { namespace unprotected {
 	// See min_parameters.h for log2floor.
 	//
 	m = m - 1;
+	unsigned j = internal::log2floor ( m ) + 1 - 3;
 	internal::fixed_block_list * fbl =
-		  internal::fixed_block_lists
-		+ internal::log2floor ( m )
-		+ 1 - 3;
+	    internal::fixed_block_lists + j;
+	internal::fixed_block_run * run =
+	    internal::fixed_block_runs + j;
 
-	if ( fbl->count == 0 )
-	{
-	     internal::new_fixed_body
-	          ( s, n, fbl );
-	     return;
-	}
-
-	internal::free_fixed_size_block * b =
-	    fbl->last_free->next;
-
-	fbl->last_free->next = b->next;
-	if ( -- fbl->count == 0 )
-	    fbl->last_free = NULL;
+#	if MIN_MUTATOR_THREADS
+	    if ( run->next == run->end )
+	    {
+		internal::allocator_lock lock;
+		if ( fbl->count == 0 )
+		    internal::new_fixed_body
+			( s, n, fbl );
+		else
+		    internal::new_free_fixed_body
+			( s, fbl );
+		return;
+	    }
+#	else
+	    if ( fbl->count > 0 )
+	    {
+		internal::new_free_fixed_body ( s, fbl );
+		return;
+	    }
+	    if ( run->next == run->end )
+	    {
+		 internal::new_fixed_body
+		      ( s, n, fbl );
+		 return;
+	    }
+#	endif
 
-	b->block_control =
-	    unprotected::renew_control_stub
-	        ( b->block_control, s );
-	unprotected::set_ptr_of
-	    ( s, & b->block_control + 1 );
+	min::uns64 * bp = (min::uns64 *) run->next;
+	run->next += fbl->size;
+	* bp = unprotected::new_control_with_locator
+		   ( run->locator, s );
+	unprotected::set_ptr_of ( s, bp + 1 );
 	unprotected::set_flags_of
 	       ( s, internal::ACC_FIXED_BODY_FLAG );
     }
@@ -2655,6 +3054,30 @@ namespace min { namespace unprotected {
 	r.new_type = new_type;
     }
 
+    // Try to change the size of the body of stub s from
+    // old_size to new_size bytes without moving it.
+    // Return true if this is done, and false if the
+    // body must instead be moved with resize_body.
+    // This succeeds if the new size fits in the block
+    // holding the body, or if that block is the last
+    // block of a variable size or paged body region
+    // that has room for the new size.  This function
+    // is provided by the acc.
+    //
+    bool resize_body_in_place
+	( min::stub * s, min::unsptr new_size,
+	                 min::unsptr old_size );
+
+    // Copy the first n bytes of the body at `from' to
+    // the body at `to', where the body at `from' is
+    // about to be deallocated.  The acc moves the
+    // whole pages of large paged bodies by remapping
+    // them, and the contents of `from' are then lost.
+    // This function is provided by the acc.
+    //
+    void move_body_contents
+	( void * to, void * from, min::unsptr n );
+
 } }
 
 namespace min {
@@ -2677,6 +3100,9 @@ namespace min { namespace internal {
     // control struct as argument.
     //
     struct scavenge_control;
+#   if MIN_MUTATOR_THREADS
+	struct mutator_context;
+#   endif
     typedef void (*scavenger_routine)
         ( scavenge_control & sc );
 
@@ -2829,9 +3255,50 @@ namespace min { namespace internal {
 	min::locatable_gen * locatable_gen_last;
 	   // Pointers to locatable variables from
 	   // which to resume if thread_state != 0.
+
+#	if MIN_MUTATOR_THREADS
+	    mutator_context * thread_context;
+	       // Mutator context whose locatable
+	       // variables are being scavenged if
+	       // thread_state != 0.
+#	endif
   
     };
 
+    // Called by a scavenger routine that has found
+    // that c, the control of s2, has the sc.clear_flag
+    // bit on.  Turns that bit off and the set_flag bit
+    // on in the control of s2, and returns true if
+    // this call turned the clear_flag bit off.  The
+    // routine pushes s2 onto its to-be-scavenged stack
+    // only if true is returned.
+    //
+    // If MIN_PARALLEL_MARKERS, several marker threads
+    // may find s2 at the same time (see min_acc.cc),
+    // so the control of s2 is updated atomically and
+    // only one of them is returned true.
+    //
+    inline bool scavenge_claim
+	    ( min::stub * s2, min::uns64 c,
+	      min::uns64 clear_flag,
+	      min::uns64 set_flag )
+    {
+#	if MIN_PARALLEL_MARKERS
+	    if ( set_flag != 0 )
+		__atomic_fetch_or
+		    ( & s2->c.u64, set_flag,
+		      __ATOMIC_RELAXED );
+	    return   __atomic_fetch_and
+			 ( & s2->c.u64, ~ clear_flag,
+			   __ATOMIC_RELAXED )
+		   & clear_flag;
+#	else
+	    unprotected::set_control_of
+		( s2, ( c | set_flag ) & ~ clear_flag );
+	    return true;
+#	endif
+    }
+
     // Function to scavenge the static and thread loca-
     // table_gen, locatable_num_gen, and locatable_stub_
     // ptr structures, finding all pointers therein to
@@ -3361,9 +3828,13 @@ namespace min {
 
     namespace internal {
 
-	extern min::locatable_stub_ptr *
+	// Heads of the lists of locatable variables.
+	// These are thread local if MIN_MUTATOR_
+	// THREADS is 1.
+	//
+	extern MIN_THREAD_LOCAL min::locatable_stub_ptr *
 	    locatable_stub_ptr_last;
-	extern min::locatable_gen *
+	extern MIN_THREAD_LOCAL min::locatable_gen *
 	    locatable_gen_last;
 
 	template < typename T >
@@ -3548,6 +4019,156 @@ namespace min {
     }
 }
 
+// If MIN_MUTATOR_THREADS is 1 (see min_parameters.h),
+// several threads may use MIN at the same time.  The
+// thread that calls min::initialize is a mutator
+// thread from then on, and other threads become
+// mutator threads by constructing a min::mutator_
+// thread.
+//
+// Each mutator thread has its own locatable variable
+// lists, acc stack, stub buffer (see MUP::new_acc_
+// stub), and fixed block runs (see MUP::new_body).
+// Other allocation and the atom hash tables are shared
+// under the allocator lock.  The threads
+// must not change the same object at the same time
+// without locking it themselves.
+//
+// A thread that runs a collector increment first stops
+// all the other mutator threads, so the collector
+// only runs while no mutator does.  A mutator thread
+// stops at its next interrupt check, so each mutator
+// thread must call min::interrupt() regularly, and
+// must hold a min::mutator_unlock while it waits for
+// anything.  When all threads have stopped, the acc
+// takes the pairs in every acc stack and returns the
+// stubs left in every stub buffer to the free list.
+//
+# if MIN_MUTATOR_THREADS
+
+namespace min {
+
+    namespace internal {
+
+	// The mutator context of a thread points at
+	// the thread's thread local variables.  Con-
+	// texts are on a doubly linked list whose
+	// first element is the context of the thread
+	// that called min::initialize.  The list only
+	// changes while the mutator threads are
+	// stopped.
+	//
+	struct mutator_context
+	{
+	    min::locatable_stub_ptr **
+	        locatable_stub_ptr_last;
+	    min::locatable_gen ** locatable_gen_last;
+	    min::stub *** acc_stack;
+	    min::stub ** volatile * acc_stack_limit;
+	    min::stub ** acc_stack_begin;
+	    min::stub ** acc_stack_end;
+	        // Set by acc_initialize_thread or the
+		// acc initializer.
+	    stub_buffer * acc_stub_buffer;
+	    fixed_block_run * fixed_block_runs;
+	    mutator_context * previous;
+	    mutator_context * next;
+	};
+	extern mutator_context * mutator_contexts;
+
+	// Make this thread a running mutator thread,
+	// waiting if other threads are stopped, or
+	// stop being one.
+	//
+	void lock_mutator ( void );
+	void unlock_mutator ( void );
+
+	// Stop all other mutator threads, so this
+	// thread may run the collector, or restart
+	// them.  Calls to stop_mutators may be nested,
+	// each matched by a call to start_mutators.
+	// But if another thread is stopping the muta-
+	// tor threads when this thread is not, stop_
+	// mutators stops this thread until the other
+	// thread restarts them, and then returns false
+	// without stopping anything.  Otherwise it
+	// returns true.
+	//
+	bool stop_mutators ( void );
+	void start_mutators ( void );
+
+	// Provided by the acc.  acc_stop_mutators is
+	// called by the outermost stop_mutators after
+	// the other threads stop, and acc_start_mutators
+	// is called by the matching start_mutators
+	// before they restart.  A new mutator thread
+	// allocates its acc stack when it first stops
+	// the other threads, and then acc_initialize_
+	// thread puts it in the thread's context.  acc_
+	// finalize_thread empties and frees it.  Both
+	// are called while the mutator threads are
+	// stopped.
+	//
+	void acc_stop_mutators ( void );
+	void acc_start_mutators ( void );
+	void acc_initialize_thread
+	    ( mutator_context * context );
+	void acc_finalize_thread
+	    ( mutator_context * context );
+    }
+
+    // A thread that did not call min::initialize must
+    // construct a mutator_thread before using MIN, and
+    // must not use MIN after it is destroyed.  The
+    // constructor and destructor add and remove the
+    // thread's mutator context while the other mutator
+    // threads are stopped.
+    //
+    class mutator_thread
+    {
+    public:
+
+        mutator_thread ( void );
+        ~ mutator_thread ( void );
+
+    private:
+
+        internal::mutator_context context;
+    };
+
+    // Stop being a running mutator thread while a
+    // mutator_unlock exists, e.g., while waiting for
+    // other threads, so the collector need not wait
+    // for this thread.  MIN may not be used in the
+    // meantime.  The destructor waits if the mutator
+    // threads are stopped, and is relocating.
+    //
+    class mutator_unlock
+    {
+    public:
+
+        mutator_unlock ( void )
+	{
+	    internal::unlock_mutator();
+	}
+        ~ mutator_unlock ( void )
+	{
+	    internal::lock_mutator();
+	}
+    };
+
+    // Stop if another thread is stopping the mutator
+    // threads.  Relocating.
+    //
+    inline void mutator_yield ( void )
+    {
+        internal::unlock_mutator();
+        internal::lock_mutator();
+    }
+}
+
+# endif // MIN_MUTATOR_THREADS
+
 // Use MIN_STUB_PTR_CLASS(TARGS,T) if the type
 // template< TARGS > class T is convertable to a
 // const min::stub * value.  This
@@ -3964,13 +4585,27 @@ namespace min {
     const min::unsptr DEFAULT_MAX_ID_STRLEN = 32;
 
     // Functions to compute the hash of an arbitrary
-    // char string.
+    // char string.  The hash function is selected by
+    // MIN_STRHASH (see min_parameters.h).  Strnhash
+    // stops at the first NUL, so strnhash ( p, n ) ==
+    // strhash ( p ) if p has a NUL in its first n
+    // characters.
     //
     min::uns32 strnhash
 	    ( const char * p, min::unsptr size );
     //
     min::uns32 strhash ( const char * p );
 
+#   if MIN_STRHASH == 1 && MIN_STRHASH_SEED
+	namespace internal {
+	    // Seed of the MIN_STRHASH == 1 hash.  Set
+	    // by min::initialize before any string is
+	    // hashed.
+	    //
+	    extern min::uns64 strhash_seed;
+	}
+#   endif
+
     min::unsptr strlen ( min::gen g );
     min::uns32 strhash ( min::gen g );
     char * strcpy ( char * p, min::gen g );
@@ -4996,6 +5631,15 @@ namespace min {
 	    const min::uns32 * const gen_disp;
 	    const min::uns32 * const stub_disp;
 
+	    void ( * release ) ( min::stub * s );
+	        // If not NULL, called by the collector
+		// with each stub of this type that it
+		// collects, just before the stub body
+		// is deallocated, to release resources
+		// outside the acc held by the body.  It
+		// must not allocate or use acc memory
+		// other than the body.
+
 	    // Since many members of the descriptor are
 	    // const's, we need to set them with a
 	    // constructor.
@@ -5012,7 +5656,8 @@ namespace min {
 		      ( type, subtype, id, name ),
 		  size ( size ),
 		  gen_disp ( gen_disp ),
-		  stub_disp ( stub_disp ) {}
+		  stub_disp ( stub_disp ),
+		  release ( NULL ) {}
 	};
 
 	// Pointer base inherited by public pointer
@@ -5405,9 +6050,19 @@ namespace min {
 	    const min::uns32 * const
 	                       header_stub_disp;
 
+	    // Growth policy, which may be set for each
+	    // packed vector type.  Reserve grows a full
+	    // vector by increment_ratio * max_length
+	    // elements, but by at most max_increment
+	    // elements.  If fill_body is true, the new
+	    // max_length is then increased so the body
+	    // fills the block it is allocated in (see
+	    // MUP::optimal_body_size).
+	    //
 	    min::unsptr initial_max_length;
 	    min::float64 increment_ratio;
 	    min::unsptr max_increment;
+	    bool fill_body;
 
 	    packed_vec_descriptor
 	        ( min::int32 type,
@@ -5445,7 +6100,8 @@ namespace min {
 
 		  initial_max_length ( 128 ),
 		  increment_ratio (0.5),
-		  max_increment ( 1 << 24 ) {}
+		  max_increment ( 1 << 24 ),
+		  fill_body ( false ) {}
 	};
 
 	template < typename E, typename H, typename L >
@@ -6181,6 +6837,17 @@ void min::packed_vec_insptr<E,H,L>::reserve
 	reserve_length + hp->length;
     if ( new_length < min_new_length )
 	new_length = min_new_length;
+    if ( pvdescriptor->fill_body )
+    {
+	unsptr size =
+	    unprotected::optimal_body_size
+		(   pvdescriptor->header_size
+		  +   (unsptr) new_length
+		    * pvdescriptor->element_size );
+	new_length = (L)
+	    (   ( size - pvdescriptor->header_size )
+	      / pvdescriptor->element_size );
+    }
     internal::packed_vec_resize<L>
 	( this->s, pvdescriptor, new_length );
 }
@@ -6247,12 +6914,23 @@ void min::internal::packed_vec_resize
 		    +   max_length
                       * pvd->element_size;
     if ( copy_size > new_size ) copy_size = new_size;
+    if ( min::unprotected::resize_body_in_place
+	     ( (min::stub *) s, new_size, old_size ) )
+    {
+	* (L *) ( old_p + pvd->max_length_disp ) =
+	    max_length;
+	if ( length > max_length )
+	    * (L *) ( old_p + pvd->length_disp ) =
+		max_length;
+	return;
+    }
     min::unprotected::resize_body r
 	( (min::stub *) s, new_size, old_size );
     uns8 * & new_p =
         * (uns8 **)
 	& min::unprotected::new_body_ptr_ref ( r );
-    memcpy ( (void *) new_p, old_p, copy_size );
+    min::unprotected::move_body_contents
+        ( (void *) new_p, old_p, copy_size );
     * (L *) ( new_p + pvd->max_length_disp ) =
         max_length;
     if ( length > max_length )
@@ -6327,6 +7005,16 @@ namespace min {
 
 	std::istream *		istream;
 	const min::file		ifile;
+	const char *		map;
+	min::uns64		map_size;
+	min::uns64		map_offset;
+	    // If map != NULL, input lines are copied
+	    // from the map_size bytes of a file mapped
+	    // by init_input_mapped_file, of which the
+	    // first map_offset have been copied.
+	min::uns64		buffer_base;
+	    // 64 bit offset within all the input of
+	    // buffer[0]; see min::line64.
 	std::ostream * 		ostream;
 	const min::printer	printer;
 	const min::file		ofile;
@@ -6491,6 +7179,26 @@ namespace min {
 	          = NULL,
 	      min::uns32 spool_lines = min::ALL_LINES );
 
+    // Like init_input_named_file but instead of copying
+    // the whole file into the buffer when called, the
+    // file is mapped into memory and lines are copied
+    // into the buffer one at a time by next_line.
+    // Files of 4 gigabytes or more can be read if
+    // spool_lines is not ALL_LINES and flush_spool is
+    // called so the buffer does not overflow.  The
+    // file offset of each spooled line is buffer_base
+    // plus its buffer offset (see min::line64).  The
+    // map is released when all of it has been read,
+    // when the file is re-initialized, or when the file
+    // is garbage collected.
+    //
+    bool init_input_mapped_file
+	    ( min::ref<min::file> file,
+	      min::gen file_name,
+	      const min::line_format * line_format
+	          = NULL,
+	      min::uns32 spool_lines = min::ALL_LINES );
+
     void init_input_string
 	    ( min::ref<min::file> file,
 	      min::ptr<const char> string,
@@ -6578,6 +7286,17 @@ namespace min {
 	    ( min::file file,
 	      min::uns32 line_number );
 
+    // Ditto but return the 64 bit offset of the line
+    // within all the file input, rather than within
+    // the buffer, or NO_LINE64.  This offset is not
+    // changed by flush_spool.  For an input file the
+    // offset is the offset of the line in the file.
+    //
+    const min::uns64 NO_LINE64 = ~ 0ull;
+    min::uns64 line64
+	    ( min::file file,
+	      min::uns32 line_number );
+
     inline min::uns32 remaining_length
 	    ( min::file file )
     {
@@ -6857,6 +7576,53 @@ namespace min {
     const unsigned OBJ_CONTEXT = ( 1 << 0 );
     const unsigned OBJ_GTYPE   = ( 1 << 1 );
 
+    // OBJ_FROZEN means object is public and its hash
+    // table was built by min::freeze as a perfect hash
+    // table: no two hash table attribute names are in
+    // the same hash-list, so locating a hash table
+    // attribute compares at most one name.
+    //
+    // The hash area of a frozen object, whose size H is
+    // kept in the object header, holds frozen_hash_
+    // size ( H ) hash-lists followed by a table of
+    // seeds, one per bucket.  A name whose hash is h is
+    // in bucket h % (number of seeds) and in the hash-
+    // list with index seeded_hash ( h, seed ) % hash_
+    // size_of ( vp ), where seed is the bucket's seed.
+    // min::hash_size_of returns the number of hash-
+    // lists, so functions that walk hash-lists do not
+    // see the seeds.
+    //
+    const unsigned OBJ_FROZEN  = ( 1 << 2 );
+
+    namespace internal {
+
+	inline min::unsptr frozen_hash_size
+		( min::unsptr H )
+	{
+	    return H - ( H + 4 ) / 5;
+	}
+
+	inline min::uns32 seeded_hash
+		( min::uns32 hash, min::uns32 seed )
+	{
+	    min::uns32 h = hash + seed * 0x9E3779B9;
+	    h ^= h >> 16;
+	    h *= 0x85EBCA6B;
+	    h ^= h >> 13;
+	    return h;
+	}
+    }
+
+    // OBJ_GROW_HASH means that when creating an attri-
+    // bute makes its hash-list hold more than min::
+    // max_hash_chain names and the hash table has
+    // fewer entries than the object has names, the
+    // object is reorganized to a hash table twice the
+    // number of names.
+    //
+    const unsigned OBJ_GROW_HASH = ( 1 << 3 );
+
 #   if MIN_IS_COMPACT
 
 	inline bool is_attr_legal ( min::gen g )
@@ -6895,7 +7661,8 @@ namespace min { namespace internal {
     //
     //    0		OBJ_CONTEXT
     //    1		OBJ_GTYPE
-    //	  2..3		reserved for more flags
+    //    2		OBJ_FROZEN
+    //	  3		OBJ_GROW_HASH
     //	  4..N-1	unused offset - 1
     //
     //  Aux Offset Bits:
@@ -7142,12 +7909,18 @@ namespace min {
 	( min::obj_vec_ptr & vp );
     bool context_flag_of
 	( min::obj_vec_ptr & vp );
+    bool frozen_flag_of
+	( min::obj_vec_ptr & vp );
+    bool grow_hash_flag_of
+	( min::obj_vec_ptr & vp );
     void set_public_flag_of
 	( min::obj_vec_insptr & vp );
     void set_gtype_flag_of
 	( min::obj_vec_insptr & vp );
     void set_context_flag_of
 	( min::obj_vec_insptr & vp );
+    void set_grow_hash_flag_of
+	( min::obj_vec_insptr & vp );
 
     min::unsptr hash_count_of
 	( min::obj_vec_ptr & vp );
@@ -7170,22 +7943,45 @@ namespace min {
 	  min::unsptr var_size,
 	  min::unsptr unused_size,
 	  bool expand = true );
+    namespace internal {
+	void reorganize
+	    ( min::obj_vec_insptr & vp,
+	      min::unsptr hash_size,
+	      min::unsptr var_size,
+	      min::unsptr unused_size,
+	      bool expand,
+	      const min::uns32 * seeds,
+	      min::unsptr seeds_size );
+    }
     void compact
 	( min::obj_vec_insptr & vp,
 	  min::unsptr var_size,
 	  min::unsptr unused_size,
 	  bool expand = true );
+    void freeze
+	( min::obj_vec_insptr & vp,
+	  min::unsptr max_hash_factor = 8 );
+    namespace internal {
+	min::uns32 list_hash
+	    ( min::obj_vec_ptr & vp, min::uns32 hash );
+    }
 
     ref<min::gen> attr_push
 	( min::obj_vec_insptr & vp );
     void attr_push
 	( min::obj_vec_insptr & vp,
 	  min::unsptr n, const min::gen * p );
+    void attr_push
+	( min::obj_vec_insptr & vp,
+	  min::unsptr n, min::ptr<const min::gen> p );
     ref<min::gen> aux_push
 	( min::obj_vec_insptr & vp );
     void aux_push
 	( min::obj_vec_insptr & vp,
 	  min::unsptr n, const min::gen * p );
+    void aux_push
+	( min::obj_vec_insptr & vp,
+	  min::unsptr n, min::ptr<const min::gen> p );
 
     min::gen attr_pop
 	( min::obj_vec_insptr & vp );
@@ -7362,12 +8158,20 @@ namespace min {
 	    ( min::obj_vec_ptr & vp );
 	friend bool context_flag_of
 	    ( min::obj_vec_ptr & vp );
+	friend bool frozen_flag_of
+	    ( min::obj_vec_ptr & vp );
+	friend min::uns32 internal::list_hash
+	    ( min::obj_vec_ptr & vp, min::uns32 hash );
+	friend bool grow_hash_flag_of
+	    ( min::obj_vec_ptr & vp );
 	friend void set_public_flag_of
 	    ( min::obj_vec_insptr & vp );
 	friend void set_gtype_flag_of
 	    ( min::obj_vec_insptr & vp );
 	friend void set_context_flag_of
 	    ( min::obj_vec_insptr & vp );
+	friend void set_grow_hash_flag_of
+	    ( min::obj_vec_insptr & vp );
 
 	friend void resize
 	    ( min::obj_vec_insptr & vp,
@@ -7386,17 +8190,36 @@ namespace min {
 	      min::unsptr var_size,
 	      min::unsptr unused_size,
 	      bool expand );
+	friend void internal::reorganize
+	    ( min::obj_vec_insptr & vp,
+	      min::unsptr hash_size,
+	      min::unsptr var_size,
+	      min::unsptr unused_size,
+	      bool expand,
+	      const min::uns32 * seeds,
+	      min::unsptr seeds_size );
+	friend void freeze
+	    ( min::obj_vec_insptr & vp,
+	      min::unsptr max_hash_factor );
 
 	friend ref<min::gen> attr_push
 	    ( min::obj_vec_insptr & vp );
 	friend void attr_push
 	    ( min::obj_vec_insptr & vp,
 	      min::unsptr n, const min::gen * p );
+	friend void attr_push
+	    ( min::obj_vec_insptr & vp,
+	      min::unsptr n,
+	      min::ptr<const min::gen> p );
 	friend ref<min::gen> aux_push
 	    ( min::obj_vec_insptr & vp );
 	friend void aux_push
 	    ( min::obj_vec_insptr & vp,
 	      min::unsptr n, const min::gen * p );
+	friend void aux_push
+	    ( min::obj_vec_insptr & vp,
+	      min::unsptr n,
+	      min::ptr<const min::gen> p );
 
 	friend min::gen attr_pop
 	    ( min::obj_vec_insptr & vp );
@@ -7600,6 +8423,9 @@ namespace min {
 	    }
 
 	    attr_offset = hash_offset + hash_size;
+	    if ( unused_offset_flags & OBJ_FROZEN )
+		hash_size = internal::frozen_hash_size
+		                ( hash_size );
 
 	    if ( this->type == GC ) return;
 
@@ -7947,6 +8773,16 @@ namespace min {
     {
         return vp.unused_offset_flags & OBJ_CONTEXT;
     }
+    inline bool frozen_flag_of
+	( min::obj_vec_ptr & vp )
+    {
+        return vp.unused_offset_flags & OBJ_FROZEN;
+    }
+    inline bool grow_hash_flag_of
+	( min::obj_vec_ptr & vp )
+    {
+        return vp.unused_offset_flags & OBJ_GROW_HASH;
+    }
     inline void set_public_flag_of
 	( min::obj_vec_insptr & vp )
     {
@@ -7967,6 +8803,11 @@ namespace min {
 	    OBJ_CONTEXT | OBJ_PUBLIC;
 	vp = NULL_STUB;
     }
+    inline void set_grow_hash_flag_of
+	( min::obj_vec_insptr & vp )
+    {
+        vp.unused_offset_flags |= OBJ_GROW_HASH;
+    }
 
     inline min::unsptr var_size_of
 	( min::obj_vec_ptr & vp )
@@ -7978,6 +8819,33 @@ namespace min {
     {
         return vp.hash_size;
     }
+
+    // Return the hash to pass to start_hash to find the
+    // hash-list of a name whose min::hash is hash.
+    //
+    inline min::uns32 internal::list_hash
+	( min::obj_vec_ptr & vp, min::uns32 hash )
+    {
+	if ( ! ( vp.unused_offset_flags & OBJ_FROZEN )
+	     ||
+	     vp.hash_size == 0 )
+	    return hash;
+
+	min::unsptr seeds =
+	    vp.attr_offset - vp.hash_offset
+	                   - vp.hash_size;
+	min::gen g = unprotected::base(vp)
+	    [  vp.hash_offset + vp.hash_size
+	     + hash % seeds];
+#	if MIN_IS_COMPACT
+	    min::uns32 seed =
+	        unprotected::direct_int_of ( g );
+#	else
+	    min::uns32 seed = (min::uns32)
+	        unprotected::direct_float_of ( g );
+#	endif
+	return seeded_hash ( hash, seed );
+    }
     inline min::unsptr attr_size_of
 	( min::obj_vec_ptr & vp )
     {
@@ -8291,6 +9159,13 @@ namespace min {
 	compact ( vp, var_size_of ( vp ), 0, false );
 	set_public_flag_of ( vp );
     }
+    inline void freeze
+	( min::gen obj,
+	  min::unsptr max_hash_factor = 8 )
+    {
+        min::obj_vec_insptr vp ( obj );
+	freeze ( vp, max_hash_factor );
+    }
 
     inline bool private_flag_of ( min::gen obj )
     {
@@ -8361,6 +9236,33 @@ namespace min {
 	vp.unused_offset += n;
     }
 
+    // Ditto but the n values are in a body, possibly
+    // of vp itself, which may be relocated by expand.
+    //
+    inline void attr_push
+	( min::obj_vec_insptr & vp,
+	  min::unsptr n,
+	  min::ptr<const min::gen> p )
+    {
+	min::unsptr m = unused_size_of ( vp );
+	if ( m < n ) expand ( vp, n );
+
+	min::gen * q =
+	    unprotected::base(vp) + vp.unused_offset;
+	memcpy ( (void *) q, ~ p,
+	         sizeof ( min::gen ) * n );
+	unprotected::acc_write_update ( vp.s, q, n );
+	vp.unused_offset += n;
+    }
+    inline void attr_push
+	( min::obj_vec_insptr & vp,
+	  min::unsptr n,
+	  min::ptr<min::gen> p )
+    {
+	attr_push
+	    ( vp, n, (min::ptr<const min::gen>) p );
+    }
+
     inline ref<min::gen> aux_push
 	( min::obj_vec_insptr & vp )
     {
@@ -8395,6 +9297,30 @@ namespace min {
 	}
     }
 
+    inline void aux_push
+	( min::obj_vec_insptr & vp,
+	  min::unsptr n,
+	  min::ptr<const min::gen> p )
+    {
+	min::unsptr m = unused_size_of ( vp );
+	if ( m < n ) expand ( vp, n );
+
+	vp.aux_offset -= n;
+	min::gen * q =
+	    unprotected::base(vp) + vp.aux_offset;
+	memcpy ( (void *) q, ~ p,
+	         sizeof ( min::gen ) * n );
+	unprotected::acc_write_update ( vp.s, q, n );
+    }
+    inline void aux_push
+	( min::obj_vec_insptr & vp,
+	  min::unsptr n,
+	  min::ptr<min::gen> p )
+    {
+	aux_push
+	    ( vp, n, (min::ptr<const min::gen>) p );
+    }
+
     inline min::gen attr_pop
 	( min::obj_vec_insptr & vp )
     {
@@ -8462,7 +9388,9 @@ namespace min {
 // value NONE(), and can be garbage collected when the
 // object is reorganized.  Because they are often
 // isolated, no attempt is made to put them on a free
-// list.
+// list.  The ACC aux compactor reorganizes objects
+// whose aux areas are mostly such elements (see
+// min::acc::aux_compactor_increment).
 
 namespace min { namespace unprotected {
 
@@ -8505,6 +9433,11 @@ namespace min {
 
     extern bool use_obj_aux_stubs;
 
+    // Hash-list length above which an object with the
+    // OBJ_GROW_HASH flag may have its hash table grown.
+    //
+    extern min::unsptr max_hash_chain;
+
 #   if MIN_IS_COMPACT
 
 	inline bool is_list_legal ( min::gen g )
@@ -10190,6 +11123,41 @@ namespace min {
 		      < vecptr > & ap,
 		  min::unsptr & length, min::gen name );
 #   endif
+
+    // An attribute lookup cache owned by a call site
+    // that locates the same string attribute name in
+    // many objects.  After a successful hash table
+    // locate it remembers the name, its hash, the hash
+    // table size, and the number of name-descriptor
+    // pairs that precede the name in its hash-list.
+    // A later locate of the same name in an object
+    // with the same hash table size goes straight to
+    // that hash-list position, and is a hit if the
+    // name is found there.  Otherwise the full locate
+    // is done and the cache is refilled.
+    //
+    struct attr_cache
+    {
+        min::gen    name;
+	    // NONE() if the cache is empty.
+	min::uns32  hash;
+	min::unsptr hash_size;
+	min::unsptr pairs;
+	min::uns64  hits;
+	min::uns64  misses;
+
+	attr_cache ( void )
+	    : name ( min::NONE() ), hash ( 0 ),
+	      hash_size ( 0 ), pairs ( 0 ),
+	      hits ( 0 ), misses ( 0 ) {}
+    };
+
+    template < class vecptr >
+    void locate
+	    ( unprotected::attr_ptr_type
+	          < vecptr > & ap,
+	      min::gen name,
+	      min::attr_cache & cache );
     template < class vecptr >
     void locate_reverse
 	    ( unprotected::attr_ptr_type
@@ -10241,6 +11209,14 @@ namespace min {
 	    ( min::reverse_attr_info * out,
 	      min::unsptr n );
 
+    // If MIN_PARALLEL_SORT is 1, the number and the
+    // string names of an info vector with at least
+    // parallel_sort_threshold of them are each sorted
+    // by sort_threads threads.
+    //
+    extern min::unsptr parallel_sort_threshold;
+    extern unsigned sort_threads;
+
     template < class vecptr >
     min::gen name_of
 	    ( unprotected::attr_ptr_type
@@ -10349,6 +11325,12 @@ namespace min {
 		      min::gen name );
 #	endif
 	template < class vecptr >
+	void locate
+		( unprotected::attr_ptr_type
+		      < vecptr > & ap,
+		  min::gen name,
+		  min::attr_cache & cache );
+	template < class vecptr >
 	void relocate
 		( unprotected::attr_ptr_type
 		      < vecptr > & ap );
@@ -10421,6 +11403,14 @@ namespace min {
 		( min::attr_insptr & ap,
 		  min::gen v );
 
+	// Called by attr_create after it adds a name to
+	// a hash-list.  If the object OBJ_GROW_HASH flag
+	// is set and the hash table is overfull, reorga-
+	// nize the object with a larger hash table and
+	// relocate ap.
+	//
+	void grow_hash ( min::attr_insptr & ap );
+
 	// Create a reverse attribute that does not
 	// exist and set its value-multiset to v, which
 	// may be EMPTY_SUBLIST().  The state is set to
@@ -10768,6 +11758,11 @@ namespace min { namespace unprotected {
 		      min::unsptr & length,
 		      min::gen name );
 #   endif
+	friend void locate<>
+		( min::unprotected
+		     ::attr_ptr_type<vecptr> & ap,
+		  min::gen name,
+		  min::attr_cache & cache );
 	friend void min::locate_reverse<>
 		( min::unprotected
 		     ::attr_ptr_type<vecptr> & ap,
@@ -10891,6 +11886,11 @@ namespace min { namespace unprotected {
 			     & ap,
 		      min::gen name );
 #	endif
+	friend void min::internal::locate<>
+		( min::unprotected
+		     ::attr_ptr_type<vecptr> & ap,
+		  min::gen name,
+		  min::attr_cache & cache );
 	friend void min::internal::relocate<>
 		( min::unprotected
 		     ::attr_ptr_type<vecptr> & ap );
@@ -10943,6 +11943,8 @@ namespace min { namespace unprotected {
 	friend void min::internal::attr_create
 		( min::attr_insptr & ap,
 		  min::gen v );
+	friend void min::internal::grow_hash
+		( min::attr_insptr & ap );
 	friend void min::internal::reverse_attr_create
 		( min::attr_insptr & ap,
 		  min::gen v );
@@ -11163,6 +12165,57 @@ namespace min {
 	}
 #   endif
 
+    template < class vecptr >
+    inline void locate
+	    ( min::unprotected
+	         ::attr_ptr_type<vecptr> & ap,
+	      min::gen name,
+	      min::attr_cache & cache )
+    {
+	typedef unprotected::attr_ptr_type<vecptr>
+	    ap_type;
+
+	// Only string names are cached.
+	//
+	if ( ! is_str ( name ) )
+	{
+	    locate ( ap, name );
+	    return;
+	}
+
+	if ( cache.name == name
+	     &&
+	        cache.hash_size
+	     == hash_size_of ( ap.locate_dlp ) )
+	{
+	    min::gen c =
+	        start_hash ( ap.locate_dlp, cache.hash );
+	    for ( min::unsptr i = cache.pairs;
+	          i > 0 && ! is_list_end ( c ); -- i )
+	    {
+	        next ( ap.locate_dlp );
+		c = next ( ap.locate_dlp );
+	    }
+	    if ( c == name )
+	    {
+		next ( ap.locate_dlp );
+		start_copy ( ap.dlp, ap.locate_dlp );
+		ap.attr_name = name;
+		ap.reverse_attr_name = NONE();
+		ap.index = cache.hash;
+		ap.flags = 0;
+		ap.state = ap_type::LOCATE_NONE;
+#	        if MIN_ALLOW_PARTIAL_ATTR_LABELS
+		    ap.length = 1;
+#	        endif
+		++ cache.hits;
+		return;
+	    }
+	}
+
+	internal::locate ( ap, name, cache );
+    }
+
     // Information Functions:
  
     template < class vecptr >
@@ -14048,10 +15101,86 @@ namespace min {
 
 namespace min { namespace internal {
 
+    // Set acc_head and aux_head to the heads of the
+    // xxx_acc_hash and xxx_aux_hash lists that hold a
+    // stub with the given hash.  If a resize is in
+    // progress and the stub's index in the old tables
+    // has not yet been rehashed, these are heads of
+    // lists in the old tables.
+    //
+    inline void str_hash_heads
+	    ( min::uns32 hash,
+	      min::stub ** & acc_head,
+	      min::stub ** & aux_head )
+    {
+	min::unsptr h;
+	if ( str_acc_hash_old != NULL
+	     &&
+	        ( h = hash & ( str_hash_old_size - 1 ) )
+	     >= str_hash_rehashed )
+	{
+	    acc_head = str_acc_hash_old + h;
+	    aux_head = str_aux_hash_old + h;
+	}
+	else
+	{
+	    h = hash & str_hash_mask;
+	    acc_head = str_acc_hash + h;
+	    aux_head = str_aux_hash + h;
+	}
+    }
+
+#   if MIN_IS_COMPACT
+	inline void num_hash_heads
+		( min::uns32 hash,
+		  min::stub ** & acc_head,
+		  min::stub ** & aux_head )
+	{
+	    min::unsptr h;
+	    if ( num_acc_hash_old != NULL
+		 &&
+		    ( h =   hash
+		          & ( num_hash_old_size - 1 ) )
+		 >= num_hash_rehashed )
+	    {
+		acc_head = num_acc_hash_old + h;
+		aux_head = num_aux_hash_old + h;
+	    }
+	    else
+	    {
+		h = hash & num_hash_mask;
+		acc_head = num_acc_hash + h;
+		aux_head = num_aux_hash + h;
+	    }
+	}
+#   endif
+
+    inline void lab_hash_heads
+	    ( min::uns32 hash,
+	      min::stub ** & acc_head,
+	      min::stub ** & aux_head )
+    {
+	min::unsptr h;
+	if ( lab_acc_hash_old != NULL
+	     &&
+	        ( h = hash & ( lab_hash_old_size - 1 ) )
+	     >= lab_hash_rehashed )
+	{
+	    acc_head = lab_acc_hash_old + h;
+	    aux_head = lab_aux_hash_old + h;
+	}
+	else
+	{
+	    h = hash & lab_hash_mask;
+	    acc_head = lab_acc_hash + h;
+	    aux_head = lab_aux_hash + h;
+	}
+    }
+
     // Remove a stub s from an aux hash table list.
-    // Here head = xxx_aux_hash + index, where index =
-    // s's hash value & xxx_hash_mask, is the head of
-    // the list.  If stub is not in the list, MIN_ABORT.
+    // Here head is the aux_head returned by xxx_hash_
+    // heads for s's hash value, and is the head of the
+    // list.  If stub is not in the list, MIN_ABORT.
     //
     inline void remove_aux_hash
 	    ( min::stub ** head, min::stub * s )
@@ -14099,33 +15228,45 @@ namespace min { namespace internal {
     {
 
 	int t = unprotected::type_of_control ( c );
-	min::stub ** aux_head = NULL;
-	min::uns32 h;
+	min::stub ** acc_head;
+	min::stub ** aux_head;
+	min::uns32 hash;
 	switch ( t )
 	{
 #       if MIN_IS_COMPACT
 	    case min::NUMBER:
-		h = min::floathash
-			( unprotected::float_of ( s ) );
-		h &= num_hash_mask;
-		aux_head = num_aux_hash + h;
+		hash = min::floathash
+			  ( unprotected::float_of ( s ) );
+		num_hash_heads
+		    ( hash, acc_head, aux_head );
+		-- num_hash_count;
+#		if MIN_FLAT_HASH_INDEX
+		    hash_index_remove
+		        ( num_hash_index, hash, s );
+#		endif
 		break;
 #       endif
 	case min::SHORT_STR:
-	    h = min::strnhash ( s->v.c8, 8 );
-	    h &= str_hash_mask;
-	    aux_head = str_aux_hash + h;
-	    break;
 	case min::LONG_STR:
-	    h = unprotected::hash_of
-	            ( unprotected::long_str_of ( s ) );
-	    h &= str_hash_mask;
-	    aux_head = str_aux_hash + h;
+	    hash = t == min::SHORT_STR ?
+	           min::strnhash ( s->v.c8, 8 ) :
+	           unprotected::hash_of
+		      ( unprotected::long_str_of ( s ) );
+	    str_hash_heads ( hash, acc_head, aux_head );
+	    -- str_hash_count;
+#	    if MIN_FLAT_HASH_INDEX
+		hash_index_remove
+		    ( str_hash_index, hash, s );
+#	    endif
 	    break;
 	case min::LABEL:
-	    h = min::labhash ( s );
-	    h &= lab_hash_mask;
-	    aux_head = lab_aux_hash + h;
+	    hash = min::labhash ( s );
+	    lab_hash_heads ( hash, acc_head, aux_head );
+	    -- lab_hash_count;
+#	    if MIN_FLAT_HASH_INDEX
+		hash_index_remove
+		    ( lab_hash_index, hash, s );
+#	    endif
 	    break;
 	default:
 	    return false;
@@ -14140,49 +15281,44 @@ namespace min { namespace internal {
     // table it is in to the corresponding acc hash
     // table, and remove it from the acc list.  Last_s
     // is the stub previous to s on the acc stub list,
-    // and last_c is the control of last_s.  True is
-    // returned if the stub is moved and false is
-    // returned if the stub type indicates it is not
-    // in the hash tables.
+    // and last_c is the control of last_s, which is
+    // updated when s is removed.  True is returned if
+    // the stub is moved and false is returned if the
+    // stub type indicates it is not in the hash
+    // tables.
     //
     inline bool move_to_acc_hash_table
 	    ( min::uns64 c, min::stub * s,
-	      min::uns64 last_c, min::stub * last_s )
+	      min::uns64 & last_c, min::stub * last_s )
     {
 
 	int t = unprotected::type_of_control ( c );
-	min::stub ** aux_head = NULL;
-	min::stub ** acc_head = NULL;
-	min::uns32 h;
+	min::stub ** aux_head;
+	min::stub ** acc_head;
 	switch ( t )
 	{
 #       if MIN_IS_COMPACT
 	    case min::NUMBER:
-		h = min::floathash
-			( unprotected::float_of ( s ) );
-		h &= num_hash_mask;
-		aux_head = num_aux_hash + h;
-		acc_head = num_acc_hash + h;
+		num_hash_heads
+		    ( min::floathash
+			  ( unprotected::float_of ( s ) ),
+		      acc_head, aux_head );
 		break;
 #       endif
 	case min::SHORT_STR:
-	    h = min::strnhash ( s->v.c8, 8 );
-	    h &= str_hash_mask;
-	    aux_head = str_aux_hash + h;
-	    acc_head = str_acc_hash + h;
+	    str_hash_heads
+	        ( min::strnhash ( s->v.c8, 8 ),
+		  acc_head, aux_head );
 	    break;
 	case min::LONG_STR:
-	    h = unprotected::hash_of
-	            ( unprotected::long_str_of ( s ) );
-	    h &= str_hash_mask;
-	    aux_head = str_aux_hash + h;
-	    acc_head = str_acc_hash + h;
+	    str_hash_heads
+	        ( unprotected::hash_of
+		      ( unprotected::long_str_of ( s ) ),
+		  acc_head, aux_head );
 	    break;
 	case min::LABEL:
-	    h = min::labhash ( s );
-	    h &= lab_hash_mask;
-	    aux_head = lab_aux_hash + h;
-	    acc_head = lab_acc_hash + h;
+	    lab_hash_heads
+	        ( min::labhash ( s ), acc_head, aux_head );
 	    break;
 	default:
 	    return false;
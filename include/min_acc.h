@@ -115,6 +115,11 @@ namespace min { namespace acc {
         // The number of extra new stubs allocated by a
 	// call to MINT::acc_expand_free_stub_list.
 
+    extern min::unsptr stub_buffer_size;
+        // The value of the stub_buffer_size parameter.
+	// The number of stubs taken at one time for
+	// a mutator thread stub buffer.
+
     extern min::stub * stub_begin;
     extern min::stub * stub_next;
     extern min::stub * stub_end;
@@ -123,12 +128,29 @@ namespace min { namespace acc {
 	// The end is the address just after the
 	// region: stub_end = stub_begin + max_stubs.
 
-    // Deficiency: If MIN_PTR_SIZE <= 32 stub memory
-    // should be allocated as needed and not all at
-    // once.  Possibly this should also be done for
-    // larger pointer sizes, as reserving virtual memory
-    // may consume system resources proportional to the
-    // size of the reserved memory.
+    extern min::unsptr stub_commit_pages;
+        // The value of the stub_commit_pages param-
+	// eter.  If 0, the whole stub region is made
+	// accessible when the program starts.  Other-
+	// wise the stub region is reserved but made
+	// inaccessible, and MINT::acc_expand_free_
+	// stub_list makes it accessible this many
+	// pages at a time as stub_next advances, so
+	// memory is not committed for stubs that are
+	// never used.  Value may only be changed when
+	// the program starts.
+
+    extern min::stub * stub_commit_end;
+        // End of the accessible part of the stub
+	// region.  Stub_next <= stub_commit_end.
+
+    // When a compaction finishes, if all the stubs
+    // at the end of the stub region, from some page
+    // boundary up to stub_next, are on the free list,
+    // these stubs are removed from the free list,
+    // stub_next is moved back to the page boundary,
+    // and the pages freed are purged, or made
+    // inaccessible if stub_commit_pages != 0.
 
 } }
 
@@ -168,6 +190,20 @@ namespace min { namespace acc {
     //
     extern min::unsptr page_size;
 
+    // The value of the huge_pages parameter.  If 1,
+    // MOS::use_huge_pages is set.  Set to 0 when the
+    // program starts if the OS does not support huge
+    // pages.
+    //
+    extern min::uns32 huge_pages;
+
+    // Bodies of at least this many hardware pages are
+    // moved by MUP::move_body_contents by remapping
+    // their pages instead of by copying.  0 if bodies
+    // are always copied.
+    //
+    extern min::unsptr remap_pages;
+
     // Sizes of various kinds of region and size limits
     // on their contents, in bytes.  See description of
     // regions below, and see min_acc_parameters.h for
@@ -832,8 +868,23 @@ namespace min { namespace internal {
 	    // blocks, and if none is found, a new
 	    // fixed block region is allocated to be
 	    // the new current region.
+	    //
+	    // The runs of fbl (see MINT::fixed_block_
+	    // run) are carved from the end of the used
+	    // part of current_region.
     };
 
+} }
+
+namespace min { namespace acc {
+
+    // Return the never used blocks of the fixed block
+    // runs of all mutator threads to their regions.
+    // Called at the end of each collection, so collec-
+    // tions see no region partly held by a run.
+    //
+    void return_fixed_block_runs ( void );
+
 } }
 
 // Stub Stacks
@@ -1052,6 +1103,22 @@ namespace min { namespace acc {
 	    }
 	}
 
+	// Return the element n elements after the input
+	// pointer if it is in the input segment, or NULL
+	// otherwise.  Used to prefetch elements that are
+	// about to become current().
+	//
+	min::stub * lookahead ( min::unsptr n )
+	{
+	    if ( is_at_end
+	         ||
+		    (min::unsptr)
+		    ( input_segment->next - input )
+		 <= n )
+	        return NULL;
+	    return input[n];
+	}
+
 	void remove_jump ( void );
 	void remove ( void )
 	{
@@ -1643,6 +1710,13 @@ namespace min { namespace acc {
 	    // in these tables list has its unmarked
 	    // flag set and its scavenged flag cleared.
 	    // Then the generation lock is released.
+	    //
+	    // If a hash table resize is in progress,
+	    // both the new and old acc hash tables are
+	    // scanned.  Resize increments also require
+	    // that this generation be unlocked, so the
+	    // tables do not change while they are
+	    // being scanned.
 
 	START_INITING_ROOT,
 	LOCK_INITING_ROOT,
@@ -1842,7 +1916,9 @@ namespace min { namespace acc {
 	COLLECTING_HASH,
 	    // Scan through the XXX_acc_hash tables and
 	    // free all stubs with level L == 0 unmarked
-	    // flag set.
+	    // flag set.  As for INITING_HASH, both new
+	    // and old tables of a resize in progress
+	    // are scanned.
 	    //
 	    // Only runs if L == 0.  Locks the first
 	    // generation of level 1 when running, as it
@@ -1918,6 +1994,12 @@ namespace min { namespace acc {
 	    // RUNNING.
     };
 
+    // Number of collector phases, and their names
+    // (e.g., "SCAVENGING_ROOT"), for statistics.
+    //
+    const unsigned NUMBER_OF_PHASES = COLLECTOR_STOP + 1;
+    extern const char * phase_name[NUMBER_OF_PHASES];
+
     // The amount of work done in a collector increment
     // is controlled by the following parameters.  Note
     // that collection increments cannot be split among
@@ -1949,11 +2031,31 @@ namespace min { namespace acc {
 	// during a colector increment of the SCAVENGE_
 	// ROOT or SCAVENGE_THREAD phases.
 
+    extern unsigned scavenge_prefetch;
+        // When a stub is taken from a to-be-scavenged
+	// list, the stub this many elements further
+	// along the list, and the body of the stub half
+	// this many elements along, are prefetched, so
+	// their cache misses overlap with scavenging.
+	// 0 turns off prefetching.
+
     extern min::uns64 collection_limit;
         // Maximum number of stubs to be collected
 	// during a collector increment of the COLLEC-
 	// TING or COLLECTING_HASH phases.
 
+    extern min::unsptr hash_max_load;
+        // A string, number, or label hash table is
+	// doubled in size when its number of stubs
+	// exceeds hash_max_load times its size.  If 0,
+	// hash tables are never resized.
+
+    extern min::unsptr rehash_limit;
+        // Maximum number of lists to be moved from old
+	// hash tables to new hash tables during a
+	// collector increment.  See min.h MINT::xxx_
+	// hash_rehashed.
+
     extern min::uns32 collector_period;
         // Length in milliseconds of the collector
 	// time period.  There is an interrupt at
@@ -1966,6 +2068,59 @@ namespace min { namespace acc {
 	// been executed by the end of the period, the
 	// remainder are executed when the period ends.
 
+    extern min::uns32 pause_target;
+        // If not 0, pacing is on, and this is the
+	// target maximum length in microseconds of a
+	// collector increment.  After each increment,
+	// scan_limit, scavenge_limit, and collection_
+	// limit are moved halfway toward the work that
+	// the throughput measured in the increment
+	// could do in pause_target microseconds, within
+	// the bounds of their parameters.  Also MINT::
+	// acc_interrupt, which always empties the acc
+	// stack, starts a collection of the youngest
+	// level when allocation_budget is exhausted,
+	// and runs one increment of the youngest
+	// running collection.  0 if pacing is off.
+
+    extern min::uns64 allocation_budget;
+        // When pacing is on, the number of acc stubs
+	// that may be allocated before a collection of
+	// the youngest level is started.  When the
+	// budget is exhausted new_acc_stub schedules an
+	// interrupt, so the collection starts before acc
+	// stack pressure would otherwise cause one.  The
+	// budget is renewed when the collection starts
+	// or MACC::collect returns.  Changes to this or
+	// pause_target take effect at the next interrupt
+	// or MACC::collect.
+
+    extern min::uns32 marker_threads;
+        // Number of marker threads that, together with
+	// the thread running the collector, scavenge
+	// the level 0 to-be-scavenged stack during
+	// SCAVENGE_ROOT and SCAVENGE_THREAD collector
+	// increments.  The mutator waits while they
+	// run.  0 if the collector thread scavenges
+	// alone.  Always 0 unless MIN_PARALLEL_MARKERS
+	// is 1 (see min_parameters.h).
+
+    extern min::uns64 marker_limit;
+        // Maximum number of stubs to be scavenged by
+	// all marker threads together during a
+	// collector increment.
+
+    extern min::uns32 sweep_thread;
+        // 1 if a sweeper thread scans the generations
+	// locked by the COLLECTING phase for unmarked
+	// stubs while the mutator runs.  The collector
+	// increments then remove at most collection_
+	// limit of the stubs found, and the removed
+	// stubs and their bodies are freed later when
+	// more free stubs are needed.  Always 0 unless
+	// MIN_CONCURRENT_SWEEP is 1 (see min_para-
+	// meters.h).
+
     // Each generation is described by a generation
     // struct.
     //
@@ -2131,6 +2286,11 @@ namespace min { namespace acc {
 	    // Number of stubs promoted from one level
 	    // to the next lower level by PROMOTING
 	    // phases.
+
+	min::uns64 evacuated;
+	    // Number of bodies moved from fixed size
+	    // blocks to variable size block regions
+	    // by level 1 LEVEL_PROMOTING phases.
     };
 
     // Each acc level is described by a level struct.
@@ -2151,6 +2311,22 @@ namespace min { namespace acc {
 	//
 	counters saved_count;
 
+	// Increment statistics.  Increments counts the
+	// collector increments run at this level, and
+	// phase_increments[p] and phase_ns[p] count the
+	// increments that began in phase p and the nano-
+	// seconds they took.  The max_... members are the
+	// largest changes in count.scanned, count.scav-
+	// enged, and count.collected made by one incre-
+	// ment.
+	//
+	min::uns64 increments;
+	min::uns64 phase_increments[NUMBER_OF_PHASES];
+	min::uns64 phase_ns[NUMBER_OF_PHASES];
+	min::uns64 max_scanned;
+	min::uns64 max_scavenged;
+	min::uns64 max_collected;
+
 	// State:
 
         generation * g;
@@ -2270,8 +2446,15 @@ namespace min { namespace acc {
     // move its pointers to to-be-scavenged or root
     // stacks.
     //
-    extern min::stub ** acc_stack_begin;
-    extern min::stub ** acc_stack_end;
+    // If MIN_MUTATOR_THREADS is 1, each mutator thread
+    // has its own acc stack, and the pairs of the other
+    // threads are moved to the stack of the thread
+    // that stops the mutator threads.
+    //
+    extern MIN_THREAD_LOCAL min::stub **
+        acc_stack_begin;
+    extern MIN_THREAD_LOCAL min::stub **
+        acc_stack_end;
 
     // Maximum size in bytes of the acc stack.  Must be
     // a multiple of the page size.
@@ -2285,6 +2468,12 @@ namespace min { namespace acc {
     //
     extern min::unsptr acc_stack_trigger;
 
+    // If not 0, the minimum number of acc stack pairs
+    // with the same source stub s1 that makes process_
+    // acc_stack rescan s1; see process_acc_stack.
+    //
+    extern min::unsptr acc_stack_rescan;
+
     // Flag bit assignments.
     //
     const unsigned M = 56 - MIN_ACC_FLAG_BITS + 2;
@@ -2360,6 +2549,18 @@ namespace min { namespace acc {
     // than or equal to acc_lower.  Return the number
     // of pointer pairs processed.
     //
+    // If acc_stack_rescan != 0 the pairs are first
+    // sorted, duplicate pairs are skipped, and if
+    // there are at least acc_stack_rescan pairs with
+    // the same source stub s1, and s1 is scavenged at
+    // a level L for which these pairs would mark
+    // their targets, then s1 has its level L scav-
+    // enged flag cleared and is put back on the level
+    // L to-be-scavenged list.  This remembers s1 once
+    // for the rest of the level L scavenging, so
+    // further stores into s1 do not push pairs for
+    // level L until s1 is scavenged again.
+    //
     min::unsptr process_acc_stack
         ( min::stub ** acc_lower =
 	      min::acc::acc_stack_begin );
@@ -2408,6 +2609,123 @@ namespace min { namespace acc {
 // Compactor Interface
 // --------- ---------
 
+namespace min { namespace acc {
+
+    // The compactor slides live bodies in paged body
+    // regions toward the beginning of the paged body
+    // region list, overwriting free blocks, so that
+    // the space in free blocks can be reused, and
+    // frees paged body regions that are emptied by
+    // this sliding.  A compaction also returns fixed
+    // and variable size block subregions that contain
+    // no used blocks to the free lists of their super-
+    // regions.
+    //
+    // Compaction is done in increments, each of which
+    // moves or skips at most compactor_limit blocks.
+    // Bodies are moved by moving page table entries
+    // (see MOS::move_pool), and the compactor can
+    // relocate any paged body, so compactor increments
+    // are relocating functions.
+    //
+    // A body whose size is not known (see MUP::body_
+    // size_of) cannot be moved, and the compaction
+    // ends when it finds such a body.
+    //
+    // Each time a collection finishes MINT::acc_inter-
+    // rupt checks compactor_threshold, and it performs
+    // one compactor increment per call while a compac-
+    // tion is in progress.  So an interrupt is a re-
+    // locating function.
+    //
+    extern min::uns64 compactor_limit;
+        // Maximum number of blocks to be moved or
+	// skipped during a compactor increment.
+
+    extern min::uns64 compactor_threshold;
+        // A compactor increment that finds no compac-
+	// tion in progress starts a compaction if the
+	// free blocks in paged body regions make up at
+	// least this percentage of the bytes allocated
+	// in these regions.
+
+    // Compactor statistics.
+    //
+    extern min::uns64 compactor_bytes_moved;
+        // Bytes in blocks moved.
+    extern min::uns64 compactor_regions_freed;
+        // Paged body regions freed.
+    extern min::uns64 compactor_subregions_freed;
+        // Fixed and variable size block subregions
+	// returned to their superregions, here or by
+	// level 1 collections (see counters::
+	// evacuated).
+    extern min::uns64 compactor_stub_pages_freed;
+        // Pages at the end of the stub region freed
+	// (see MACC::stub_commit_end).
+
+    // Perform one compactor increment.  If no compac-
+    // tion is in progress, start one if force is true
+    // or compactor_threshold is met, and return false
+    // if no compaction is started.  Otherwise return
+    // true if the compaction is still in progress at
+    // the end of the increment, and false if it has
+    // finished.
+    //
+    bool compactor_increment ( bool force = false );
+
+    // The aux compactor finds objects whose aux areas
+    // are mostly unused elements, which list removals
+    // leave behind as NONE() values, and reorganizes
+    // them (see min::reorganize) without changing
+    // their hash table, variable vector, or unused
+    // area sizes, which drops the unused elements.
+    // Objects with the OBJ_PRIVATE flag (that have
+    // vector pointers) or the OBJ_PUBLIC flag are
+    // skipped.  Aux compactor increments are reorgan-
+    // izing functions for all other objects.
+    //
+    // Each time a collection finishes a pass over the
+    // stub region is started, and MINT::acc_interrupt
+    // performs one aux compactor increment per call
+    // until the pass reaches the end of the stub
+    // region.  So an interrupt is a reorganizing func-
+    // tion unless aux_compactor_threshold is 0.
+    //
+    extern min::uns64 aux_compactor_limit;
+        // Maximum number of stubs examined during an
+	// aux compactor increment.
+
+    extern min::uns64 aux_compactor_threshold;
+        // An object is reorganized if at least this
+	// percentage of its aux area is unused.  0
+	// turns off the aux compactor.
+
+    // Aux compactor statistics.
+    //
+    extern min::uns64 aux_compactor_objects;
+        // Objects reorganized.
+    extern min::uns64 aux_compactor_elements_freed;
+        // Aux area elements removed from objects.
+
+    // Perform one aux compactor increment, examining
+    // the stubs that follow those examined by the
+    // previous increment.  Return false if the incre-
+    // ment reached the end of the stub region, so the
+    // next increment starts at its beginning, and true
+    // otherwise.
+    //
+    bool aux_compactor_increment ( void );
+
+    // Perform or complete a compaction.  First finish
+    // any aux compactor pass in progress and then make
+    // a full pass.  Then, if no compaction is
+    // in progress, one is started regardless of
+    // compactor_threshold.  Then call compactor_
+    // increment until the compaction is done.
+    //
+    void compact ( void );
+} }
 
 // Statistics
 // ----------
@@ -2419,6 +2737,79 @@ namespace min { namespace acc {
     //
     void print_acc_statistics ( std::ostream & s );
 
+    // Histogram of pause times in nanoseconds.  Buckets
+    // are log-linear: each power of 2 is split into
+    // 2**PAUSE_SUB_BITS equal sub-buckets, so recorded
+    // values are kept to within 1/8'th (12.5%) of
+    // their true value, as in an HDR histogram.
+    //
+    const unsigned PAUSE_SUB_BITS = 3;
+    const unsigned PAUSE_BUCKETS =
+        ( 64 - PAUSE_SUB_BITS + 1 )
+	<< PAUSE_SUB_BITS;
+    struct pause_histogram
+    {
+        min::uns64 count;
+	    // Number of pauses recorded.
+        min::uns64 total;
+	    // Sum of recorded pauses.
+        min::uns64 max;
+	    // Largest recorded pause.
+	min::uns64 buckets[PAUSE_BUCKETS];
+
+	// Return the bucket index of ns, and the
+	// smallest value in bucket i.
+	//
+	static unsigned bucket_of ( min::uns64 ns );
+	static min::uns64 bucket_floor ( unsigned i );
+
+	// Record a pause of ns nanoseconds.
+	//
+	void record ( min::uns64 ns );
+
+	// Return an upper bound for the p'th percentile
+	// pause (0 <= p <= 100), or 0 if nothing has
+	// been recorded.
+	//
+	min::uns64 percentile ( double p ) const;
+    };
+
+    // Pauses of collector_increment and MINT::acc_
+    // interrupt calls.
+    //
+    extern pause_histogram collector_increment_pauses;
+    extern pause_histogram acc_interrupt_pauses;
+
+    // Number of MINT::acc_interrupt calls, and the
+    // largest number of pairs found in the acc stack
+    // by process_acc_stack.
+    //
+    extern min::uns64 acc_interrupts;
+    extern min::unsptr acc_stack_high_water;
+
+    // Number of stubs rescanned and number of dupli-
+    // cate pairs skipped by process_acc_stack.
+    //
+    extern min::uns64 acc_stack_rescans;
+    extern min::uns64 acc_stack_duplicates;
+
+    // Print the per-level collector statistics (count,
+    // increment statistics, and per-phase times), the
+    // acc stack statistics, and the pause histograms
+    // as a JSON object, or as CSV lines of the form
+    //
+    //	    record,name,field,value
+    //
+    // where record is `level', `phase', `acc_stack',
+    // or `pauses', name is the level number, the level
+    // number and phase name separated by `.', or the
+    // histogram name (empty for acc_stack), and field
+    // and value are a member name and its value.  Only
+    // phases with increments are output.
+    //
+    void print_acc_statistics_json ( std::ostream & s );
+    void print_acc_statistics_csv ( std::ostream & s );
+
     // Print generation counts.  The next column in the
     // output stream is given (0 is the first column),
     // and the indent and line width to use is given.
@@ -42,6 +42,7 @@
 //	    augmentations.
 //	v   Trace variable size block allocations.
 //	c   Trace collector phase execution.
+//	C   Trace compaction starts and finishes.
 //
 //              E.g., debug=pv
 
@@ -97,6 +98,30 @@
 #    define MIN_DEFAULT_STUB_INCREMENT 1024
 # endif
 
+// stub_buffer_size
+//
+//   If MIN_MUTATOR_THREADS is 1, the number of stubs
+//   a mutator thread takes from the free list at one
+//   time for its stub buffer (see MINT::stub_buffer
+//   in min.h).  Must be at least 2.
+//
+# ifndef MIN_DEFAULT_STUB_BUFFER_SIZE
+#    define MIN_DEFAULT_STUB_BUFFER_SIZE 64
+# endif
+
+// stub_commit_pages
+//
+//   If 0, the whole stub vector is made accessible
+//   when the program starts.  Otherwise the stub
+//   vector is reserved inaccessible, and pages are
+//   made accessible this many at a time as stubs are
+//   added, so the process does not commit memory for
+//   unused stubs.
+//
+# ifndef MIN_DEFAULT_STUB_COMMIT_PAGES
+#    define MIN_DEFAULT_STUB_COMMIT_PAGES 0
+# endif
+
 // space_factor
 //
 //   Certain memory space inefficiencies are
@@ -144,6 +169,32 @@
 //   MOS::pagesize(), and defaults to this hardware page
 //   size.
 
+// huge_pages
+//
+//   If 1 and the OS supports transparent huge pages,
+//   MOS::use_huge_pages is set so that the stub region,
+//   superregions, paged body regions, and other large
+//   pools are allocated on huge page boundaries and
+//   backed by huge pages (see min_os.h).  This reduces
+//   TLB misses when the collector scans a large heap,
+//   at the cost of memory for partly used huge pages.
+//
+# ifndef MIN_DEFAULT_HUGE_PAGES
+#    define MIN_DEFAULT_HUGE_PAGES 0
+# endif
+
+// remap_pages
+//
+//   When a body of at least this many hardware pages
+//   is moved to a new paged body, as when a packed
+//   vector grows, its whole pages are moved by
+//   remapping them (see MOS::move_pool) instead of by
+//   copying them.  0 if bodies are always copied.
+//
+# ifndef MIN_DEFAULT_REMAP_PAGES
+#    define MIN_DEFAULT_REMAP_PAGES 16
+# endif
+
 // deallocated_body_size
 //
 //   The size of the inaccessible memory block to which
@@ -234,8 +285,31 @@
 #   define MIN_DEFAULT_NUM_HASH_SIZE 65536
 # endif
 //
-// Note: The current implementation does NOT dynamically
-// resize hash tables.
+// The above are initial sizes.  A hash table is doubled
+// in size when the average number of stubs per hash
+// list exceeds hash_max_load, and its stubs are then
+// moved incrementally from the old table to the new
+// table by collector increments.
+//
+// hash_max_load
+//
+//   Maximum average number of stubs per hash table
+//   list before the table is doubled in size.  If 0,
+//   hash tables are never resized.
+//
+# ifndef MIN_DEFAULT_HASH_MAX_LOAD
+#   define MIN_DEFAULT_HASH_MAX_LOAD 4
+# endif
+//
+// rehash_limit
+//
+//   Maximum number of hash table lists that may be
+//   moved from an old hash table to a new hash table
+//   in a collector increment.
+//
+# ifndef MIN_DEFAULT_REHASH_LIMIT
+#   define MIN_DEFAULT_REHASH_LIMIT 64
+# endif
 
 
 
@@ -332,6 +406,16 @@
 #   define MIN_DEFAULT_ACC_SCAVENGE_LIMIT 30
 # endif
 
+// scavenge_prefetch
+//     The distance ahead in a to-be-scavenged list at
+//     which stubs are prefetched before they are
+//     scavenged; their bodies are prefetched at half
+//     this distance.  0 turns off prefetching.
+//
+# ifndef MIN_DEFAULT_ACC_SCAVENGE_PREFETCH
+#   define MIN_DEFAULT_ACC_SCAVENGE_PREFETCH 8
+# endif
+
 // collection_limit
 //     The maximum number of stubs that can be collected
 //     (i.e., deallocated) in a collection increment.
@@ -363,6 +447,18 @@
 #   define MIN_DEFAULT_ACC_STACK_TRIGGER 100
 # endif
 
+// acc_stack_rescan
+//     If not 0, process_acc_stack sorts the acc stack
+//     pairs, skips duplicate pairs, and when it finds
+//     at least this many pairs with the same source
+//     stub, puts the source stub back on the to-be-
+//     scavenged list instead of marking each target
+//     separately.  0 to process pairs one at a time.
+//
+# ifndef MIN_DEFAULT_ACC_STACK_RESCAN
+#   define MIN_DEFAULT_ACC_STACK_RESCAN 16
+# endif
+
 // collector_period
 //     Length in milliseconds of the collector time
 //     period.  There is an interrupt at the end of each
@@ -381,9 +477,95 @@
 #   define MIN_DEFAULT_COLLECTOR_PERIOD_INCREMENTS 1
 # endif
 
+// pause_target
+//     If not 0, the target maximum length in micro-
+//     seconds of a collector increment; scan_limit,
+//     scavenge_limit, and collection_limit are then
+//     adjusted after each increment to meet it, and
+//     collections are started by interrupts.  0 if
+//     these limits are fixed.
+# ifndef MIN_DEFAULT_ACC_PAUSE_TARGET
+#   define MIN_DEFAULT_ACC_PAUSE_TARGET 0
+# endif
+
+// allocation_budget
+//     If pause_target is not 0, the number of acc stubs
+//     that may be allocated before a collection of the
+//     youngest level is started.
+# ifndef MIN_DEFAULT_ACC_ALLOCATION_BUDGET
+#   define MIN_DEFAULT_ACC_ALLOCATION_BUDGET 100000
+# endif
+
+// marker_threads
+//     Number of marker threads that, together with the
+//     thread running the collector, scavenge the level
+//     0 to-be-scavenged stack in parallel.  0 if the
+//     collector thread scavenges alone.  Ignored
+//     unless MIN_PARALLEL_MARKERS is 1 (see min_
+//     parameters.h).
+//
+# ifndef MIN_DEFAULT_MARKER_THREADS
+#   define MIN_DEFAULT_MARKER_THREADS 3
+# endif
+
+// marker_limit
+//     The maximum number of stubs that can be scaven-
+//     ged by all marker threads together in a
+//     collection increment.  Replaces scavenge_limit
+//     when marker threads are used.
+//
+# ifndef MIN_DEFAULT_MARKER_LIMIT
+#   define MIN_DEFAULT_MARKER_LIMIT 10000
+# endif
+
+// sweep_thread
+//     1 if the COLLECTING phase uses the sweeper thread
+//     to find unmarked stubs, 0 if it does not.
+//     Ignored unless MIN_CONCURRENT_SWEEP is 1 (see
+//     min_parameters.h).
+//
+# ifndef MIN_DEFAULT_SWEEP_THREAD
+#   define MIN_DEFAULT_SWEEP_THREAD 1
+# endif
+
 
 // Compactor Parameters
 // --------- ----------
 
+// compactor_limit
+//     Maximum number of blocks to be moved or skipped
+//     during a compactor increment.
+//
+# ifndef MIN_DEFAULT_COMPACTOR_LIMIT
+#   define MIN_DEFAULT_COMPACTOR_LIMIT 100
+# endif
+
+// compactor_threshold
+//     A compactor increment that finds no compaction in
+//     progress starts one if the free blocks in paged
+//     body regions make up at least this percentage of
+//     the bytes allocated in these regions.
+//
+# ifndef MIN_DEFAULT_COMPACTOR_THRESHOLD
+#   define MIN_DEFAULT_COMPACTOR_THRESHOLD 25
+# endif
+
+// aux_compactor_limit
+//     Maximum number of stubs to be examined during
+//     an aux compactor increment.
+//
+# ifndef MIN_DEFAULT_AUX_COMPACTOR_LIMIT
+#   define MIN_DEFAULT_AUX_COMPACTOR_LIMIT 1000
+# endif
+
+// aux_compactor_threshold
+//     An object is reorganized by the aux compactor if
+//     at least this percentage of its aux area is
+//     unused (NONE()) elements.  0 turns the aux com-
+//     pactor off.
+//
+# ifndef MIN_DEFAULT_AUX_COMPACTOR_THRESHOLD
+#   define MIN_DEFAULT_AUX_COMPACTOR_THRESHOLD 50
+# endif
 
 # endif // MIN_ACC_PARAMETERS_H
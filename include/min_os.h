@@ -73,9 +73,23 @@ namespace min { namespace os {
     //
     min::uns64 virtualsize ( void );
 
+    // Return the size of a transparent huge page, or 0
+    // if huge pages are not available.
+    //
+    min::uns64 hugepagesize ( void );
+
     // In the following a segment is a contiguous piece
     // of memory consisting of an integral number of
     // pages starting on a page boundary.
+    //
+    // At the first allocation a single large inacces-
+    // sible segment of `reserve_size' bytes (see MIN_
+    // OS_RESERVE_SIZE in min_parameters.h) is reserved,
+    // and new segments are allocated from it when
+    // possible.  Freed segments inside the reservation
+    // are made inaccessible and returned to it.  Only
+    // allocations that cannot be satisfied from the
+    // reservation read the process memory map.
 
     // Allocate a segment of virtual memory with the
     // given number of pages and return its address.
@@ -190,6 +204,16 @@ namespace min { namespace os {
     //
     extern unsigned trace_pools;
 
+    // If true and hugepagesize() != 0, segments of at
+    // least hugepagesize() bytes are allocated on huge
+    // page boundaries and the OS is advised to back
+    // them with huge pages, and purge_pool purges only
+    // the whole huge pages of a segment.  Set by the
+    // ACC when its huge_pages parameter is set.
+    // Default false.
+    //
+    extern bool use_huge_pages;
+
 } }
 
 // File Management
@@ -209,6 +233,22 @@ namespace min { namespace os {
     		     const char * file_name,
 		     char error_message[512] );
 
+    // Map a file read-only into memory.  Return the
+    // address of its first byte and set file_size to
+    // its size in bytes.  Return NULL on error, with
+    // error description in error_message as for
+    // file_size.  The map of an empty file is a non-
+    // NULL address that must not be dereferenced.
+    //
+    const char * map_file ( min::uns64 & file_size,
+			    const char * file_name,
+			    char error_message[512] );
+
+    // Unmap a file mapped by map_file.
+    //
+    void unmap_file ( const char * map,
+                      min::uns64 file_size );
+
 } }
 
 # endif // MIN_OS_H
@@ -138,6 +138,45 @@ namespace min {
 #   define MIN_USE_OBJ_AUX_STUBS 0
 # endif
 
+// String hash function used by min::strhash, min::
+// strnhash, and min::floathash:
+//
+//   0  Byte at a time: hash = hash * 65599 + c for
+//	each character c.
+//
+//   1  Word at a time: 8 characters are loaded at a
+//	time and mixed into a 64 bit hash, which is
+//	finalized and folded to 32 bits.
+//
+// Either way the hash of a string depends only on the
+// string's characters, and is never 0.
+//
+# ifndef MIN_STRHASH
+#   define MIN_STRHASH 0
+# endif
+
+// 1 to seed the MIN_STRHASH == 1 hash with a per-
+// process random value, so hash collisions cannot be
+// constructed in advance; 0 not to.  Ignored if
+// MIN_STRHASH == 0.  The seed is
+// taken from the MIN_HASH_SEED environment variable,
+// if that is set, so runs can be reproduced.
+//
+# ifndef MIN_STRHASH_SEED
+#   define MIN_STRHASH_SEED 0
+# endif
+
+// 1 to look up strings, numbers, and labels in flat
+// open addressing hash indices (see min.h MINT::hash_
+// index) instead of by following the lists of the
+// xxx_acc_hash and xxx_aux_hash tables; 0 not to.
+// The lists are maintained either way, as the
+// collector uses them.
+//
+# ifndef MIN_FLAT_HASH_INDEX
+#   define MIN_FLAT_HASH_INDEX 0
+# endif
+
 // ACC Parameters
 
 // Maximum number of ephemeral levels possible with the
@@ -150,6 +189,51 @@ namespace min {
 	( MIN_PTR_BITS <= 32 ? 4 : 2 )
 # endif
 
+// 1 to compile marker threads that scavenge the level
+// 0 to-be-scavenged stack in parallel (see min_acc.h
+// MACC::marker_threads); 0 not to.  Programs compiled
+// with 1 must be linked with -pthread.
+//
+# ifndef MIN_PARALLEL_MARKERS
+#   define MIN_PARALLEL_MARKERS 0
+# endif
+
+// Maximum number of marker threads possible with the
+// compiled code.
+//
+# ifndef MIN_MAX_MARKER_THREADS
+#   define MIN_MAX_MARKER_THREADS 16
+# endif
+
+// 1 to compile a sweeper thread that scans the acc list
+// for unmarked stubs while the mutator runs (see min_
+// acc.h MACC::sweep_thread); 0 not to.  Programs com-
+// piled with 1 must be linked with -pthread.
+//
+# ifndef MIN_CONCURRENT_SWEEP
+#   define MIN_CONCURRENT_SWEEP 0
+# endif
+
+// 1 to compile min::sort_attr_info and min::sort_
+// reverse_attr_info so they sort very large vectors
+// with several threads (see min.h min::parallel_sort_
+// threshold); 0 not to.  Programs compiled with 1 must
+// be linked with -pthread.
+//
+# ifndef MIN_PARALLEL_SORT
+#   define MIN_PARALLEL_SORT 0
+# endif
+
+// 1 to compile mutator contexts that let several
+// threads use MIN at once, each with its own acc stack
+// and stub buffer, stopping for collector increments
+// (see min.h min::mutator_thread); 0 not to.  Programs
+// compiled with 1 must be linked with -pthread.
+//
+# ifndef MIN_MUTATOR_THREADS
+#   define MIN_MUTATOR_THREADS 0
+# endif
+
 // Maximum number of stubs possible with the compiled
 // code.  The defaults specified here permit stub
 // addresses to be stored in min::gen values and in
@@ -196,6 +280,20 @@ namespace min {
 # ifndef MIN_CONTEXT_SIZE_LIMIT
 #   define MIN_CONTEXT_SIZE_LIMIT 4096
 # endif
+
+// Default size in bytes of the inaccessible address
+// space reserved by min::os at its first pool alloca-
+// tion, from which later pools are allocated without
+// reading the process memory map (see min_os.h).  May
+// be changed by the `reserve_size' program parameter.
+// 0 disables the reservation.  The default is 0 for 32
+// bit computers, which have little address space to
+// spare.
+//
+# ifndef MIN_OS_RESERVE_SIZE
+#   define MIN_OS_RESERVE_SIZE \
+	( MIN_PTR_BITS <= 32 ? 0 : ( 1ull << 36 ) )
+# endif
 
 // Rarely Set Software Parameters
 // ------ --- -------- ----------
@@ -41,8 +41,16 @@
 # include <cstdio>
 # include <cstring>
 # include <cmath>
+# include <ctime>
 # include <cerrno>
 # include <cctype>
+# include <algorithm>
+# if defined ( __SSE2__ ) && MIN_USE_GNUC_BUILTINS
+#   include <immintrin.h>
+# endif
+# if MIN_MUTATOR_THREADS || MIN_PARALLEL_SORT
+#   include <pthread.h>
+# endif
 # define MUP min::unprotected
 # define MINT min::internal
 # define UNI min::unicode
@@ -70,9 +78,9 @@ static void exit_called ( void )
 min::initializer * MINT::last_initializer = NULL;
 bool MINT::initialization_done = false;
 
-min::locatable_stub_ptr *
+MIN_THREAD_LOCAL min::locatable_stub_ptr *
     MINT::locatable_stub_ptr_last = NULL;
-min::locatable_gen *
+MIN_THREAD_LOCAL min::locatable_gen *
     MINT::locatable_gen_last = NULL;
 
 static const char * html_reserved_table[256];
@@ -381,6 +389,26 @@ void MINT::initialize ( void )
 
     std::atexit ( ::exit_called );
 
+#   if MIN_MUTATOR_THREADS
+	MINT::lock_mutator();
+#   endif
+
+#   if MIN_STRHASH == 1 && MIN_STRHASH_SEED
+	// Must be set before any string is hashed.
+	// The address of seed varies from run to run
+	// with address space layout randomization.
+	//
+	const char * seed = getenv ( "MIN_HASH_SEED" );
+	if ( seed != NULL )
+	    MINT::strhash_seed =
+	        strtoull ( seed, NULL, 0 );
+	else
+	    MINT::strhash_seed =
+	          (min::uns64) time ( NULL )
+	        ^ ( (min::uns64) clock() << 32 )
+		^ (min::uns64) (min::unsptr) & seed;
+#   endif
+
     PTR_CHECK ( min::packed_struct_ptr<int> );
     PTR_CHECK ( min::packed_struct_updptr<int> );
     PTR_CHECK ( min::packed_vec_ptr<int,int> );
@@ -793,6 +821,190 @@ min::gen min::new_name_gen ( const char * s )
 
 bool MINT::thread_interrupt_needed = false;
 void MINT::thread_interrupt ( void ) {}  // TBD
+
+# if MIN_MUTATOR_THREADS
+
+// The context of the thread that calls min::initialize
+// is made by static initialization, which runs in that
+// thread.  Its acc stack is set by the acc initializer.
+//
+static MINT::mutator_context initial_context =
+{
+    & MINT::locatable_stub_ptr_last,
+    & MINT::locatable_gen_last,
+    & MINT::acc_stack,
+    & MINT::acc_stack_limit,
+    NULL, NULL,
+    & MINT::acc_stub_buffer,
+    MINT::fixed_block_runs,
+    NULL, NULL
+};
+MINT::mutator_context * MINT::mutator_contexts =
+    & initial_context;
+
+static pthread_mutex_t mutator_mutex =
+    PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t mutator_stopped =
+    PTHREAD_COND_INITIALIZER;
+    // Signalled when a mutator thread stops running.
+static pthread_cond_t mutators_started =
+    PTHREAD_COND_INITIALIZER;
+    // Broadcast when the mutator threads restart.
+
+// The following are protected by mutator_mutex.
+//
+static unsigned mutators_running = 0;
+    // Number of mutator threads that are running, i.e.,
+    // have called lock_mutator and are not stopped or
+    // in a mutator_unlock.
+static bool mutators_stopping = false;
+    // True while some thread is stopping or has
+    // stopped the mutator threads.
+
+// Number of stop_mutators calls by this thread not yet
+// matched by start_mutators calls.
+//
+static __thread unsigned stop_depth = 0;
+
+void MINT::lock_mutator ( void )
+{
+    pthread_mutex_lock ( & mutator_mutex );
+    while ( mutators_stopping )
+        pthread_cond_wait
+	    ( & mutators_started, & mutator_mutex );
+    ++ mutators_running;
+    pthread_mutex_unlock ( & mutator_mutex );
+}
+
+void MINT::unlock_mutator ( void )
+{
+    pthread_mutex_lock ( & mutator_mutex );
+    -- mutators_running;
+    pthread_cond_signal ( & mutator_stopped );
+    pthread_mutex_unlock ( & mutator_mutex );
+}
+
+bool MINT::stop_mutators ( void )
+{
+    if ( stop_depth > 0 )
+    {
+        ++ stop_depth;
+	return true;
+    }
+
+    pthread_mutex_lock ( & mutator_mutex );
+    if ( mutators_stopping )
+    {
+	-- mutators_running;
+	pthread_cond_signal ( & mutator_stopped );
+	while ( mutators_stopping )
+	    pthread_cond_wait
+		( & mutators_started, & mutator_mutex );
+	++ mutators_running;
+	pthread_mutex_unlock ( & mutator_mutex );
+	return false;
+    }
+
+    // Make the other threads interrupt at their next
+    // interrupt check.  The acc resets their acc_
+    // stack_limits.
+    //
+    mutators_stopping = true;
+    for ( MINT::mutator_context * c =
+              MINT::mutator_contexts;
+	  c != NULL; c = c->next )
+    {
+        if ( c->acc_stack_limit
+	     != & MINT::acc_stack_limit )
+	    * c->acc_stack_limit = NULL;
+    }
+    while ( mutators_running > 1 )
+        pthread_cond_wait
+	    ( & mutator_stopped, & mutator_mutex );
+    pthread_mutex_unlock ( & mutator_mutex );
+
+    stop_depth = 1;
+    MINT::acc_stop_mutators();
+    return true;
+}
+
+void MINT::start_mutators ( void )
+{
+    MIN_REQUIRE ( stop_depth > 0 );
+    if ( -- stop_depth > 0 ) return;
+
+    MINT::acc_start_mutators();
+
+    pthread_mutex_lock ( & mutator_mutex );
+    mutators_stopping = false;
+    pthread_cond_broadcast ( & mutators_started );
+    pthread_mutex_unlock ( & mutator_mutex );
+}
+
+// The allocator lock.  allocator_depth counts the
+// allocator_locks of this thread.
+//
+static pthread_mutex_t allocator_mutex =
+    PTHREAD_MUTEX_INITIALIZER;
+static __thread unsigned allocator_depth = 0;
+
+void MINT::lock_allocator ( void )
+{
+    if ( allocator_depth ++ == 0 )
+	pthread_mutex_lock ( & allocator_mutex );
+}
+
+void MINT::unlock_allocator ( void )
+{
+    if ( -- allocator_depth == 0 )
+	pthread_mutex_unlock ( & allocator_mutex );
+}
+
+min::mutator_thread::mutator_thread ( void )
+{
+    context.locatable_stub_ptr_last =
+        & MINT::locatable_stub_ptr_last;
+    context.locatable_gen_last =
+        & MINT::locatable_gen_last;
+    context.acc_stack = & MINT::acc_stack;
+    context.acc_stack_limit = & MINT::acc_stack_limit;
+    context.acc_stub_buffer = & MINT::acc_stub_buffer;
+    context.fixed_block_runs = MINT::fixed_block_runs;
+
+    MINT::lock_mutator();
+    while ( ! MINT::stop_mutators() );
+    MINT::acc_initialize_thread ( & context );
+
+    // Insert after initial_context.
+    //
+    context.previous = & initial_context;
+    context.next = initial_context.next;
+    if ( context.next != NULL )
+        context.next->previous = & context;
+    initial_context.next = & context;
+
+    MINT::start_mutators();
+}
+
+min::mutator_thread::~mutator_thread ( void )
+{
+    MIN_REQUIRE
+	(    MINT::exit_called
+	  || (    MINT::locatable_stub_ptr_last == NULL
+	       && MINT::locatable_gen_last == NULL ) );
+
+    while ( ! MINT::stop_mutators() );
+    MINT::acc_finalize_thread ( & context );
+
+    context.previous->next = context.next;
+    if ( context.next != NULL )
+        context.next->previous = context.previous;
+
+    MINT::start_mutators();
+    MINT::unlock_mutator();
+}
+
+# endif // MIN_MUTATOR_THREADS
 
 // Allocator/Collector/Compactor 
 // -----------------------------
@@ -818,18 +1030,191 @@ min::stub ** MINT::str_acc_hash;
 min::stub ** MINT::str_aux_hash;
 min::unsptr  MINT::str_hash_size;
 min::unsptr  MINT::str_hash_mask;
+min::unsptr  MINT::str_hash_count = 0;
+min::stub ** MINT::str_acc_hash_old = NULL;
+min::stub ** MINT::str_aux_hash_old = NULL;
+min::unsptr  MINT::str_hash_old_size = 0;
+min::unsptr  MINT::str_hash_rehashed = 0;
 
 # if MIN_IS_COMPACT
     min::stub ** MINT::num_acc_hash;
     min::stub ** MINT::num_aux_hash;
     min::unsptr  MINT::num_hash_size;
     min::unsptr  MINT::num_hash_mask;
+    min::unsptr  MINT::num_hash_count = 0;
+    min::stub ** MINT::num_acc_hash_old = NULL;
+    min::stub ** MINT::num_aux_hash_old = NULL;
+    min::unsptr  MINT::num_hash_old_size = 0;
+    min::unsptr  MINT::num_hash_rehashed = 0;
 # endif
 
 min::stub ** MINT::lab_acc_hash;
 min::stub ** MINT::lab_aux_hash;
 min::unsptr  MINT::lab_hash_size;
 min::unsptr  MINT::lab_hash_mask;
+min::unsptr  MINT::lab_hash_count = 0;
+min::stub ** MINT::lab_acc_hash_old = NULL;
+min::stub ** MINT::lab_aux_hash_old = NULL;
+min::unsptr  MINT::lab_hash_old_size = 0;
+min::unsptr  MINT::lab_hash_rehashed = 0;
+
+# if MIN_FLAT_HASH_INDEX
+
+    MINT::hash_index MINT::str_hash_index =
+        { NULL, NULL, 0, 0, 0 };
+#   if MIN_IS_COMPACT
+	MINT::hash_index MINT::num_hash_index =
+	    { NULL, NULL, 0, 0, 0 };
+#   endif
+    MINT::hash_index MINT::lab_hash_index =
+        { NULL, NULL, 0, 0, 0 };
+
+    // Initial number of buckets of a hash index.
+    //
+    const min::unsptr HASH_INDEX_INITIAL_BUCKETS = 512;
+
+    // Allocate buckets for an index with the given
+    // number of buckets (a power of 2), all of whose
+    // entries are empty.
+    //
+    static void hash_index_allocate
+	    ( MINT::hash_index & index,
+	      min::unsptr buckets )
+    {
+	index.memory = new min::uns64[8 * buckets + 8];
+	index.buckets = (min::uns64 *)
+	    ( ( (min::unsptr) index.memory + 63 )
+	      & ~ (min::unsptr) 63 );
+	memset ( index.buckets, 0,
+		 8 * buckets * sizeof ( min::uns64 ) );
+	index.mask = buckets - 1;
+	index.used = 0;
+	index.live = 0;
+    }
+
+    // Store entry e for a stub with the given hash in
+    // the first EMPTY or DELETED entry of its probe
+    // sequence.
+    //
+    static void hash_index_store
+	    ( MINT::hash_index & index, min::uns32 hash,
+	      min::uns64 e )
+    {
+	min::unsptr bucket = hash & index.mask;
+	while ( true )
+	{
+	    min::uns64 * b = index.buckets + 8 * bucket;
+	    for ( unsigned i = 0; i < 8; ++ i )
+	    {
+		if ( b[i] == MINT::HASH_INDEX_EMPTY )
+		{
+		    b[i] = e;
+		    ++ index.used;
+		    ++ index.live;
+		    return;
+		}
+		else if (    b[i]
+		          == MINT::HASH_INDEX_DELETED )
+		{
+		    b[i] = e;
+		    ++ index.live;
+		    return;
+		}
+	    }
+	    bucket = ( bucket + 1 ) & index.mask;
+	}
+    }
+
+    // Rebuild the index with the given number of
+    // buckets, dropping DELETED entries.  The hash of
+    // each stub is recomputed from the stub.
+    //
+    static void hash_index_rebuild
+	    ( MINT::hash_index & index,
+	      min::unsptr buckets )
+    {
+	min::uns64 * old_buckets = index.buckets;
+	min::uns64 * old_memory = index.memory;
+	min::unsptr old_size = 8 * ( index.mask + 1 );
+
+	hash_index_allocate ( index, buckets );
+
+	for ( min::unsptr j = 0; j < old_size; ++ j )
+	{
+	    min::uns64 e = old_buckets[j];
+	    if ( e == MINT::HASH_INDEX_EMPTY
+	         ||
+		 e == MINT::HASH_INDEX_DELETED )
+		continue;
+	    min::stub * s =
+		  (min::stub *) MINT::stub_base
+		+ ( e & MINT::HASH_INDEX_STUB_MASK );
+	    min::uns32 hash =
+	        min::hash ( min::new_stub_gen ( s ) );
+	    hash_index_store ( index, hash, e );
+	}
+
+	delete[] old_memory;
+    }
+
+    void MINT::hash_index_insert
+	    ( MINT::hash_index & index, min::uns32 hash,
+	      min::stub * s )
+    {
+	if ( index.buckets == NULL )
+	    hash_index_allocate
+		( index, HASH_INDEX_INITIAL_BUCKETS );
+	else if (   4 * ( index.used + 1 )
+	          > 3 * 8 * ( index.mask + 1 ) )
+	{
+	    // Double the number of buckets unless at
+	    // least half the used entries are DELETED,
+	    // in which case rebuilding at the same size
+	    // suffices.
+	    //
+	    min::unsptr buckets = index.mask + 1;
+	    if ( 2 * index.live >= index.used )
+	        buckets *= 2;
+	    hash_index_rebuild ( index, buckets );
+	}
+
+	hash_index_store
+	    ( index, hash,
+		( MINT::hash_index_fingerprint ( hash )
+		  << 48 )
+	      + ( s - (min::stub *) MINT::stub_base ) );
+    }
+
+    void MINT::hash_index_remove
+	    ( MINT::hash_index & index, min::uns32 hash,
+	      min::stub * s )
+    {
+	MIN_REQUIRE ( index.buckets != NULL );
+	min::uns64 e =
+	      ( MINT::hash_index_fingerprint ( hash )
+	        << 48 )
+	    + ( s - (min::stub *) MINT::stub_base );
+	min::unsptr bucket = hash & index.mask;
+	while ( true )
+	{
+	    min::uns64 * b = index.buckets + 8 * bucket;
+	    for ( unsigned i = 0; i < 8; ++ i )
+	    {
+		if ( b[i] == e )
+		{
+		    b[i] = MINT::HASH_INDEX_DELETED;
+		    -- index.live;
+		    return;
+		}
+		else if ( b[i] == MINT::HASH_INDEX_EMPTY )
+		    MIN_ABORT
+		        ( "stub not in hash index" );
+	    }
+	    bucket = ( bucket + 1 ) & index.mask;
+	}
+    }
+
+# endif // MIN_FLAT_HASH_INDEX
 
 min::uns64 MINT::hash_acc_set_flags;
 min::uns64 MINT::hash_acc_clear_flags;
@@ -840,16 +1225,25 @@ min::uns64 MINT::hash_acc_clear_flags;
 # endif
 
 min::uns64   MINT::acc_stack_mask;
-min::stub ** MINT::acc_stack;
-min::stub ** volatile MINT::acc_stack_limit;
+MIN_THREAD_LOCAL min::stub ** MINT::acc_stack;
+MIN_THREAD_LOCAL min::stub ** volatile
+    MINT::acc_stack_limit;
 
 min::uns64  MINT::new_acc_stub_flags;
+min::uns64  MINT::acc_budget_limit = (min::uns64) -1;
 min::stub * MINT::head_stub;
 min::stub * MINT::last_allocated_stub;
 min::stub * MINT::last_free_stub;
+# if MIN_MUTATOR_THREADS
+    MIN_THREAD_LOCAL MINT::stub_buffer
+        MINT::acc_stub_buffer;
+# endif
 
 MINT::fixed_block_list MINT::fixed_block_lists
 	[MIN_ABSOLUTE_MAX_FIXED_BLOCK_SIZE_LOG-2];
+MIN_THREAD_LOCAL MINT::fixed_block_run
+    MINT::fixed_block_runs
+	[MIN_ABSOLUTE_MAX_FIXED_BLOCK_SIZE_LOG-2];
 
 min::unsptr MINT::min_fixed_block_size;
 min::unsptr MINT::max_fixed_block_size;
@@ -881,7 +1275,9 @@ unsigned MINT::number_of_acc_levels;
 	    if ( ! MINT::is_scavengable ( type ) ) \
 	    { \
 		accumulator |= c; \
-		c |= sc.set_flag; \
+		MINT::scavenge_claim \
+		    ( s2, c, sc.clear_flag, \
+		      sc.set_flag ); \
 	    } \
 	    else if (    sc.to_be_scavenged \
 		      >= sc.to_be_scavenged_limit ) \
@@ -893,10 +1289,10 @@ unsigned MINT::number_of_acc_levels;
 	    else \
 	    { \
 		accumulator |= c; \
-		* sc.to_be_scavenged ++ = s2; \
+		if ( MINT::scavenge_claim \
+			 ( s2, c, sc.clear_flag, 0 ) ) \
+		    * sc.to_be_scavenged ++ = s2; \
 	    } \
-	    c &= ~ sc.clear_flag; \
-	    MUP::set_control_of ( s2, c ); \
         } \
 	++ sc.stub_count; \
     }
@@ -1261,7 +1657,9 @@ static void packed_vec_scavenger_routine
 	        if ( ! MINT::is_scavengable ( type ) ) \
 	        { \
 	            accumulator |= c; \
-		    c |= sc.set_flag; \
+		    MINT::scavenge_claim \
+			( s2, c, sc.clear_flag, \
+			  sc.set_flag ); \
 	        } \
 	        else \
 		if (    sc.to_be_scavenged \
@@ -1274,10 +1672,11 @@ static void packed_vec_scavenger_routine
 	        else \
 	        { \
 	            accumulator |= c; \
-		    * sc.to_be_scavenged ++ = s2; \
+		    if ( MINT::scavenge_claim \
+			     ( s2, c, \
+			       sc.clear_flag, 0 ) ) \
+			* sc.to_be_scavenged ++ = s2; \
 		} \
-		c &= ~ sc.clear_flag; \
-		MUP::set_control_of ( s2, c ); \
 	    } \
 	    ++ sc.stub_count; \
 	}
@@ -1378,13 +1777,27 @@ void MINT::thread_scavenger_routine
 {
     if ( sc.thread_state == 0 )
     {
-        sc.locatable_gen_last =
-	    MINT::locatable_gen_last;
-        sc.locatable_var_last =
-	    MINT::locatable_stub_ptr_last;
+#	if MIN_MUTATOR_THREADS
+	    sc.thread_context = MINT::mutator_contexts;
+	    sc.locatable_gen_last =
+		* sc.thread_context->locatable_gen_last;
+	    sc.locatable_var_last =
+		* sc.thread_context
+		     ->locatable_stub_ptr_last;
+#	else
+	    sc.locatable_gen_last =
+		MINT::locatable_gen_last;
+	    sc.locatable_var_last =
+		MINT::locatable_stub_ptr_last;
+#	endif
     }
 
     min::uns64 accumulator = sc.stub_flag_accumulator;
+
+#   if MIN_MUTATOR_THREADS
+    next_thread:
+#   endif
+
     while ( sc.locatable_gen_last != NULL )
     {
 	if ( sc.gen_count >= sc.gen_limit )
@@ -1428,6 +1841,24 @@ void MINT::thread_scavenger_routine
 	        ( sc.locatable_var_last );
     }
 
+#   if MIN_MUTATOR_THREADS
+	// Scavenge the next thread's variables.  The
+	// mutator does not run until thread scavenging
+	// finishes or is restarted, so the context list
+	// does not change meanwhile.
+	//
+	sc.thread_context = sc.thread_context->next;
+	if ( sc.thread_context != NULL )
+	{
+	    sc.locatable_gen_last =
+		* sc.thread_context->locatable_gen_last;
+	    sc.locatable_var_last =
+		* sc.thread_context
+		     ->locatable_stub_ptr_last;
+	    goto next_thread;
+	}
+#   endif
+
     sc.stub_flag_accumulator = accumulator;
     sc.thread_state = 0;
 }
@@ -1668,39 +2099,63 @@ static void init_standard_char_flags ( void )
 	    ( min::float64 v )
     {
 	uns32 hash = floathash ( v );
-	uns32 h = hash & MINT::num_hash_mask;
-	min::stub * s = MINT::num_acc_hash[h];
-	while ( s != MINT::null_stub )
-	{
-	    uns64 c = MUP::control_of ( s );
+	MINT::allocator_lock lock;
+	min::stub ** acc_head;
+	min::stub ** aux_head;
+	MINT::num_hash_heads ( hash, acc_head, aux_head );
+	min::stub * s;
+
+#	if MIN_FLAT_HASH_INDEX
+	    MINT::hash_index_probe probe
+		( MINT::num_hash_index, hash );
+	    while ( ( s = probe.next() ) != NULL )
+	    {
+		if ( MUP::float_of ( s ) == v )
+		{
+		    uns64 c = MUP::control_of ( s );
+		    c |= MINT::hash_acc_set_flags;
+		    c &= ~ MINT::hash_acc_clear_flags;
+		    MUP::set_control_of ( s, c );
+		    return new_stub_gen ( s );
+		}
+	    }
+
+#	else // ! MIN_FLAT_HASH_INDEX
 
-	    if ( MUP::float_of ( s ) == v )
+	    s = * acc_head;
+	    while ( s != MINT::null_stub )
 	    {
-	        c |= MINT::hash_acc_set_flags;
-	        c &= ~ MINT::hash_acc_clear_flags;
-		MUP::set_control_of ( s, c );
-		return new_stub_gen ( s );
-	    }
-	    s = MUP::stub_of_acc_control ( c );
-	}
-	s = MINT::num_aux_hash[h];
-	while ( s != MINT::null_stub )
-	{
-	    min::stub * s2 =
-	        (min::stub *) MUP::ptr_of ( s );
-	    s = (min::stub *)
-		MUP::stub_of_control
-		    ( MUP::control_of ( s ) );
+		uns64 c = MUP::control_of ( s );
 
-	    if ( MUP::float_of ( s2 ) == v )
+		if ( MUP::float_of ( s ) == v )
+		{
+		    c |= MINT::hash_acc_set_flags;
+		    c &= ~ MINT::hash_acc_clear_flags;
+		    MUP::set_control_of ( s, c );
+		    return new_stub_gen ( s );
+		}
+		s = MUP::stub_of_acc_control ( c );
+	    }
+	    s = * aux_head;
+	    while ( s != MINT::null_stub )
 	    {
-		uns64 c = MUP::control_of ( s2 );
-	        c |= MINT::hash_acc_set_flags;
-	        c &= ~ MINT::hash_acc_clear_flags;
-		MUP::set_control_of ( s2, c );
-		return new_stub_gen ( s2 );
+		min::stub * s2 =
+		    (min::stub *) MUP::ptr_of ( s );
+		s = (min::stub *)
+		    MUP::stub_of_control
+			( MUP::control_of ( s ) );
+
+		if ( MUP::float_of ( s2 ) == v )
+		{
+		    uns64 c = MUP::control_of ( s2 );
+		    c |= MINT::hash_acc_set_flags;
+		    c &= ~ MINT::hash_acc_clear_flags;
+		    MUP::set_control_of ( s2, c );
+		    return new_stub_gen ( s2 );
+		}
 	    }
-	}
+
+#	endif // MIN_FLAT_HASH_INDEX
 
 	min::stub * s2 = MUP::new_acc_stub();
 	MUP::set_float_of ( s2, v );
@@ -1711,14 +2166,139 @@ static void init_standard_char_flags ( void )
 	MUP::set_control_of
 	    ( s,
 	      MUP::new_control_with_type
-	          ( HASHTABLE_AUX,
-		    MINT::num_aux_hash[h] ) );
-	MINT::num_aux_hash[h] = s;
+	          ( HASHTABLE_AUX, * aux_head ) );
+	* aux_head = s;
+	++ MINT::num_hash_count;
+#	if MIN_FLAT_HASH_INDEX
+	    MINT::hash_index_insert
+	        ( MINT::num_hash_index, hash, s2 );
+#	endif
 
 	return new_stub_gen ( s2 );
     }
 # endif
 
+# if MIN_STRHASH == 1
+
+// Word at a time hash.  Each 8 character word w is
+// mixed in by h = rotate ( h ^ w * K1 ) * K2, with the
+// last partial word padded with zeros, and the result
+// is finalized by the MurmurHash3 64 bit finalizer.
+// Words are loaded little endian on all machines so
+// hashes do not depend on endianness.
+
+# if MIN_STRHASH_SEED
+    min::uns64 MINT::strhash_seed = 0;
+#   define STRHASH_SEED MINT::strhash_seed
+# else
+#   define STRHASH_SEED 0
+# endif
+
+const min::uns64 STRHASH_K1 = 0x87c37b91114253d5ull;
+const min::uns64 STRHASH_K2 = 0x4cf5ad432745937full;
+
+// Load 8 characters as a little endian word.
+//
+inline min::uns64 strhash_load8
+	( const unsigned char * q )
+{
+    min::uns64 w;
+#   if MIN_IS_LITTLE_ENDIAN
+	memcpy ( & w, q, 8 );
+#   else
+	w = 0;
+	for ( int i = 7; i >= 0; -- i )
+	    w = ( w << 8 ) | q[i];
+#   endif
+    return w;
+}
+
+// Ditto for 4 characters.
+//
+inline min::uns64 strhash_load4
+	( const unsigned char * q )
+{
+    min::uns32 w;
+#   if MIN_IS_LITTLE_ENDIAN
+	memcpy ( & w, q, 4 );
+#   else
+	w = 0;
+	for ( int i = 3; i >= 0; -- i )
+	    w = ( w << 8 ) | q[i];
+#   endif
+    return w;
+}
+
+inline min::uns64 strhash_step
+	( min::uns64 h, min::uns64 w )
+{
+    h ^= w * STRHASH_K1;
+    h = ( h << 31 ) | ( h >> 33 );
+    return h * STRHASH_K2;
+}
+
+inline min::uns32 strhash_final ( min::uns64 h )
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return (min::uns32) ( h ^ ( h >> 32 ) );
+}
+
+// Hash the n characters beginning at p, none of which
+// are NUL.  The last partial word is loaded as the
+// last 8 characters of the string, shifted to discard
+// characters already hashed, so no character is
+// loaded one at a time unless n < 4.
+//
+static min::uns32 wordhash
+	( const char * p, min::unsptr n )
+{
+    const unsigned char * q =
+        (const unsigned char *) p;
+    min::uns64 h = STRHASH_SEED ^ n;
+    if ( n >= 8 )
+    {
+	const unsigned char * end = q + n;
+	while ( q + 8 <= end )
+	{
+	    h = strhash_step ( h, strhash_load8 ( q ) );
+	    q += 8;
+	}
+	if ( q < end )
+	    h = strhash_step
+	        ( h,   strhash_load8 ( end - 8 )
+		     >> ( 8 * ( 8 - ( end - q ) ) ) );
+    }
+    else if ( n >= 4 )
+	h = strhash_step
+	    ( h,   strhash_load4 ( q )
+		 | (   strhash_load4 ( q + n - 4 )
+		     << ( 8 * ( n - 4 ) ) ) );
+    else if ( n > 0 )
+	h = strhash_step
+	    ( h,   q[0]
+		 | ( (min::uns64) q[n/2] << 8 )
+		 | ( (min::uns64) q[n-1] << 16 ) );
+    min::uns32 hash = strhash_final ( h );
+    if ( hash == 0 ) hash = 0xFFFFFFFF;
+    return hash;
+}
+
+min::uns32 min::floathash ( min::float64 f )
+{
+    min::uns64 h;
+    memcpy ( & h, & f, 8 );
+    return strhash_final
+        ( strhash_step ( STRHASH_SEED, h ) );
+}
+
+# endif // MIN_STRHASH == 1
+
+# if MIN_STRHASH == 0
+
 min::uns32 min::floathash ( min::float64 f )
 {
     uns32 hash = 0;
@@ -1737,6 +2317,8 @@ min::uns32 min::floathash ( min::float64 f )
     }
     return hash;
 }
+
+# endif // MIN_STRHASH == 0
 
 // Strings
 // -------
@@ -1744,6 +2326,21 @@ min::uns32 min::floathash ( min::float64 f )
 min::unsptr min::max_id_strlen =
     min::DEFAULT_MAX_ID_STRLEN;
 
+# if MIN_STRHASH == 1
+
+min::uns32 min::strnhash
+	( const char * p, min::unsptr size )
+{
+    return wordhash ( p, ::strnlen ( p, size ) );
+}
+
+min::uns32 min::strhash ( const char * p )
+{
+    return wordhash ( p, ::strlen ( p ) );
+}
+
+# else // MIN_STRHASH == 0
+
 min::uns32 min::strnhash
 	( const char * p, min::unsptr size )
 {
@@ -1771,6 +2368,8 @@ min::uns32 min::strhash ( const char * p )
     return hash;
 }
 
+# endif // MIN_STRHASH == 0
+
 min::unsptr min::strlen ( min::gen g )
 {
     if ( is_direct_str ( g ) )
@@ -1955,81 +2554,117 @@ min::gen MINT::new_str_stub_gen
 	return new_stub_gen ( s );
     }
     uns32 hash = strnhash ( ~ p, n );
-    uns32 h = hash & MINT::str_hash_mask;
+    MINT::allocator_lock lock;
+    min::stub ** acc_head;
+    min::stub ** aux_head;
+    MINT::str_hash_heads ( hash, acc_head, aux_head );
     const char * q;
 
-    min::stub * s = MINT::str_acc_hash[h];
-    while ( s != MINT::null_stub )
-    {
-	uns64 c = MUP::control_of ( s );
+    min::stub * s;
+
+#   if MIN_FLAT_HASH_INDEX
+	MINT::hash_index_probe probe
+	    ( MINT::str_hash_index, hash );
+	while ( ( s = probe.next() ) != NULL )
+	{
+	    if ( n <= 8 ?
+			type_of ( s ) == SHORT_STR
+		     && ::strncmp ( ~ p, s->v.c8, n ) == 0
+		     && (    n == 8
+			  || s->v.c8[n] == 0 ) :
+			type_of ( s ) == LONG_STR
+		     && ::strncmp
+			    ( ~ p, q = MUP::str_of (
+					 MUP::long_str_of
+					     ( s ) ),
+			      n )
+			== 0
+		     && q[n] == 0 )
+	    {
+		uns64 c = MUP::control_of ( s );
+		c |= MINT::hash_acc_set_flags;
+		c &= ~ MINT::hash_acc_clear_flags;
+		MUP::set_control_of ( s, c );
+		return new_stub_gen ( s );
+	    }
+	}
 
-        if (    n <= 8
-	     && type_of ( s ) == SHORT_STR
-	     && ::strncmp ( ~ p, s->v.c8, n ) == 0
-	     && (    n == 8
-	          || s->v.c8[n] == 0 ) )
+#   else // ! MIN_FLAT_HASH_INDEX
+
+	s = * acc_head;
+	while ( s != MINT::null_stub )
 	{
-	    c |= MINT::hash_acc_set_flags;
-	    c &= ~ MINT::hash_acc_clear_flags;
-	    MUP::set_control_of ( s, c );
-	    return new_stub_gen ( s );
+	    uns64 c = MUP::control_of ( s );
+
+	    if (    n <= 8
+		 && type_of ( s ) == SHORT_STR
+		 && ::strncmp ( ~ p, s->v.c8, n ) == 0
+		 && (    n == 8
+		      || s->v.c8[n] == 0 ) )
+	    {
+		c |= MINT::hash_acc_set_flags;
+		c &= ~ MINT::hash_acc_clear_flags;
+		MUP::set_control_of ( s, c );
+		return new_stub_gen ( s );
+	    }
+	    else if (    n > 8
+		      && type_of ( s ) == LONG_STR
+		      && ::strncmp
+			   ( ~ p, q = MUP::str_of (
+					MUP::long_str_of
+					    ( s ) ),
+			     n )
+			 == 0
+		      && q[n] == 0 )
+	    {
+		c |= MINT::hash_acc_set_flags;
+		c &= ~ MINT::hash_acc_clear_flags;
+		MUP::set_control_of ( s, c );
+		return new_stub_gen ( s );
+	    }
+	    s = MUP::stub_of_acc_control ( c );
 	}
-	else if (    n > 8
-	          && type_of ( s ) == LONG_STR
-	          && ::strncmp
-		       ( ~ p, q = MUP::str_of (
-			            MUP::long_str_of
-				        ( s ) ),
-			 n )
-		     == 0
-		  && q[n] == 0 )
+
+	s = * aux_head;
+	while ( s != MINT::null_stub )
 	{
-	    c |= MINT::hash_acc_set_flags;
-	    c &= ~ MINT::hash_acc_clear_flags;
-	    MUP::set_control_of ( s, c );
-	    return new_stub_gen ( s );
-	}
-	s = MUP::stub_of_acc_control ( c );
-    }
+	    min::stub * s2 =
+		(min::stub *) MUP::ptr_of ( s );
+	    s = (min::stub *)
+		MUP::stub_of_control
+		    ( MUP::control_of ( s ) );
 
-    s = MINT::str_aux_hash[h];
-    while ( s != MINT::null_stub )
-    {
-	min::stub * s2 =
-	    (min::stub *) MUP::ptr_of ( s );
-	s = (min::stub *)
-	    MUP::stub_of_control
-		( MUP::control_of ( s ) );
-
-        if (    n <= 8
-	     && type_of ( s2 ) == SHORT_STR
-	     && ::strncmp ( ~ p, s2->v.c8, n ) == 0
-	     && (    n == 8
-	          || s2->v.c8[n] == 0 ) )
-	{
-	    uns64 c = MUP::control_of ( s2 );
-	    c |= MINT::hash_acc_set_flags;
-	    c &= ~ MINT::hash_acc_clear_flags;
-	    MUP::set_control_of ( s2, c );
-	    return new_stub_gen ( s2 );
-	}
-	else if (    n > 8
-	          && type_of ( s2 ) == LONG_STR
-	          && ::strncmp
-		       ( ~ p, q = MUP::str_of (
-			            MUP::long_str_of
-				        ( s2 ) ),
-			  n )
-		     == 0
-		  && q[n] == 0 )
-	{
-	    uns64 c = MUP::control_of ( s2 );
-	    c |= MINT::hash_acc_set_flags;
-	    c &= ~ MINT::hash_acc_clear_flags;
-	    MUP::set_control_of ( s2, c );
-	    return new_stub_gen ( s2 );
+	    if (    n <= 8
+		 && type_of ( s2 ) == SHORT_STR
+		 && ::strncmp ( ~ p, s2->v.c8, n ) == 0
+		 && (    n == 8
+		      || s2->v.c8[n] == 0 ) )
+	    {
+		uns64 c = MUP::control_of ( s2 );
+		c |= MINT::hash_acc_set_flags;
+		c &= ~ MINT::hash_acc_clear_flags;
+		MUP::set_control_of ( s2, c );
+		return new_stub_gen ( s2 );
+	    }
+	    else if (    n > 8
+		      && type_of ( s2 ) == LONG_STR
+		      && ::strncmp
+			   ( ~ p, q = MUP::str_of (
+					MUP::long_str_of
+					    ( s2 ) ),
+			      n )
+			 == 0
+		      && q[n] == 0 )
+	    {
+		uns64 c = MUP::control_of ( s2 );
+		c |= MINT::hash_acc_set_flags;
+		c &= ~ MINT::hash_acc_clear_flags;
+		MUP::set_control_of ( s2, c );
+		return new_stub_gen ( s2 );
+	    }
 	}
-    }
+
+#   endif // MIN_FLAT_HASH_INDEX
 
     min::stub * s2 = MUP::new_acc_stub();
     if ( n <= 8 )
@@ -2046,9 +2681,13 @@ min::gen MINT::new_str_stub_gen
     MUP::set_control_of
 	( s,
 	  MUP::new_control_with_type
-	      ( HASHTABLE_AUX,
-		MINT::str_aux_hash[h] ));
-    MINT::str_aux_hash[h] = s;
+	      ( HASHTABLE_AUX, * aux_head ) );
+    * aux_head = s;
+    ++ MINT::str_hash_count;
+#   if MIN_FLAT_HASH_INDEX
+	MINT::hash_index_insert
+	    ( MINT::str_hash_index, hash, s2 );
+#   endif
 
     return new_stub_gen ( s2 );
 }
@@ -2279,56 +2918,92 @@ min::gen min::new_lab_gen
 	( min::ptr<const min::gen> p, min::uns32 n )
 {
     uns32 hash = labhash ( ~ p, n );
-    uns32 h = hash & MINT::lab_hash_mask;
+    MINT::allocator_lock lock;
+    min::stub ** acc_head;
+    min::stub ** aux_head;
+    MINT::lab_hash_heads ( hash, acc_head, aux_head );
 
     // Search for existing label stub with given
     // elements.
     //
-    min::stub * s = MINT::lab_acc_hash[h];
-    while ( s != MINT::null_stub )
-    {
-	uns64 c = MUP::control_of ( s );
+    min::stub * s;
 
-	lab_ptr labp ( s );
+#   if MIN_FLAT_HASH_INDEX
+	MINT::hash_index_probe probe
+	    ( MINT::lab_hash_index, hash );
+	while ( ( s = probe.next() ) != NULL )
+	{
+	    lab_ptr labp ( s );
 
-	if ( hash != labhash ( labp ) ) continue;
-	if ( n != lablen ( labp ) ) continue;
+	    if ( hash != labhash ( labp ) ) continue;
+	    if ( n != lablen ( labp ) ) continue;
 
-	uns32 i;
-	for ( i = 0; i < n && p[i] == labp[i]; ++ i );
-	if ( i == n )
-	{
-	    c |= MINT::hash_acc_set_flags;
-	    c &= ~ MINT::hash_acc_clear_flags;
-	    MUP::set_control_of ( s, c );
-	    return new_stub_gen ( s );
+	    uns32 i;
+	    for ( i = 0; i < n && p[i] == labp[i]; ++ i );
+	    if ( i == n )
+	    {
+		uns64 c = MUP::control_of ( s );
+		c |= MINT::hash_acc_set_flags;
+		c &= ~ MINT::hash_acc_clear_flags;
+		MUP::set_control_of ( s, c );
+		return new_stub_gen ( s );
+	    }
 	}
-	s = MUP::stub_of_acc_control ( c );
-    }
-    s = MINT::lab_aux_hash[h];
-    while ( s != MINT::null_stub )
-    {
-        min::stub * s2 =
-	    (min::stub *) MUP::ptr_of ( s );
-	s = MUP::stub_of_control
-		    ( MUP::control_of ( s ) );
 
-	lab_ptr labp ( s2 );
+#   else // ! MIN_FLAT_HASH_INDEX
 
-	if ( hash != labhash ( labp ) ) continue;
-	if ( n != lablen ( labp ) ) continue;
+	s = * acc_head;
+	while ( s != MINT::null_stub )
+	{
+	    uns64 c = MUP::control_of ( s );
+	    min::stub * next_s =
+		MUP::stub_of_acc_control ( c );
 
-	uns32 i;
-	for ( i = 0; i < n && p[i] == labp[i]; ++ i );
-	if ( i == n )
+	    lab_ptr labp ( s );
+
+	    if ( hash == labhash ( labp )
+		 &&
+		 n == lablen ( labp ) )
+	    {
+		uns32 i;
+		for ( i = 0; i < n && p[i] == labp[i];
+		      ++ i );
+		if ( i == n )
+		{
+		    c |= MINT::hash_acc_set_flags;
+		    c &= ~ MINT::hash_acc_clear_flags;
+		    MUP::set_control_of ( s, c );
+		    return new_stub_gen ( s );
+		}
+	    }
+	    s = next_s;
+	}
+	s = * aux_head;
+	while ( s != MINT::null_stub )
 	{
-	    uns64 c = MUP::control_of ( s2 );
-	    c |= MINT::hash_acc_set_flags;
-	    c &= ~ MINT::hash_acc_clear_flags;
-	    MUP::set_control_of ( s2, c );
-	    return new_stub_gen ( s2 );
+	    min::stub * s2 =
+		(min::stub *) MUP::ptr_of ( s );
+	    s = MUP::stub_of_control
+			( MUP::control_of ( s ) );
+
+	    lab_ptr labp ( s2 );
+
+	    if ( hash != labhash ( labp ) ) continue;
+	    if ( n != lablen ( labp ) ) continue;
+
+	    uns32 i;
+	    for ( i = 0; i < n && p[i] == labp[i]; ++ i );
+	    if ( i == n )
+	    {
+		uns64 c = MUP::control_of ( s2 );
+		c |= MINT::hash_acc_set_flags;
+		c &= ~ MINT::hash_acc_clear_flags;
+		MUP::set_control_of ( s2, c );
+		return new_stub_gen ( s2 );
+	    }
 	}
-    }
+
+#   endif // MIN_FLAT_HASH_INDEX
 
     // Allocate new label.
     //
@@ -2345,9 +3020,13 @@ min::gen min::new_lab_gen
     MUP::set_control_of
 	( s,
 	  MUP::new_control_with_type
-	      ( HASHTABLE_AUX,
-		MINT::lab_aux_hash[h] ));
-    MINT::lab_aux_hash[h] = s;
+	      ( HASHTABLE_AUX, * aux_head ) );
+    * aux_head = s;
+    ++ MINT::lab_hash_count;
+#   if MIN_FLAT_HASH_INDEX
+	MINT::hash_index_insert
+	    ( MINT::lab_hash_index, hash, s2 );
+#   endif
 
     MUP::set_type_of ( s2, LABEL );
     return new_stub_gen ( s2 );
@@ -2483,6 +3162,17 @@ static min::packed_vec<char> file_buffer_type
 static min::packed_vec<min::uns32> file_line_index_type
     ( "min::file_line_index_type" );
 
+// Release the map of a file that is collected before
+// all its input is read.
+//
+static void release_file ( min::stub * s )
+{
+    min::file_struct * fp =
+        (min::file_struct *) MUP::ptr_of ( s );
+    if ( fp->map != NULL )
+        min::os::unmap_file ( fp->map, fp->map_size );
+}
+
 static min::uns32 phrase_position_vec_stub_disp[2] =
     { min::DISP ( & min::phrase_position_vec_header
                        ::file ),
@@ -2501,6 +3191,9 @@ void min::init ( min::ref<min::file> file )
     {
 	::file_buffer_type.initial_max_length = 4096;
 	::file_line_index_type.initial_max_length = 128;
+	::file_buffer_type.fill_body = true;
+	::file_line_index_type.fill_body = true;
+	::file_type.release = ::release_file;
 
         file = ::file_type.new_stub();
 	buffer_ref(file) =
@@ -2590,6 +3283,13 @@ void min::init_input
 
     file->istream = NULL;
     ifile_ref(file) = NULL_STUB;
+    if ( file->map != NULL )
+        min::os::unmap_file
+	    ( file->map, file->map_size );
+    file->map = NULL;
+    file->map_size = 0;
+    file->map_offset = 0;
+    file->buffer_base = 0;
     file_name_ref(file) = MISSING();
 }
 
@@ -2624,6 +3324,95 @@ void min::init_input_string
     complete_file ( file );
 }
 
+// Replace each line feed in p[0 .. n-1] by a NUL and
+// return the number of NULs then in p[0 .. n-1].  If
+// this is not 0, set last to the index of the last NUL.
+// This is used to end all the lines of text loaded into
+// a file buffer at once, 16 (SSE2) or 32 (AVX2) char-
+// acters at a time.
+//
+static min::uns64 split_lines
+	( char * p, min::uns64 n, min::uns64 & last )
+{
+    min::uns64 count = 0;
+    min::uns64 i = 0;
+
+#   if defined ( __SSE2__ ) && MIN_USE_GNUC_BUILTINS
+
+#	ifdef __AVX2__
+	    const __m256i lf32 = _mm256_set1_epi8 ( '\n' );
+	    const __m256i zero32 = _mm256_setzero_si256();
+	    for ( ; i + 32 <= n; i += 32 )
+	    {
+		__m256i v = _mm256_loadu_si256
+		    ( (const __m256i *) ( p + i ) );
+		__m256i lf = _mm256_cmpeq_epi8 ( v, lf32 );
+		min::uns32 mask = (min::uns32)
+		    _mm256_movemask_epi8
+			( _mm256_or_si256
+			      ( lf, _mm256_cmpeq_epi8
+					( v, zero32 ) ) );
+		if ( mask == 0 ) continue;
+		_mm256_storeu_si256
+		    ( (__m256i *) ( p + i ),
+		      _mm256_andnot_si256 ( lf, v ) );
+		count += __builtin_popcount ( mask );
+		last = i + 31 - __builtin_clz ( mask );
+	    }
+#	endif
+
+	const __m128i lf16 = _mm_set1_epi8 ( '\n' );
+	const __m128i zero16 = _mm_setzero_si128();
+	for ( ; i + 16 <= n; i += 16 )
+	{
+	    __m128i v = _mm_loadu_si128
+		( (const __m128i *) ( p + i ) );
+	    __m128i lf = _mm_cmpeq_epi8 ( v, lf16 );
+	    min::uns32 mask = (min::uns32)
+		_mm_movemask_epi8
+		    ( _mm_or_si128
+			  ( lf, _mm_cmpeq_epi8
+				    ( v, zero16 ) ) );
+	    if ( mask == 0 ) continue;
+	    _mm_storeu_si128
+		( (__m128i *) ( p + i ),
+		  _mm_andnot_si128 ( lf, v ) );
+	    count += __builtin_popcount ( mask );
+	    last = i + 31 - __builtin_clz ( mask );
+	}
+
+#   endif
+
+    for ( ; i < n; ++ i )
+    {
+        if ( p[i] == '\n' ) p[i] = 0;
+	if ( p[i] == 0 )
+	{
+	    ++ count;
+	    last = i;
+	}
+    }
+
+    return count;
+}
+
+// End all the lines in the part of the file buffer
+// beginning at offset.
+//
+static void end_lines
+	( min::file file, min::uns32 offset )
+{
+    min::uns64 last;
+    min::uns64 count =
+        ::split_lines
+	    ( ~ ( file->buffer + offset ),
+	      file->buffer->length - offset, last );
+    if ( count == 0 ) return;
+
+    file->end_count += count;
+    file->end_offset = offset + last + 1;
+}
+
 void min::load_string
 	( min::file file,
 	  min::ptr<const char> string )
@@ -2638,12 +3427,7 @@ void min::load_string
 		 " is too full" );
 
     min::push ( file->buffer, length, string );
-
-    for ( uns32 i = offset; i < length; ++ i )
-    {
-        if ( file->buffer[i] == '\n' )
-	    min::end_line ( file, i );
-    }
+    ::end_lines ( file, offset );
 }
 
 bool min::init_input_named_file
@@ -2663,6 +3447,38 @@ bool min::init_input_named_file
     }
 }
 
+bool min::init_input_mapped_file
+	( min::ref<min::file> file,
+	  min::gen file_name,
+	  const min::line_format * line_format,
+	  min::uns32 spool_lines )
+{
+    init_input ( file, line_format, spool_lines );
+    file_name_ref(file) = file_name;
+
+    min::str_ptr fname ( file_name );
+    char error_buffer[512];
+    uns64 file_size;
+    const char * map =
+        min::os::map_file
+	    ( file_size,
+	      ~ min::begin_ptr_of ( fname ),
+	      error_buffer );
+    if ( map == NULL )
+    {
+	ERR << "Mapping file "
+	    << fname << ": "
+	    << min::reserve ( 40 )
+	    << error_buffer << min::eol;
+        return false;
+    }
+
+    file->map = map;
+    file->map_size = file_size;
+    file->map_offset = 0;
+    return true;
+}
+
 bool min::load_named_file
 	( min::file file,
 	  min::gen file_name )
@@ -2726,13 +3542,7 @@ bool min::load_named_file
     if ( bytes < file_size )
         min::pop ( file->buffer, file_size - bytes );
 
-    for ( uns32 i = offset;
-          i < file->buffer->length; ++ i )
-    {
-	char c = file->buffer[i];
-        if ( c == '\n' || c == 0 )
-	    min::end_line ( file, i );
-    }
+    ::end_lines ( file, offset );
 
     if ( bytes != file_size )
     {
@@ -2828,6 +3638,44 @@ min::uns32 min::next_line ( min::file file )
 	    min::push ( file->buffer, length,
 	                ifile->buffer + ioffset );
 	}
+	else if ( file->map != NULL )
+	{
+	    // Copy the next line from the map.  Lines
+	    // end with a NUL or a line feed, which is
+	    // replaced by the NUL pushed by end_line,
+	    // so buffer offsets of lines plus buffer_
+	    // base equal their offsets in the file.
+	    //
+	    const char * p =
+	        file->map + file->map_offset;
+	    uns64 remaining =
+	        file->map_size - file->map_offset;
+	    const char * q = (const char *)
+	        ::memchr ( p, '\n', remaining );
+	    uns64 length =
+	        q == NULL ? remaining : q - p;
+	    length = ::strnlen ( p, length );
+
+	    MIN_ASSERT (    length
+	                 <  ( 1ull << 32 ) - 1
+			  - file->buffer->length,
+			 "file buffer is too full"
+			 " (use spool_lines and"
+			 " flush_spool)" );
+	    min::push ( file->buffer, length, p );
+
+	    if ( length == remaining )
+	    {
+	        // Partial line or end of file.
+		//
+		min::os::unmap_file
+		    ( file->map, file->map_size );
+		file->map = NULL;
+		min::complete_file ( file );
+		return min::NO_LINE;
+	    }
+	    file->map_offset += length + 1;
+	}
 	else
 	    return min::NO_LINE;
 
@@ -2862,6 +3710,16 @@ min::uns32 min::line
 		        - line_number)];
 }
 
+min::uns64 min::line64
+	( min::file file, uns32 line_number )
+{
+    uns32 offset = min::line ( file, line_number );
+    if ( offset == min::NO_LINE )
+        return min::NO_LINE64;
+    else
+        return file->buffer_base + offset;
+}
+
 static min::uns32 end_line
         ( min::printer printer, min::uns32 op_flags );
 min::uns32 min::print_line
@@ -3480,6 +4338,7 @@ void min::flush_spool
 		    file->buffer->length
 		  - buffer_offset );
     min::pop ( file->buffer, buffer_offset );
+    file->buffer_base += buffer_offset;
     if ( file->end_offset >= buffer_offset )
 	file->end_offset -= buffer_offset;
     else
@@ -4187,6 +5046,7 @@ min::Uchar min::find
 // -------
 
 bool min::use_obj_aux_stubs = false;
+min::unsptr min::max_hash_chain = 8;
 
 inline min::unsptr EXP2 ( unsigned bits )
 {
@@ -6146,7 +7006,7 @@ min::unsptr min::hash_count_of
 {
     unsptr count = 0;
     unsptr index = MUP::hash_offset_of ( vp );
-    unsptr end_index = MUP::attr_offset_of ( vp );
+    unsptr end_index = index + hash_size_of ( vp );
     for ( ; index < end_index; ++ index )
     {
         min::gen v = MUP::base(vp)[index];
@@ -6296,11 +7156,16 @@ inline void copy_to_work
 }
 
 // Copy hash table to work as per pass 1, changing the
-// size of the hash table.
+// size of the hash table.  If seeds is not NULL, the
+// new hash table is a frozen object hash table (see
+// min::OBJ_FROZEN) with the given seeds, which are
+// copied to work after the hash-lists.
 //
 inline void copy_hash_to_work
 	( min::obj_vec_ptr & vp,
 	  min::unsptr new_hash_size,
+	  const min::uns32 * seeds,
+	  min::unsptr seeds_size,
 	  min::gen * & work_low,
 	  min::gen * & work_high,
 	  min::gen *   work_end )
@@ -6334,8 +7199,11 @@ inline void copy_hash_to_work
 	FORLIST(vp,index2,s,v,false)
 	    if ( label_is_next )
 	    {
-		min::uns32 hash = min::hash ( v )
-			        % new_hash_size;
+		min::uns32 hash = min::hash ( v );
+		if ( seeds != NULL )
+		    hash = MINT::seeded_hash
+		        ( hash, seeds[hash % seeds_size] );
+		hash %= new_hash_size;
 		++ hash_count[hash];
 		label_is_next = false;
 	    }
@@ -6373,6 +7241,14 @@ inline void copy_hash_to_work
 		       * sizeof ( min::gen ) );
 	}
     }
+    for ( min::unsptr i = 0; i < seeds_size; ++ i )
+#	if MIN_IS_COMPACT
+	    * work_low ++ =
+	        MUP::new_direct_int_gen ( seeds[i] );
+#	else
+	    * work_low ++ =
+	        MUP::new_direct_float_gen ( seeds[i] );
+#	endif
 
     // Now go back through the original hash table and
     // move the attribute/node-name-descriptor-pairs to
@@ -6396,8 +7272,11 @@ inline void copy_hash_to_work
 	FORLIST(vp,index2,s,v,true)
 	    if ( label_is_next )
 	    {
-		min::uns32 hash = min::hash ( v )
-			        % new_hash_size;
+		min::uns32 hash = min::hash ( v );
+		if ( seeds != NULL )
+		    hash = MINT::seeded_hash
+		        ( hash, seeds[hash % seeds_size] );
+		hash %= new_hash_size;
 		min::unsptr index3 =
 		    MUP::aux_of
 			( new_hash[hash] );
@@ -6444,11 +7323,13 @@ inline void scan_work_area
 	    const min::stub * s = NULL;
 	    min::unsptr index = 0;
 	    if ( min::is_sublist_aux ( v ) )
-		index = MUP::aux_of ( v );
+		index = min::total_size_of ( vp )
+		      - MUP::aux_of ( v );
 	    else
 		s = MUP::stub_of ( v );
 #       else
-	    min::unsptr index = MUP::aux_of ( v );
+	    min::unsptr index = min::total_size_of ( vp )
+	                      - MUP::aux_of ( v );
 #       endif
 
 	* p = min::new_sublist_aux_gen
@@ -6467,6 +7348,24 @@ void min::reorganize
 	  min::unsptr var_size,
 	  min::unsptr unused_size,
 	  bool expand )
+{
+    MINT::reorganize
+        ( vp, hash_size, var_size, unused_size, expand,
+	  NULL, 0 );
+}
+
+// Ditto but if seeds is not NULL make the object hash
+// table a frozen object hash table with the given
+// seeds (see min::OBJ_FROZEN), and set OBJ_FROZEN.
+//
+void MINT::reorganize
+	( min::obj_vec_insptr & vp,
+	  min::unsptr hash_size,
+	  min::unsptr var_size,
+	  min::unsptr unused_size,
+	  bool expand,
+	  const min::uns32 * seeds,
+	  min::unsptr seeds_size )
 {
     unsptr old_hash_size = min::hash_size_of ( vp );
     unsptr old_var_size = min::var_size_of ( vp );
@@ -6479,6 +7378,7 @@ void min::reorganize
 		       // If hash_size > old_hash_size
 		       // we need to add an a LIST_END
 		       // for each new hash table entry.
+		     + seeds_size
                      + attr_size_of ( vp );
 #   if MIN_USE_OBJ_AUX_STUBS
 	// if ( MINT::aux_flag_of ( vp ) )
@@ -6504,7 +7404,9 @@ void min::reorganize
         end_index = var_size;
     else if ( var_size > old_var_size )
         end_index = old_var_size;
-    else if ( hash_size != old_hash_size )
+    else if ( hash_size != old_hash_size
+              ||
+	      seeds != NULL )
 	end_index = MUP::hash_offset_of ( vp );
     else
 	end_index = MUP::unused_offset_of ( vp );
@@ -6518,10 +7420,12 @@ void min::reorganize
 	while ( work_low < work_begin + var_size )
 	    * work_low ++ = min::UNDEFINED();
 
-	if ( hash_size != old_hash_size )
+	if ( hash_size != old_hash_size
+	     ||
+	     seeds != NULL )
 	{
 	    ::copy_hash_to_work
-		( vp, hash_size,
+		( vp, hash_size, seeds, seeds_size,
 		work_low, work_high, work_end );
 	    index = MUP::attr_offset_of ( vp );
 	}
@@ -6542,11 +7446,23 @@ void min::reorganize
 	+ ( work_end - work_high )
 	+ unused_size;
 
+    // Size of hash area, including any seeds.
+    //
+    unsptr header_hash_size = hash_size + seeds_size;
+    if ( seeds != NULL )
+    {
+        MIN_REQUIRE
+	    (    MINT::frozen_hash_size
+	             ( header_hash_size )
+	      == hash_size );
+	vp.unused_offset_flags |= min::OBJ_FROZEN;
+    }
+
     int type;
     unsptr header_size;
     ::compute_object_type
 	( type, total_size, header_size,
-	  var_size, hash_size, expand );
+	  var_size, header_hash_size, expand );
 
     MUP::resize_body rbody
         ( MUP::stub_of ( vp ),
@@ -6556,7 +7472,7 @@ void min::reorganize
 
     unsptr var_offset = header_size;
     unsptr hash_offset = var_offset + var_size;
-    unsptr attr_offset = hash_offset + hash_size;
+    unsptr attr_offset = hash_offset + header_hash_size;
     unsptr unused_offset = attr_offset
                          + min::attr_size_of ( vp );
     unsptr aux_offset = total_size
@@ -6568,7 +7484,7 @@ void min::reorganize
 	( newb,
 	  type,
 	  var_size,
-	  hash_size,
+	  header_hash_size,
 	  total_size,
 	  unused_offset,
 	  aux_offset,
@@ -6621,6 +7537,191 @@ void min::compact
 	      expand );
 }
 
+// Seeds tried for a bucket by compute_seeds before it
+// gives up.
+//
+static const min::uns32 max_seed = 1 << 16;
+
+// Orders buckets by decreasing number of names, given
+// start[b] = index of the first name of bucket b.
+//
+struct bucket_greater
+{
+    const min::unsptr * start;
+    bucket_greater ( const min::unsptr * start )
+        : start ( start ) {}
+    bool operator () ( min::unsptr b1, min::unsptr b2 )
+    {
+        return   start[b1+1] - start[b1]
+	       > start[b2+1] - start[b2];
+    }
+};
+
+// Given the n hashes of the names of an object to be
+// frozen, try to compute seeds[b] for each of seeds_
+// size buckets so that the names are in distinct hash-
+// lists of a hash table of hash_size hash-lists (see
+// min::OBJ_FROZEN).  Return true on success, false if
+// some bucket gets no seed less than max_seed.
+//
+// This is the CHD (compress, hash, and displace)
+// construction: the largest buckets are given seeds
+// first, and each bucket gets the smallest seed that
+// puts its names in hash-lists not yet used.
+//
+static bool compute_seeds
+	( const min::uns32 * hashes, min::unsptr n,
+	  min::unsptr hash_size,
+	  min::uns32 * seeds, min::unsptr seeds_size )
+{
+    // Group the hashes by bucket: names[start[b] ..
+    // start[b+1]-1] are the hashes of bucket b.
+    //
+    min::unsptr * start =
+        new min::unsptr[seeds_size+1];
+    min::unsptr * buckets =
+        new min::unsptr[seeds_size];
+    min::uns32 * names = new min::uns32[n+1];
+    min::unsptr * slots = new min::unsptr[n+1];
+    bool * used = new bool[hash_size];
+
+    memset ( (void *) start, 0,
+             ( seeds_size + 1 ) * sizeof ( start[0] ) );
+    for ( min::unsptr i = 0; i < n; ++ i )
+        ++ start[hashes[i] % seeds_size + 1];
+    for ( min::unsptr b = 0; b < seeds_size; ++ b )
+        start[b+1] += start[b];
+    for ( min::unsptr b = 0; b < seeds_size; ++ b )
+        buckets[b] = start[b];
+    for ( min::unsptr i = 0; i < n; ++ i )
+        names[buckets[hashes[i] % seeds_size]++] =
+	    hashes[i];
+
+    for ( min::unsptr b = 0; b < seeds_size; ++ b )
+        buckets[b] = b;
+    std::sort ( buckets, buckets + seeds_size,
+                bucket_greater ( start ) );
+
+    memset ( (void *) used, 0,
+             hash_size * sizeof ( used[0] ) );
+    bool result = true;
+    for ( min::unsptr k = 0; k < seeds_size; ++ k )
+    {
+        min::unsptr b = buckets[k];
+	const min::uns32 * bnames = names + start[b];
+	min::unsptr size = start[b+1] - start[b];
+	min::uns32 seed = 0;
+	for ( ; size > 0 && seed < max_seed; ++ seed )
+	{
+	    min::unsptr j = 0;
+	    for ( ; j < size; ++ j )
+	    {
+		min::unsptr slot =
+		      MINT::seeded_hash
+		          ( bnames[j], seed )
+		    % hash_size;
+		if ( used[slot] ) break;
+		used[slot] = true;
+		slots[j] = slot;
+	    }
+	    if ( j == size ) break;
+	    while ( j > 0 ) used[slots[--j]] = false;
+	}
+	if ( seed == max_seed )
+	{
+	    result = false;
+	    break;
+	}
+	seeds[b] = seed;
+    }
+
+    delete [] start;
+    delete [] buckets;
+    delete [] names;
+    delete [] slots;
+    delete [] used;
+    return result;
+}
+
+void min::freeze
+	( min::obj_vec_insptr & vp,
+	  min::unsptr max_hash_factor )
+{
+    // Compute the hashes of the hash table attribute
+    // names.
+    //
+    unsptr n = hash_count_of ( vp );
+    min::uns32 * hashes = new min::uns32[n+1];
+    unsptr i = 0;
+    unsptr begin_index = MUP::hash_offset_of ( vp );
+    unsptr end_index = begin_index + hash_size_of ( vp );
+    for ( unsptr index = begin_index;
+          index < end_index; ++ index )
+    {
+#       if MIN_USE_OBJ_AUX_STUBS
+	    const min::stub * s = NULL;
+#       endif
+	min::unsptr index2 = index;
+	bool label_is_next = true;
+	FORLIST(vp,index2,s,v,false)
+	    if ( label_is_next )
+	    {
+		hashes[i++] = min::hash ( v );
+		label_is_next = false;
+	    }
+	    else label_is_next = true;
+	ENDFORLIST
+    }
+    MIN_REQUIRE ( i == n );
+
+    // Names with equal hashes can never be put in
+    // distinct hash-lists.
+    //
+    std::sort ( hashes, hashes + n );
+    bool distinct = true;
+    for ( i = 1; i < n && distinct; ++ i )
+        distinct = ( hashes[i-1] != hashes[i] );
+
+    // Try hash tables of n + n/4 hash-lists and then
+    // 25% bigger each time, up to max_hash_factor * n
+    // hash-lists.  There are about a quarter as many
+    // seeds as hash-lists, so buckets average about 3
+    // names.
+    //
+    bool frozen = false;
+    for ( unsptr size = n + n / 4;
+          distinct && ! frozen
+	  &&
+	  ( size == n + n / 4
+	    ||
+	    size <= max_hash_factor * n );
+	  size += size / 4 + 1 )
+    {
+        unsptr H = size;
+	while ( MINT::frozen_hash_size ( H ) < size )
+	    ++ H;
+	unsptr seeds_size = H - size;
+	min::uns32 * seeds =
+	    new min::uns32[seeds_size+1];
+	if ( n == 0
+	     ||
+	     compute_seeds
+	         ( hashes, n, size, seeds, seeds_size ) )
+	{
+	    MINT::reorganize
+		( vp, size, var_size_of ( vp ), 0, false,
+		  seeds, seeds_size );
+	    frozen = true;
+	}
+	delete [] seeds;
+    }
+    delete [] hashes;
+
+    if ( ! frozen )
+	compact ( vp, var_size_of ( vp ), 0, false );
+    set_public_flag_of ( vp );
+}
+
 bool min::list_equal
 	( min::obj_vec_ptr & vp1,
 	  min::obj_vec_ptr & vp2,
@@ -6814,6 +7915,38 @@ min::printer min::list_print
 // Object Attribute Level
 // ------ --------- -----
 
+void MINT::grow_hash ( min::attr_insptr & ap )
+{
+    min::obj_vec_insptr & vp =
+        obj_vec_ptr_of ( ap.locate_dlp );
+    if ( ! grow_hash_flag_of ( vp ) ) return;
+
+    // Count the names in the hash-list just added to.
+    // Names are only counted for the whole object
+    // when this is too long, and the object is only
+    // reorganized when it has more names than hash
+    // table entries, so reorganizations are no more
+    // frequent than doublings of the number of names.
+    //
+    {
+	min::list_insptr lp ( vp );
+	min::unsptr names = 0;
+	for ( min::gen c = start_hash ( lp, ap.index );
+	      ! is_list_end ( c );
+	      next ( lp ), c = next ( lp ) )
+	    ++ names;
+	if ( names <= min::max_hash_chain ) return;
+    }
+
+    min::unsptr hash_count = hash_count_of ( vp );
+    if ( hash_count <= hash_size_of ( vp ) ) return;
+
+    reorganize ( vp, 2 * hash_count,
+                 var_size_of ( vp ),
+		 unused_size_of ( vp ) );
+    min::relocate ( ap );
+}
+
 # if MIN_ALLOW_PARTIAL_ATTR_LABELS
 
     template < class vecpt >
@@ -6893,10 +8026,14 @@ min::printer min::list_print
 			 "name argument is not"
 			 " a name" );
 
-	    ap.index = min::hash ( element[0] );
+	    ap.index = MINT::list_hash
+	        ( obj_vec_ptr_of ( ap.dlp ),
+		  min::hash ( element[0] ) );
 	    ap.flags = 0;
 
 	    start_hash ( ap.dlp, ap.index );
+	    bool frozen = frozen_flag_of
+		( obj_vec_ptr_of ( ap.dlp ) );
 
 	    for ( c = current ( ap.dlp );
 		  ! is_list_end ( c );
@@ -6911,6 +8048,15 @@ min::printer min::list_print
 				 " error" );
 		    break;
 		}
+
+		// A frozen object hash-list has only
+		// one name.
+		//
+		if ( frozen )
+		{
+		    c = min::LIST_END();
+		    break;
+		}
 	    }
 	}
 
@@ -7132,6 +8278,7 @@ min::printer min::list_print
 	MIN_ASSERT ( ap.length < len,
 	             "system programming error" );
 
+	bool new_hash_name = false;
 	update_refresh ( ap.locate_dlp );
 	if ( insert_reserve
 	           ( ap.locate_dlp,
@@ -7168,6 +8315,7 @@ min::printer min::list_print
 		insert_before ( ap.locate_dlp,
 		                elements, 2 );
 		next ( ap.locate_dlp );
+		new_hash_name = true;
 	    }
 
 	    ap.length = 1;
@@ -7226,6 +8374,8 @@ min::printer min::list_print
 	    ap.state = ap_type::LOCATE_ANY;
 	else
 	    ap.state = ap_type::REVERSE_LOCATE_FAIL;
+
+	if ( new_hash_name ) grow_hash ( ap );
     }
 
 # else // ! MIN_ALLOW_PARTIAL_ATTR_LABELS
@@ -7293,9 +8443,13 @@ min::printer min::list_print
 	    }
 	}
 
-	ap.index = min::hash ( name );
+	ap.index = MINT::list_hash
+	    ( obj_vec_ptr_of ( ap.locate_dlp ),
+	      min::hash ( name ) );
 	ap.flags = 0;
 	start_hash ( ap.locate_dlp, ap.index );
+	bool frozen = frozen_flag_of
+	    ( obj_vec_ptr_of ( ap.locate_dlp ) );
 
 	for ( min::gen c = current ( ap.locate_dlp );
 	      ! is_list_end ( c );
@@ -7313,6 +8467,11 @@ min::printer min::list_print
 		ap.state = ap_type::LOCATE_NONE;
 		return;
 	    }
+
+	    // A frozen object hash-list has only one
+	    // name.
+	    //
+	    if ( frozen ) break;
 	}
 
         // Name not found.
@@ -7417,10 +8576,85 @@ min::printer min::list_print
 	    ap.state = ap_type::LOCATE_ANY;
 	else
 	    ap.state = ap_type::REVERSE_LOCATE_FAIL;
+
+	if ( ! ( ap.flags & ap_type::IN_VECTOR ) )
+	    grow_hash ( ap );
     }
 
 # endif
 
+// Locate a string attribute name by walking its hash-
+// list, and on success refill the cache.
+//
+template < class vecpt >
+void MINT::locate
+	( MUP::attr_ptr_type<vecpt> & ap,
+	  min::gen name,
+	  min::attr_cache & cache )
+{
+    typedef MUP::attr_ptr_type<vecpt> ap_type;
+
+    ++ cache.misses;
+
+    ap.attr_name = name;
+    ap.reverse_attr_name = min::NONE();
+    ap.index = MINT::list_hash
+	( obj_vec_ptr_of ( ap.locate_dlp ),
+	  min::hash ( name ) );
+    ap.flags = 0;
+
+    bool frozen = frozen_flag_of
+	( obj_vec_ptr_of ( ap.locate_dlp ) );
+    unsptr pairs = 0;
+    for ( min::gen c =
+              start_hash ( ap.locate_dlp, ap.index );
+	  ! is_list_end ( c )
+	  &&
+	  ( ! frozen || pairs == 0 );
+	  next ( ap.locate_dlp ),
+	  c = next ( ap.locate_dlp ), ++ pairs )
+    {
+	if ( c == name )
+	{
+	    c = next ( ap.locate_dlp );
+	    MIN_ASSERT ( ! is_list_end ( c ),
+			 "system programming"
+			 " error" );
+	    start_copy ( ap.dlp, ap.locate_dlp );
+	    ap.state = ap_type::LOCATE_NONE;
+#	    if MIN_ALLOW_PARTIAL_ATTR_LABELS
+		ap.length = 1;
+#	    endif
+
+	    cache.name = name;
+	    cache.hash = ap.index;
+	    cache.hash_size =
+	        hash_size_of ( ap.locate_dlp );
+	    cache.pairs = pairs;
+	    return;
+	}
+    }
+
+    // Name not found.
+    //
+#   if MIN_ALLOW_PARTIAL_ATTR_LABELS
+	ap.length = 0;
+#   endif
+    ap.state = ap_type::LOCATE_FAIL;
+}
+template void MINT::locate
+	( min::attr_ptr & ap,
+	  min::gen name,
+	  min::attr_cache & cache );
+template void MINT::locate
+	( min::attr_updptr & ap,
+	  min::gen name,
+	  min::attr_cache & cache );
+template void MINT::locate
+	( min::attr_insptr & ap,
+	  min::gen name,
+	  min::attr_cache & cache );
+
 void MINT::reverse_attr_create
 	( min::attr_insptr & ap,
 	  min::gen v )
@@ -8239,39 +9473,223 @@ template min::unsptr min::reverse_attr_info_of
 	( min::reverse_attr_info * out, min::unsptr n,
 	  min::attr_insptr & ap );
 
-// Compare function to qsort attr_info packed vector.
-//
-static int compare_attr_info
-	( const void * aip1, const void * aip2 )
+// Attribute info vectors are sorted by first putting
+// their names in the order min::compare puts them:
+// numbers, then strings, then labels, then other
+// values.  Numbers and strings are then sorted on keys
+// extracted once: an order preserving uns64 for a
+// number's float64, and the first 8 bytes of a string
+// in big-endian order along with a pointer to the rest
+// of a string longer than 8 bytes.  Only labels and
+// other values are sorted by calling min::compare.
+
+min::unsptr min::parallel_sort_threshold = 100000;
+unsigned min::sort_threads = 4;
+
+namespace {
+
+    struct sort_key
+    {
+	min::uns64 key;
+	const char * rest;
+	    // Characters after the first 8 of a string
+	    // longer than 8 characters, else NULL.
+	min::unsptr index;
+	    // Index of element in the vector being sorted.
+    };
+
+    inline bool operator <
+	    ( const sort_key & k1, const sort_key & k2 )
+    {
+	if ( k1.key != k2.key ) return k1.key < k2.key;
+	else if ( k1.rest == NULL )
+	    return k2.rest != NULL;
+	else if ( k2.rest == NULL )
+	    return false;
+	else
+	    return ::strcmp ( k1.rest, k2.rest ) < 0;
+    }
+
+    // Compare the names of the elements of out with
+    // min::compare.
+    //
+    template < class info >
+    struct name_less
+    {
+	const info * out;
+	name_less ( const info * out ) : out ( out ) {}
+
+	bool operator () ( const sort_key & k1,
+	                   const sort_key & k2 ) const
+	{
+	    return min::compare ( out[k1.index].name,
+	                          out[k2.index].name )
+		   < 0;
+	}
+    };
+}
+
+static min::uns64 number_key ( min::gen g )
 {
-    min::gen name1 = ( (min::attr_info *) aip1 )->name;
-    min::gen name2 = ( (min::attr_info *) aip2 )->name;
-    return min::compare ( name1, name2 );
+    min::float64 f = min::float_of ( g );
+    min::uns64 bits;
+    memcpy ( & bits, & f, sizeof ( bits ) );
+    const min::uns64 SIGN = (min::uns64) 1 << 63;
+    return ( bits & SIGN ? ~ bits : bits | SIGN );
 }
-void min::sort_attr_info
-	( min::attr_info * out, min::unsptr n )
+
+static void string_key ( sort_key & k, min::gen g )
 {
-    qsort ( out, n, sizeof ( min::attr_info ),
-	    compare_attr_info );
+    min::str_ptr sp ( g );
+    const char * p = MUP::str_of ( sp );
+    min::unsptr length = min::strlen ( sp );
+    k.key = 0;
+    for ( unsigned i = 0; i < 8; ++ i )
+    {
+	k.key <<= 8;
+	if ( i < length ) k.key |= (min::uns8) p[i];
+    }
+
+    // A string longer than 8 characters is a LONG_STR
+    // whose body does not move during the sort.
+    //
+    k.rest = ( length > 8 ? p + 8 : NULL );
 }
 
-// Compare function to qsort reverse_attr_info packed
-// vector.
-//
-static int compare_reverse_attr_info
-	( const void * aip1, const void * aip2 )
+# if MIN_PARALLEL_SORT
+
+    struct sort_chunk
+    {
+	sort_key * begin;
+	sort_key * end;
+    };
+
+    static void * sort_thread ( void * arg )
+    {
+	sort_chunk * c = (sort_chunk *) arg;
+	std::sort ( c->begin, c->end );
+	return NULL;
+    }
+
+    // Sort keys[0..n-1] by sorting min::sort_threads
+    // chunks in parallel and then merging them.
+    //
+    static void parallel_sort
+	    ( sort_key * keys, min::unsptr n )
+    {
+	unsigned t = min::sort_threads;
+	if ( t > 64 ) t = 64;
+	sort_chunk chunks[t];
+	pthread_t threads[t];
+	for ( unsigned i = 0; i < t; ++ i )
+	{
+	    chunks[i].begin = keys + n * i / t;
+	    chunks[i].end = keys + n * ( i + 1 ) / t;
+	}
+	for ( unsigned i = 1; i < t; ++ i )
+	{
+	    if ( pthread_create
+		     ( & threads[i], NULL, sort_thread,
+		       chunks + i ) != 0 )
+		MIN_ABORT ( "could not create sort"
+			    " thread" );
+	}
+	sort_thread ( chunks + 0 );
+	for ( unsigned i = 1; i < t; ++ i )
+	    pthread_join ( threads[i], NULL );
+
+	for ( unsigned width = 1; width < t;
+	      width *= 2 )
+	for ( unsigned i = 0; i + width < t;
+	      i += 2 * width )
+	{
+	    unsigned j = i + 2 * width;
+	    if ( j > t ) j = t;
+	    std::inplace_merge
+		( chunks[i].begin,
+		  chunks[i + width].begin,
+		  chunks[j - 1].end );
+	}
+    }
+
+# endif
+
+static void sort_keys ( sort_key * keys, min::unsptr n )
+{
+#   if MIN_PARALLEL_SORT
+	if ( n >= min::parallel_sort_threshold
+	     &&
+	     min::sort_threads > 1 )
+	{
+	    parallel_sort ( keys, n );
+	    return;
+	}
+#   endif
+    std::sort ( keys, keys + n );
+}
+
+template < class info >
+static void sort_info ( info * out, min::unsptr n )
+{
+    if ( n <= 1 ) return;
+
+    // Partition into numbers, strings, labels, and
+    // other values.
+    //
+    min::unsptr count[4] = { 0, 0, 0, 0 };
+    min::uns8 * type = new min::uns8[n];
+    for ( min::unsptr i = 0; i < n; ++ i )
+    {
+	min::gen name = out[i].name;
+	type[i] = min::is_num ( name ) ? 0 :
+	          min::is_str ( name ) ? 1 :
+		  min::is_lab ( name ) ? 2 : 3;
+	++ count[type[i]];
+    }
+    min::unsptr begin[5] = { 0 };
+    for ( unsigned t = 0; t < 4; ++ t )
+	begin[t+1] = begin[t] + count[t];
+
+    sort_key * keys = new sort_key[n];
+    min::unsptr next[4] =
+	{ begin[0], begin[1], begin[2], begin[3] };
+    for ( min::unsptr i = 0; i < n; ++ i )
+    {
+	sort_key & k = keys[next[type[i]]++];
+	k.index = i;
+	k.key = 0;
+	k.rest = NULL;
+	min::gen name = out[i].name;
+	if ( type[i] == 0 )
+	    k.key = ::number_key ( name );
+	else if ( type[i] == 1 )
+	    ::string_key ( k, name );
+    }
+    delete [] type;
+
+    ::sort_keys ( keys + begin[0], count[0] );
+    ::sort_keys ( keys + begin[1], count[1] );
+    std::sort ( keys + begin[2], keys + begin[4],
+                ::name_less<info> ( out ) );
+
+    info * sorted = new info[n];
+    for ( min::unsptr i = 0; i < n; ++ i )
+	sorted[i] = out[keys[i].index];
+    memcpy ( (void *) out, sorted, n * sizeof ( info ) );
+    delete [] sorted;
+    delete [] keys;
+}
+
+void min::sort_attr_info
+	( min::attr_info * out, min::unsptr n )
 {
-    min::gen name1 =
-        ( (min::reverse_attr_info *) aip1 )->name;
-    min::gen name2 =
-        ( (min::reverse_attr_info *) aip2 )->name;
-    return min::compare ( name1, name2 );
+    ::sort_info ( out, n );
 }
+
 void min::sort_reverse_attr_info
 	( min::reverse_attr_info * out, min::unsptr n )
 {
-    qsort ( out, n, sizeof ( min::reverse_attr_info ),
-	    compare_reverse_attr_info );
+    ::sort_info ( out, n );
 }
 
 template < class vecpt >
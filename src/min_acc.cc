@@ -19,6 +19,7 @@
 //	Collector
 //	Compactor
 //	ACC Interrupt
+//	Mutator Threads
 //	Statistics
 
 // Setup
@@ -42,6 +43,11 @@ using namespace MACC;
 # include <cstdlib>
 # include <cstdio>
 # include <cctype>
+# include <ctime>
+# include <algorithm>
+# if MIN_PARALLEL_MARKERS || MIN_CONCURRENT_SWEEP
+#   include <pthread.h>
+# endif
 using std::hex;
 using std::dec;
 using std::cout;
@@ -49,6 +55,30 @@ using std::endl;
 using std::setw;
 using std::ostream;
 
+// The other mutator threads are stopped while a
+// stop_mutators_lock exists (see MINT::stop_mutators
+// in min.h).  Held by the functions that run the
+// collector or compactor or report acc statistics.
+//
+# if MIN_MUTATOR_THREADS
+    struct stop_mutators_lock
+    {
+	stop_mutators_lock ( void )
+	{
+	    while ( ! MINT::stop_mutators() );
+	}
+	~ stop_mutators_lock ( void )
+	{
+	    MINT::start_mutators();
+	}
+    };
+# else
+    struct stop_mutators_lock
+    {
+	stop_mutators_lock ( void ) {}
+    };
+# endif
+
 
 // Initializer
 // -----------
@@ -62,6 +92,8 @@ static bool trace_variable_block_allocation = false;
 // allocations.
 static bool trace_collector = false;
 #define tracec if ( trace_collector ) cout
+static bool trace_compactor = false;
+#define tracecp if ( trace_compactor ) cout
 
 // Find the number of characters in a string before
 // the first white space or end of string.
@@ -77,6 +109,7 @@ static int before_space ( const char * p )
 // number of pages, rounding up.
 //
 min::unsptr MACC::page_size;
+min::uns32 MACC::huge_pages = MIN_DEFAULT_HUGE_PAGES;
 inline min::unsptr number_of_pages
     ( min::unsptr number_of_bytes )
 {
@@ -201,6 +234,7 @@ static bool get_param
 static void stub_allocator_initializer ( void );
 static void block_allocator_initializer ( void );
 static void collector_initializer ( void );
+static void compactor_initializer ( void );
 void MINT::acc_initializer ( void )
 {
     const char * deb =
@@ -233,6 +267,9 @@ void MINT::acc_initializer ( void )
 	    case 'c':
 	        trace_collector = true;
 		break;
+	    case 'C':
+	        trace_compactor = true;
+		break;
 	    default:
 	        cout << "ERROR: cannot understand debug"
 		        " = ..." << *p << "..." << endl;
@@ -250,9 +287,16 @@ void MINT::acc_initializer ( void )
 		MACC::page_size, 1024*MACC::page_size,
 		MACC::page_size, true );
 
+    get_param ( "huge_pages",
+                MACC::huge_pages, 0, 1 );
+    if ( MOS::hugepagesize() == 0 )
+        MACC::huge_pages = 0;
+    MOS::use_huge_pages = ( MACC::huge_pages != 0 );
+
     stub_allocator_initializer();
     block_allocator_initializer();
     collector_initializer();
+    compactor_initializer();
 }
 
 
@@ -263,9 +307,45 @@ min::unsptr MACC::max_stubs =
     MIN_DEFAULT_MAX_STUBS;
 min::unsptr MACC::stub_increment =
     MIN_DEFAULT_STUB_INCREMENT;
+min::unsptr MACC::stub_buffer_size =
+    MIN_DEFAULT_STUB_BUFFER_SIZE;
+min::unsptr MACC::stub_commit_pages =
+    MIN_DEFAULT_STUB_COMMIT_PAGES;
 min::stub * MACC::stub_begin;
 min::stub * MACC::stub_next;
 min::stub * MACC::stub_end;
+min::stub * MACC::stub_commit_end;
+
+// End of the pages of the stub region.
+//
+static min::stub * stub_region_end;
+
+// Make the stub region accessible up to at least the
+// given address, which must be <= stub_region_end.
+// Pages are made accessible MACC::stub_commit_pages
+// at a time.
+//
+static void commit_stubs ( min::stub * end )
+{
+    if ( end <= MACC::stub_commit_end ) return;
+
+    min::unsptr pages =
+        number_of_pages
+	    (   (min::uns8 *) end
+	      - (min::uns8 *) MACC::stub_commit_end );
+    pages += MACC::stub_commit_pages - 1;
+    pages -= pages % MACC::stub_commit_pages;
+    min::unsptr max_pages =
+        (   (min::uns8 *) stub_region_end
+	  - (min::uns8 *) MACC::stub_commit_end )
+	/ MACC::page_size;
+    if ( pages > max_pages ) pages = max_pages;
+
+    MOS::access_pool ( pages, MACC::stub_commit_end );
+    MACC::stub_commit_end = (min::stub *)
+        (   (min::uns8 *) MACC::stub_commit_end
+	  + pages * MACC::page_size );
+}
 
 static void stub_allocator_initializer ( void )
 {
@@ -278,6 +358,10 @@ static void stub_allocator_initializer ( void )
 		MIN_MAX_NUMBER_OF_STUBS );
     get_param ( "stub_increment",
                 MACC::stub_increment, 100, 1000000 );
+    get_param ( "stub_buffer_size",
+                MACC::stub_buffer_size, 2, 1 << 20 );
+    get_param ( "stub_commit_pages",
+                MACC::stub_commit_pages, 0, 1 << 20 );
 
     MINT::str_hash_size = MIN_DEFAULT_STR_HASH_SIZE;
     get_param ( "str_hash_size",
@@ -377,6 +461,17 @@ static void stub_allocator_initializer ( void )
     MACC::stub_begin = (min::stub *) stubs;
     MACC::stub_next = MACC::stub_begin;
     MACC::stub_end = MACC::stub_begin + MACC::max_stubs;
+    stub_region_end = (min::stub *)
+        ( (min::uns8 *) stubs + pages * MACC::page_size );
+
+    if ( MACC::stub_commit_pages == 0 )
+	MACC::stub_commit_end = stub_region_end;
+    else
+    {
+	MOS::inaccess_pool ( pages, stubs );
+	MACC::stub_commit_end = MACC::stub_begin;
+	commit_stubs ( MACC::stub_begin + 1 );
+    }
 
     MUP::set_control_of
         ( MACC::stub_next,
@@ -438,6 +533,21 @@ static void stub_allocator_initializer ( void )
     while ( p < tables ) * p ++ = MINT::null_stub;
 }
 
+# if MIN_CONCURRENT_SWEEP
+// Defined in the Collector section below.
+//
+static void free_swept_stubs ( min::unsptr n );
+# endif
+
+// Value of MUP::acc_stubs_allocated when the allocation
+// budget was last renewed.
+//
+static min::uns64 budget_base = 0;
+
+// Defined in the ACC Interrupt section below.
+//
+static void set_acc_budget_limit ( void );
+
 void MINT::acc_expand_stub_free_list ( min::unsptr n )
 {
     if ( ! MINT::initialization_done )
@@ -447,7 +557,17 @@ void MINT::acc_expand_stub_free_list ( min::unsptr n )
         abort();
     }
 
+    MINT::allocator_lock lock;
+
     if ( n <= MINT::number_of_free_stubs ) return;
+
+#   if MIN_CONCURRENT_SWEEP
+	free_swept_stubs
+	    (   n - MINT::number_of_free_stubs
+	      + MACC::stub_increment );
+	if ( n <= MINT::number_of_free_stubs ) return;
+#   endif
+
     n -= MINT::number_of_free_stubs;
 
     min::unsptr max_n =
@@ -467,6 +587,7 @@ void MINT::acc_expand_stub_free_list ( min::unsptr n )
     }
     n += MACC::stub_increment;
     if ( n > max_n ) n = max_n;
+    commit_stubs ( MACC::stub_next + n );
 
     min::stub * previous =
         ( MINT::number_of_free_stubs == 0 ?
@@ -499,6 +620,177 @@ void MINT::acc_expand_stub_free_list ( min::unsptr n )
 	      ( min::ACC_FREE, MINT::null_stub ) );
 }
 
+# if MIN_MUTATOR_THREADS
+
+// Next stub on the acc list after s.
+//
+inline min::stub * next_stub ( min::stub * s )
+{
+    return MUP::stub_of_acc_control
+               ( MUP::control_of ( s ) );
+}
+
+// Number of runs taken for stub buffers by all threads.
+//
+static min::uns64 stub_buffer_serial = 0;
+
+// A free stub made the last_allocated_stub when the
+// mutator threads restart, so that the last_allocated_
+// stub is not a stub whose control a mutator thread
+// may change, or NULL if none.  The next run taken
+// for a stub buffer begins with it.  stub_sentinel_
+// previous is the stub before it on the acc list.
+//
+static min::stub * stub_sentinel = NULL;
+static min::stub * stub_sentinel_previous;
+
+min::stub * MINT::acc_refill_stub_buffer ( void )
+{
+    MINT::allocator_lock lock;
+    MINT::stub_buffer & b = MINT::acc_stub_buffer;
+    min::unsptr n = MACC::stub_buffer_size;
+    MINT::acc_reserve_stub_free_list ( n );
+
+    // Take the run first, ..., fence of length stubs,
+    // which follows previous on the acc list.
+    //
+    min::stub * previous = MINT::last_allocated_stub;
+    min::stub * fence = previous;
+    for ( min::unsptr i = 0; i < n; ++ i )
+        fence = next_stub ( fence );
+    MINT::number_of_free_stubs -= n;
+    MINT::last_allocated_stub = fence;
+
+    min::stub * first = next_stub ( previous );
+    min::unsptr length = n;
+    if ( previous == b.fence )
+    {
+	// Extend the current run.
+	//
+        first = previous;
+	++ length;
+    }
+    else if ( previous == stub_sentinel )
+    {
+        first = previous;
+	previous = stub_sentinel_previous;
+	++ length;
+	stub_sentinel = NULL;
+    }
+
+    min::stub * s;
+    if ( b.fence != NULL && first != b.fence )
+    {
+        // The old fence is no longer the last_
+	// allocated_stub, so it can be handed out.
+	//
+        s = b.fence;
+	b.next = first;
+	b.count = length - 1;
+	b.previous = previous;
+    }
+    else
+    {
+        s = first;
+	b.next = next_stub ( first );
+	b.count = length - 2;
+	b.previous = first;
+    }
+    b.fence = fence;
+    b.serial = ++ stub_buffer_serial;
+
+    MUP::acc_stubs_allocated += b.allocated + 1;
+    b.allocated = 0;
+    if (    MUP::acc_stubs_allocated
+         >= MINT::acc_budget_limit )
+	MINT::acc_stack_limit = MINT::acc_stack;
+
+    return s;
+}
+
+// Remove the n stubs after previous, the last of which
+// is last, from the acc list and put them on the free
+// list.  None of these stubs may be the last_before of
+// a generation except last.
+//
+static void free_stub_run
+	( min::stub * previous, min::stub * last,
+	  min::unsptr n )
+{
+    min::stub * s = next_stub ( previous );
+    MUP::set_control_of
+        ( previous,
+	  MUP::renew_acc_control_stub
+	      ( MUP::control_of ( previous ),
+	        next_stub ( last ) ) );
+    if ( MINT::last_allocated_stub == last )
+        MINT::last_allocated_stub = previous;
+    for ( MACC::generation * g = MACC::generations;
+          g <= MACC::end_g; ++ g )
+    {
+        if ( g->last_before == last )
+	    g->last_before = previous;
+    }
+
+    while ( n -- > 0 )
+    {
+        min::stub * next = next_stub ( s );
+	MINT::free_acc_stub ( s );
+	s = next;
+    }
+}
+
+// Return the stubs left in the stub buffers of all
+// mutator threads, and the stub sentinel, to the free
+// list, and add the stubs handed out to MUP::acc_
+// stubs_allocated.  Runs are returned newest first,
+// as the previous stub of a run may be the fence of
+// an older run.  The mutator threads must be stopped.
+//
+static void flush_stub_buffers ( void )
+{
+    for ( MINT::mutator_context * c =
+              MINT::mutator_contexts;
+	  c != NULL; c = c->next )
+    {
+	MINT::stub_buffer & b = * c->acc_stub_buffer;
+	MUP::acc_stubs_allocated += b.allocated;
+	b.allocated = 0;
+    }
+
+    while ( true )
+    {
+	MINT::stub_buffer * bp = NULL;
+	for ( MINT::mutator_context * c =
+		  MINT::mutator_contexts;
+	      c != NULL; c = c->next )
+	{
+	    MINT::stub_buffer * b = c->acc_stub_buffer;
+	    if ( b->fence != NULL
+	         &&
+		 ( bp == NULL
+		   ||
+		   b->serial > bp->serial ) )
+		bp = b;
+	}
+	if ( bp == NULL ) break;
+
+	free_stub_run
+	    ( bp->previous, bp->fence, bp->count + 1 );
+	bp->next = bp->fence = bp->previous = NULL;
+	bp->count = 0;
+    }
+
+    if ( stub_sentinel != NULL )
+    {
+	free_stub_run
+	    ( stub_sentinel_previous, stub_sentinel, 1 );
+	stub_sentinel = NULL;
+    }
+}
+
+# endif // MIN_MUTATOR_THREADS
+
 
 // Block Allocator
 // ----- ---------
@@ -514,6 +806,8 @@ min::unsptr MACC::max_paged_body_size;
 min::unsptr MACC::paged_body_region_size;
 min::unsptr MACC::stub_stack_region_size;
 min::unsptr MACC::stub_stack_segment_size;
+min::unsptr MACC::remap_pages =
+    MIN_DEFAULT_REMAP_PAGES;
 
 void * MACC::deallocated_body;
 
@@ -619,6 +913,8 @@ static void block_allocator_initializer ( void )
 		1024 * MACC::stub_stack_segment_size,
 		MACC::page_size );
 
+    get_param ( "remap_pages", MACC::remap_pages );
+
     // Allocate MACC::deallocated_body.
     //
     {
@@ -837,6 +1133,67 @@ static void allocate_new_superregion ( void )
     MACC::insert ( MACC::last_superregion, r );
 }
 
+// Allocate a new subregion from a superregion, allo-
+// cating a new superregion if necessary.  The block
+// control word of the subregion is set; the rest of
+// the subregion MACC::region struct must be set by the
+// caller.
+//
+static MACC::region * allocate_subregion ( void )
+{
+    MACC::region * r;
+    MACC::region * sr = MACC::current_superregion;
+
+    if ( sr == NULL
+	 ||
+	 sr->free_count > 0
+	 ||
+	 sr->next < sr->end )
+	; // do nothing
+    else for ( sr = MACC::last_superregion; ; )
+    {
+	sr = sr->region_next;
+	if ( sr->free_count > 0
+	     ||
+	     sr->next < sr->end )
+	    break;
+	else if ( sr == MACC::last_superregion )
+	{
+	    sr = NULL;
+	    break;
+	}
+    }
+
+    if ( sr == NULL )
+    {
+	allocate_new_superregion();
+	sr = MACC::current_superregion
+	   = MACC::last_superregion;
+    }
+
+    if ( sr->free_count > 0 )
+    {
+	MINT::free_fixed_size_block * b =
+	    sr->last_free->next;
+	r = (MACC::region *) b;
+	sr->last_free->next = b->next;
+	if ( -- sr->free_count == 0 )
+	    sr->last_free = NULL;
+    }
+    else
+    {
+	MIN_REQUIRE ( sr->next < sr->end );
+	r = (MACC::region *) sr->next;
+	sr->next += MACC::subregion_size;
+    }
+
+    r->block_control =
+	MUP::new_control_with_locator
+	    ( sr - MACC::region_table,
+	      MINT::null_stub );
+    return r;
+}
+
 void MINT::new_fixed_body
     ( min::stub * s, min::unsptr n,
       MINT::fixed_block_list * fbl )
@@ -869,58 +1226,11 @@ void MINT::new_fixed_body
 	// block size has any free blocks.  Must
 	// allocate a new subregion.
 
-	MACC::region * sr = MACC::current_superregion;
-
-	if ( sr == NULL
-	     ||
-	     sr->free_count > 0
-	     ||
-	     sr->next < sr->end )
-	    ; // do nothing
-	else for ( sr = MACC::last_superregion; ; )
-	{
-	    sr = sr->region_next;
-	    if ( sr->free_count > 0
-		 ||
-		 sr->next < sr->end )
-		break;
-	    else if ( sr == MACC::last_superregion )
-	    {
-	        sr = NULL;
-		break;
-	    }
-	}
-
-	if ( sr == NULL )
-	{
-	    allocate_new_superregion();
-	    sr = MACC::current_superregion
-	       = MACC::last_superregion;
-	}
-
-	if ( sr->free_count > 0 )
-	{
-	    MINT::free_fixed_size_block * b =
-	        sr->last_free->next;
-	    r = (MACC::region *) b;
-	    sr->last_free->next = b->next;
-	    if ( -- sr->free_count == 0 )
-	        sr->last_free = NULL;
-	}
-	else
-	{
-	    MIN_REQUIRE ( sr->next < sr->end );
-	    r = (MACC::region *) sr->next;
-	    sr->next += MACC::subregion_size;
-	}
+	r = allocate_subregion();
 
 	// Fill in region struct at beginning of new
 	// region.
 
-	r->block_control =
-	    MUP::new_control_with_locator
-	        ( sr - MACC::region_table,
-		  MINT::null_stub );
 	r->block_subcontrol =
 	    MUP::new_control_with_type
 	        ( MACC::FIXED_SIZE_BLOCK_REGION,
@@ -981,60 +1291,38 @@ void MINT::new_fixed_body
     }
     else
     {
-	// Add up to 16 pages worth of bodies to the
-	// fbl free list.
+	// Make the never used blocks that begin in the
+	// page containing r->next into the fbl run.
+	// Their control words are written when they
+	// are allocated.
 	//
-    	min::unsptr count = 16 * MACC::page_size
-	                  / fbl->size;
-	if ( count == 0 ) count = 1;
-	MINT::free_fixed_size_block * first = NULL;
-	MIN_REQUIRE ( fbl->last_free == NULL );
-	while ( count -- > 0 )
-	{
-	    if ( r->next + fbl->size > r->end )
-	    {
-		MIN_REQUIRE ( r->next == r->end );
-		break;
-	    }
-
-	    MINT::free_fixed_size_block * b =
-	        (MINT::free_fixed_size_block *) r->next;
-	    int locator = - (int)
-	        (   ( r->next - (min::uns8 *) r )
-		  / MACC::page_size );
-	    b->block_control =
-	        MUP::new_control_with_locator
-		    ( locator, MINT::null_stub );
-
-	    if ( first == NULL )
-	        first = b;
-	    else
-	        fbl->last_free->next = b;
-	    fbl->last_free = b;
-
-	    r->next += fbl->size;
-	    ++ fbl->count;
-	    ++ r->max_free_count;
-	}
-	MIN_REQUIRE ( fbl->last_free != NULL );
-	fbl->last_free->next = first;
+	min::unsptr offset = r->next - (min::uns8 *) r;
+	min::unsptr page_end =
+	    ( offset / MACC::page_size + 1 )
+	    * MACC::page_size;
+	min::unsptr count =
+	    ( page_end - offset + fbl->size - 1 )
+	    / fbl->size;
+	min::unsptr max_count =
+	    ( r->end - r->next ) / fbl->size;
+	if ( count > max_count ) count = max_count;
+	MIN_REQUIRE ( count > 0 );
+
+	MINT::fixed_block_run * run =
+	      MINT::fixed_block_runs
+	    + ( fbl - MINT::fixed_block_lists );
+	run->locator =
+	    - (int) ( offset / MACC::page_size );
+	run->next = r->next;
+	r->next += count * fbl->size;
+	run->end = r->next;
+	r->max_free_count += count;
     }
 
-    MIN_REQUIRE ( fbl->count > 0 );
-
-    // Allocate first block from refurbished fbl free
-    // list.
+    // Allocate from the refurbished fbl free list or
+    // the new run.
     //
-    MINT::free_fixed_size_block * b =
-        fbl->last_free->next;
-    fbl->last_free->next = b->next;
-    if ( -- fbl->count == 0 )
-        fbl->last_free = NULL;
-
-    b->block_control = MUP::renew_control_stub
-        ( b->block_control, s );
-    MUP::set_ptr_of ( s, & b->block_control + 1 );
-    MUP::set_flags_of ( s, ACC_FIXED_BODY_FLAG );
+    MUP::new_body ( s, n );
 }
 
 // Call this when we are out of paged body regions.
@@ -1133,6 +1421,8 @@ inline void * new_mono_body
 void MINT::new_non_fixed_body
     ( min::stub * s, min::unsptr n )
 {
+    MINT::allocator_lock lock;
+
     // Add space for body control and round up to
     // multiple of MACC::page_size.
     //
@@ -1149,11 +1439,110 @@ void MINT::new_non_fixed_body
     MUP::set_ptr_of ( s, body );
 }
 
+// Put the fixed size block whose block control word is
+// pointed at by bp on the free list of its region r.
+//
+inline void free_fixed_block
+    ( MACC::region * r, min::uns64 * bp )
+{
+    MINT::free_fixed_size_block * p =
+	(MINT::free_fixed_size_block *) bp;
+    if ( r->last_free == NULL )
+	r->last_free = p->next = p;
+    else
+    {
+	p->next = r->last_free->next;
+	r->last_free->next = p;
+	r->last_free = p;
+    }
+    ++ r->free_count;
+}
+
+// Return the never used blocks of the run of fbl to
+// their region.  The blocks are put on the region free
+// list unless the run is the last part of the region
+// to be used.
+//
+static void return_fixed_block_run
+	( MINT::fixed_block_list * fbl,
+	  MINT::fixed_block_run * run )
+{
+    if ( run->next == run->end ) return;
+
+    min::uns64 * bp = (min::uns64 *) run->next;
+    * bp = MUP::new_control_with_locator
+               ( run->locator, MINT::null_stub );
+    MACC::region * r = MACC::region_of_body ( bp );
+    if ( r->next == run->end )
+    {
+	r->max_free_count -=
+	    ( run->end - run->next ) / fbl->size;
+	r->next = run->next;
+    }
+    else for ( min::uns8 * p = run->next;
+               p < run->end; p += fbl->size )
+    {
+	bp = (min::uns64 *) p;
+	* bp = MUP::new_control_with_locator
+		   ( run->locator, MINT::null_stub );
+	free_fixed_block ( r, bp );
+    }
+    run->next = run->end = NULL;
+}
+
+// Return the runs of the thread whose fixed_block_runs
+// are given.
+//
+static void return_fixed_block_runs
+	( MINT::fixed_block_run * runs )
+{
+    for ( unsigned j = 0;
+          j < MINT::number_fixed_block_lists; ++ j )
+	return_fixed_block_run
+	    ( MINT::fixed_block_lists + j, runs + j );
+}
+
+// Return the number of blocks in the runs of fbl.
+//
+static min::unsptr run_blocks
+	( MINT::fixed_block_list * fbl )
+{
+    unsigned j = fbl - MINT::fixed_block_lists;
+    min::unsptr bytes = 0;
+#   if MIN_MUTATOR_THREADS
+	for ( MINT::mutator_context * c =
+		  MINT::mutator_contexts;
+	      c != NULL; c = c->next )
+	    bytes +=   c->fixed_block_runs[j].end
+	             - c->fixed_block_runs[j].next;
+#   else
+	bytes +=   MINT::fixed_block_runs[j].end
+	         - MINT::fixed_block_runs[j].next;
+#   endif
+    return bytes / fbl->size;
+}
+
+void MACC::return_fixed_block_runs ( void )
+{
+#   if MIN_MUTATOR_THREADS
+	for ( MINT::mutator_context * c =
+		  MINT::mutator_contexts;
+	      c != NULL; c = c->next )
+	    ::return_fixed_block_runs
+	        ( c->fixed_block_runs );
+#   else
+	::return_fixed_block_runs
+	    ( MINT::fixed_block_runs );
+#   endif
+}
+
 void MUP::deallocate_body
     ( min::stub * s, min::unsptr n )
 {
     if ( n == 0 ) return;
 
+    MINT::allocator_lock lock;
+
     min::uns64 * bp =
         (min::uns64 *) MUP::ptr_of ( s ) - 1;
     MACC::region * r = MACC::region_of_body ( bp );
@@ -1162,17 +1551,7 @@ void MUP::deallocate_body
     int type = MACC::type_of ( r );
     if ( type == MACC::FIXED_SIZE_BLOCK_REGION )
     {
-	MINT::free_fixed_size_block * p =
-	    (MINT::free_fixed_size_block *) bp;
-	if ( r->last_free == NULL )
-	    r->last_free = p->next = p;
-	else
-	{
-	    p->next = r->last_free->next;
-	    r->last_free->next = p;
-	    r->last_free = p;
-	}
-	++ r->free_count;
+	free_fixed_block ( r, bp );
 	MUP::clear_flags_of
 	    ( s, MINT::ACC_FIXED_BODY_FLAG );
     }
@@ -1226,6 +1605,177 @@ void MUP::move_body ( min::stub * s1, min::stub * s2 )
     MUP::set_ptr_of ( s2, MACC::deallocated_body );
 }
 
+// Defined in the Compactor section below.
+//
+static bool compacting_region ( MACC::region * r );
+
+bool MUP::resize_body_in_place
+    ( min::stub * s, min::unsptr new_size,
+                     min::unsptr old_size )
+{
+    if ( old_size == 0 ) return false;
+
+    MINT::allocator_lock lock;
+
+    min::uns8 * bp =
+        (min::uns8 *) MUP::ptr_of ( s ) - 8;
+    MACC::region * r =
+        MACC::region_of_body ( (min::uns64 *) bp );
+
+    int type = MACC::type_of ( r );
+    if ( type == MACC::FIXED_SIZE_BLOCK_REGION )
+        return new_size + 8 <= r->block_size;
+    else if ( type == MACC::MONO_BODY_REGION )
+        return bp + new_size + 8 <= r->end;
+    else if ( type != MACC::VARIABLE_SIZE_BLOCK_REGION
+              &&
+              type != MACC::PAGED_BODY_REGION )
+        return false;
+
+    min::unsptr old_n =
+        ( old_size + 8 + r->round_mask )
+	& ~ r->round_mask;
+    min::unsptr new_n =
+        ( new_size + 8 + r->round_mask )
+	& ~ r->round_mask;
+    if ( new_n == old_n ) return true;
+
+    // Only the last block of a region may change
+    // size, by moving r->next.
+    //
+    if ( bp + old_n != r->next
+         ||
+	 bp + new_n > r->end
+	 ||
+	 compacting_region ( r ) )
+        return false;
+
+    r->next = bp + new_n;
+    return true;
+}
+
+void MUP::move_body_contents
+    ( void * to, void * from, min::unsptr n )
+{
+    min::uns8 * tp = (min::uns8 *) to - 8;
+    min::uns8 * fp = (min::uns8 *) from - 8;
+    min::unsptr os_page_size = MOS::pagesize();
+    min::unsptr pages = ( n + 8 ) / os_page_size;
+
+    if ( MACC::remap_pages == 0
+         ||
+	 pages < MACC::remap_pages
+         ||
+            ( ( (min::unsptr) tp | (min::unsptr) fp )
+	      & ( os_page_size - 1 ) )
+	 != 0 )
+    {
+        memcpy ( to, from, n );
+	return;
+    }
+
+    // Both blocks begin on a page boundary.  Remap the
+    // whole pages, restore the block control words,
+    // which are at the beginnings of the first pages,
+    // and copy the rest.
+    //
+    min::uns64 tc = * (min::uns64 *) tp;
+    min::uns64 fc = * (min::uns64 *) fp;
+    MOS::move_pool ( pages, tp, fp );
+    * (min::uns64 *) tp = tc;
+    * (min::uns64 *) fp = fc;
+
+    min::unsptr moved = pages * os_page_size - 8;
+    memcpy ( (min::uns8 *) to + moved,
+             (min::uns8 *) from + moved, n - moved );
+}
+
+// Call this when there is no variable body region or
+// the last variable body region is too full to hold
+// a body being evacuated.
+//
+static void allocate_new_variable_body_region ( void )
+{
+    MACC::region * r = allocate_subregion();
+
+    r->block_subcontrol =
+	MUP::new_control_with_type
+	    ( MACC::VARIABLE_SIZE_BLOCK_REGION,
+	      MACC::subregion_size );
+    r->begin = r->next =
+	(min::uns8 *) r + sizeof ( MACC::region );
+    r->end = (min::uns8 *) r + MACC::subregion_size;
+    r->round_size = 8;
+    r->round_mask = 7;
+    r->block_size = MINT::max_fixed_block_size;
+    r->free_size = 0;
+    r->free_count = 0;
+    r->max_free_count = 0;
+    r->last_free = NULL;
+
+    if ( MOS::trace_pools >= 1 )
+	cout << "TRACE: allocating new subregion"
+		" for variable size blocks" << endl;
+
+    r->region_previous = r->region_next = r;
+    MACC::insert ( MACC::last_variable_body_region, r );
+}
+
+// If the body of stub s is in a fixed size block, move
+// it to the end of the last variable body region and
+// put the fixed size block on its region's free list.
+// Return true if the body was moved, and false if it
+// was not in a fixed size block or its size is not
+// known (see MUP::body_size_of).
+//
+// This is called when s is promoted to level 0, so
+// that long lived bodies do not waste the padding of
+// fixed size blocks, and so that fixed size block
+// regions, which then hold only younger bodies, are
+// more likely to become empty and be returned to
+// their superregions.
+//
+static bool evacuate_fixed_body ( min::stub * s )
+{
+    if (    ( MUP::control_of ( s )
+	      & MINT::ACC_FIXED_BODY_FLAG )
+	 == 0 )
+	return false;
+
+    min::unsptr n = MUP::body_size_of ( s );
+    if ( n == 0 ) return false;
+
+    min::uns64 * bp =
+	(min::uns64 *) MUP::ptr_of ( s ) - 1;
+    MACC::region * fr = MACC::region_of_body ( bp );
+    MIN_REQUIRE (    MACC::type_of ( fr )
+		  == MACC::FIXED_SIZE_BLOCK_REGION );
+
+    min::unsptr m = ( n + 8 + 7 ) & ~ 7;
+    MACC::region * r = MACC::last_variable_body_region;
+    if ( r == NULL || r->next + m > r->end )
+    {
+	allocate_new_variable_body_region();
+	r = MACC::last_variable_body_region;
+	MIN_REQUIRE ( r->next + m <= r->end );
+    }
+
+    min::uns64 * b = (min::uns64 *) r->next;
+    r->next += m;
+
+    int locator = - (int)
+	(   ( (min::uns8 *) b - (min::uns8 *) r )
+	  / MACC::page_size );
+    * b = MUP::new_control_with_locator ( locator, s );
+    memcpy ( b + 1, bp + 1, n );
+
+    free_fixed_block ( fr, bp );
+    MUP::set_ptr_of ( s, b + 1 );
+    MUP::clear_flags_of
+	( s, MINT::ACC_FIXED_BODY_FLAG );
+    return true;
+}
+
 
 // Packed Type Allocator
 // ------ ---- ---------
@@ -1513,9 +2063,14 @@ void MACC::stub_stack::flush ( void )
 
     if ( output == output_segment->begin )
     {
+	// If output_segment is the first segment,
+	// nothing is kept.  Note that the previous
+	// segment of the first segment is the last
+	// segment.
+	//
 	if ( output_segment
 	     ==
-	     output_segment->previous_segment )
+	     last_segment->next_segment )
 	    output_segment = NULL;
 	else
 	{
@@ -1590,9 +2145,17 @@ void MACC::stub_stack::flush ( void )
 //
 min::uns64 MACC::scan_limit;
 min::uns64 MACC::scavenge_limit;
+unsigned MACC::scavenge_prefetch;
 min::uns64 MACC::collection_limit;
+min::unsptr MACC::hash_max_load;
+min::unsptr MACC::rehash_limit;
 min::uns32 MACC::collector_period;
 min::uns32 MACC::collector_period_increments;
+min::uns32 MACC::pause_target;
+min::uns64 MACC::allocation_budget;
+min::uns32 MACC::marker_threads = 0;
+min::uns64 MACC::marker_limit;
+min::uns32 MACC::sweep_thread = 0;
 
 // ACC Level Data:
 //
@@ -1624,39 +2187,77 @@ MACC::level * MACC::levels = levels_vector;
 //
 min::unsptr  MACC::acc_stack_max_size;
 min::unsptr  MACC::acc_stack_trigger;
-min::stub ** MACC::acc_stack_begin;
-min::stub ** MACC::acc_stack_end;
+min::unsptr  MACC::acc_stack_rescan;
+MIN_THREAD_LOCAL min::stub ** MACC::acc_stack_begin;
+MIN_THREAD_LOCAL min::stub ** MACC::acc_stack_end;
 min::uns64   MACC::acc_stack_scavenge_mask = 0;
 min::uns64   MACC::removal_request_flags = 0;
 
-// Called from acc_initializer.
+// Allocate an acc stack for the current thread and
+// set MACC::acc_stack_{begin,end} and MINT::acc_stack
+// {,_limit}.
 //
-static void collector_initializer ( void )
+static void new_acc_stack ( void )
 {
-    get_param ( "ephemeral_levels",
-                MACC::ephemeral_levels,
-		0, MIN_MAX_EPHEMERAL_LEVELS );
-
-    MACC::generation * g = MACC::generations;
-
-    g->level = & levels[0];
-    g->last_before = MINT::head_stub;
-    g->count = 0;
-    g->lock = -1;
-
-    levels[0].g = g ++;
-    levels[0].number_of_sublevels = 1;
-    levels[0].collector_phase = COLLECTOR_NOT_RUNNING;
-    levels[0].root_lock = -1;
-    memset ( & levels[0].count, 0,
-             sizeof ( levels[0].count ) );
-    memset ( & levels[0].count, 0,
-             sizeof ( levels[0].count ) );
-
-    char name[80];
-
-    MINT::new_acc_stub_flags = 0;
-    for ( unsigned i = 1;
+    min::unsptr np =
+        number_of_pages ( MACC::acc_stack_max_size );
+    MACC::acc_stack_begin = (min::stub **)
+        MOS::new_pool ( np + 1 );
+    const char * error =
+        MOS::pool_error ( MACC::acc_stack_begin );
+    if ( error != NULL )
+    {
+        cout << "ERROR: " << error << endl
+	     << "       while allocating " << np
+	     << "page acc stack."
+	     << endl
+	     << "       Suggest decreasing"
+	        " acc_stack_size."
+	     << endl;
+	MOS::dump_error_info ( cout );
+	exit ( 1 );
+    }
+    MACC::acc_stack_end = (min::stub **)
+        (   (min::uns8 *) MACC::acc_stack_begin
+	  + ( np - 1 ) * MACC::page_size );
+    MOS::inaccess_pool ( 1, MACC::acc_stack_end );
+        // Allocate an inaccessible page after the
+	// acc stack to catch overflows.
+
+    MINT::acc_stack = MACC::acc_stack_begin;
+    MINT::acc_stack_limit =
+            MINT::acc_stack
+	  + 2 * MACC::acc_stack_trigger;
+}
+
+// Called from acc_initializer.
+//
+static void collector_initializer ( void )
+{
+    get_param ( "ephemeral_levels",
+                MACC::ephemeral_levels,
+		0, MIN_MAX_EPHEMERAL_LEVELS );
+
+    MACC::generation * g = MACC::generations;
+
+    g->level = & levels[0];
+    g->last_before = MINT::head_stub;
+    g->count = 0;
+    g->lock = -1;
+
+    levels[0].g = g ++;
+    levels[0].number_of_sublevels = 1;
+    levels[0].collector_phase = COLLECTOR_NOT_RUNNING;
+    levels[0].root_lock = -1;
+    memset ( & levels[0].count, 0,
+             sizeof ( levels[0].count ) );
+    memset ( & levels[0].count, 0,
+             sizeof ( levels[0].count ) );
+
+    char name[80];
+
+    MINT::new_acc_stub_flags = 0;
+    for ( unsigned i = 1;
           i <= MACC::ephemeral_levels; ++ i )
     {
 	MINT::new_acc_stub_flags |= COLLECTIBLE ( i );
@@ -1713,35 +2314,19 @@ static void collector_initializer ( void )
                 MACC::acc_stack_trigger,
 		1, 1 << 20 );
 
-    min::unsptr np =
-        number_of_pages ( MACC::acc_stack_max_size );
-    MACC::acc_stack_begin = (min::stub **)
-        MOS::new_pool ( np + 1 );
-    const char * error =
-        MOS::pool_error ( MACC::acc_stack_begin );
-    if ( error != NULL )
-    {
-        cout << "ERROR: " << error << endl
-	     << "       while allocating " << np
-	     << "page acc stack."
-	     << endl
-	     << "       Suggest decreasing"
-	        " acc_stack_size."
-	     << endl;
-	MOS::dump_error_info ( cout );
-	exit ( 1 );
-    }
-    MACC::acc_stack_end = (min::stub **)
-        (   (min::uns8 *) MACC::acc_stack_begin
-	  + ( np - 1 ) * MACC::page_size );
-    MOS::inaccess_pool ( 1, MACC::acc_stack_end );
-        // Allocate an inaccessible page after the
-	// acc stack to catch overflows.
-
-    MINT::acc_stack = MACC::acc_stack_begin;
-    MINT::acc_stack_limit =
-            MINT::acc_stack
-	  + 2 * MACC::acc_stack_trigger;
+    MACC::acc_stack_rescan =
+        MIN_DEFAULT_ACC_STACK_RESCAN;
+    get_param ( "acc_stack_rescan",
+                MACC::acc_stack_rescan,
+		0, 1 << 20 );
+
+    new_acc_stack();
+#   if MIN_MUTATOR_THREADS
+	MINT::mutator_contexts->acc_stack_begin =
+	    MACC::acc_stack_begin;
+	MINT::mutator_contexts->acc_stack_end =
+	    MACC::acc_stack_end;
+#   endif
 
     MACC::scan_limit = MIN_DEFAULT_ACC_SCAN_LIMIT;
     get_param ( "scan_limit",
@@ -1754,12 +2339,28 @@ static void collector_initializer ( void )
                 MACC::scavenge_limit,
 		10, 1 << 30 );
 
+    MACC::scavenge_prefetch =
+        MIN_DEFAULT_ACC_SCAVENGE_PREFETCH;
+    get_param ( "scavenge_prefetch",
+                MACC::scavenge_prefetch,
+		0, 64 );
+
     MACC::collection_limit =
         MIN_DEFAULT_ACC_COLLECTION_LIMIT;
     get_param ( "collection_limit",
                 MACC::collection_limit,
 		10, 1 << 30 );
 
+    MACC::hash_max_load = MIN_DEFAULT_HASH_MAX_LOAD;
+    get_param ( "hash_max_load",
+                MACC::hash_max_load,
+		0, 1 << 10 );
+
+    MACC::rehash_limit = MIN_DEFAULT_REHASH_LIMIT;
+    get_param ( "rehash_limit",
+                MACC::rehash_limit,
+		1, 1 << 30 );
+
     MACC::collector_period =
         MIN_DEFAULT_COLLECTOR_PERIOD;
     get_param ( "collector_period",
@@ -1771,12 +2372,112 @@ static void collector_initializer ( void )
     get_param ( "collector_period_increments",
                 MACC::collector_period_increments,
 		0, 1000000  );
+
+    MACC::pause_target = MIN_DEFAULT_ACC_PAUSE_TARGET;
+    get_param ( "pause_target",
+                MACC::pause_target,
+		0, 1000000  );
+
+    MACC::allocation_budget =
+        MIN_DEFAULT_ACC_ALLOCATION_BUDGET;
+    get_param ( "allocation_budget",
+                MACC::allocation_budget,
+		1, 1ull << 40  );
+    set_acc_budget_limit();
+
+#   if MIN_PARALLEL_MARKERS
+	MACC::marker_threads =
+	    MIN_DEFAULT_MARKER_THREADS;
+	get_param ( "marker_threads",
+		    MACC::marker_threads,
+		    0, MIN_MAX_MARKER_THREADS );
+#   endif
+
+    MACC::marker_limit = MIN_DEFAULT_MARKER_LIMIT;
+    get_param ( "marker_limit",
+                MACC::marker_limit,
+		10, 1 << 30 );
+
+#   if MIN_CONCURRENT_SWEEP
+	MACC::sweep_thread =
+	    MIN_DEFAULT_SWEEP_THREAD;
+	get_param ( "sweep_thread",
+		    MACC::sweep_thread, 0, 1 );
+#   endif
+}
+
+// An acc stack pair.
+//
+struct acc_pair
+{
+    min::stub * s1;
+    min::stub * s2;
+
+    bool operator < ( const acc_pair & p ) const
+    {
+        return s1 < p.s1
+	       ||
+	       ( s1 == p.s1 && s2 < p.s2 );
+    }
+};
+
+// If s1 is scavenged and scavengable and level L
+// pairs with an unmarked s2 would be processed, turn
+// off the level L scavenged flag of s1 and put s1 on
+// the level L to-be-scavenged list, for each such L.
+// Then no more pairs with s1 are pushed for level L
+// until s1 is scavenged again, and pairs already in
+// the acc stack do not mark their s2, as the new
+// scavenging of s1 will do this.  A level whose
+// scavenger is part way through s1 is skipped.
+// Return the new control of s1.
+//
+static min::uns64 rescan_acc_stub
+	( min::stub * s1, min::uns64 c1 )
+{
+    if ( ! MINT::is_scavengable
+               ( MUP::type_of_control ( c1 ) ) )
+        return c1;
+
+    min::uns64 f1 = ( c1 >> MINT::ACC_FLAG_PAIRS )
+		  & min::internal::acc_stack_mask;
+    unsigned mark =
+        (unsigned) ( f1 >> ( M - 1 ) ) >> ( E + 1 );
+    while ( mark != 0 )
+    {
+	unsigned level = MINT::log2floor ( mark );
+	mark ^= 1 << level;
+	MINT::scavenge_control & sc =
+	    MINT::scavenge_controls[level];
+	if ( sc.state != 0 && sc.s1 == s1 )
+	    continue;
+	c1 &= ~ SCAVENGED ( level );
+	levels[level].to_be_scavenged.push ( s1 );
+    }
+    return c1;
 }
 
 min::unsptr MACC::process_acc_stack
     ( min::stub ** acc_lower )
 {
+    min::unsptr pairs =
+        ( MINT::acc_stack - MACC::acc_stack_begin ) / 2;
+    if ( pairs > MACC::acc_stack_high_water )
+        MACC::acc_stack_high_water = pairs;
+
+    // Sort the pairs so that duplicates and the pairs
+    // of each s1 are adjacent.
+    //
+    acc_pair * begin = (acc_pair *) acc_lower;
+    acc_pair * end = (acc_pair *) MINT::acc_stack;
+    if ( MACC::acc_stack_rescan != 0
+         &&
+	 end - begin > 1 )
+	std::sort ( begin, end );
+
     min::unsptr count = 0;
+    min::stub * last_s1 = NULL;
+    min::stub * last_s2 = NULL;
     while ( MINT::acc_stack > acc_lower )
     {
         ++ count;
@@ -1786,6 +2487,50 @@ min::unsptr MACC::process_acc_stack
         min::stub * s2 = * -- MINT::acc_stack;
         min::stub * s1 = * -- MINT::acc_stack;
 
+	if ( MACC::acc_stack_rescan != 0 )
+	{
+	    if ( s1 == last_s1 && s2 == last_s2 )
+	    {
+		++ MACC::acc_stack_duplicates;
+		continue;
+	    }
+
+	    if ( s1 != last_s1 )
+	    {
+		// Count the pairs of s1, which are
+		// adjacent below this pair.
+		//
+		min::stub ** p = MINT::acc_stack;
+		min::unsptr n = 1;
+		while ( p > acc_lower
+		        &&
+			p[-2] == s1
+			&&
+			n < MACC::acc_stack_rescan )
+		{
+		    p -= 2;
+		    ++ n;
+		}
+		if ( n >= MACC::acc_stack_rescan )
+		{
+		    uns64 c = MUP::control_of ( s1 );
+		    if ( ( c & MACC::removal_request_flags )
+		         == 0 )
+		    {
+			uns64 rc = rescan_acc_stub ( s1, c );
+			if ( rc != c )
+			{
+			    MUP::set_control_of ( s1, rc );
+			    ++ MACC::acc_stack_rescans;
+			}
+		    }
+		}
+	    }
+
+	    last_s1 = s1;
+	    last_s2 = s2;
+	}
+
 	uns64 c1 = MUP::control_of ( s1 );
 	uns64 c2 = MUP::control_of ( s2 );
 	if ( c1 & MACC::removal_request_flags )
@@ -1854,349 +2599,1344 @@ min::unsptr MACC::process_acc_stack
 		}
 	    }
 	}
-	MUP::set_flags_of ( s1, c1 );
-	MUP::set_flags_of ( s2, c2 );
+	// Flags may have been cleared as well as set,
+	// so the controls are replaced.
+	//
+	MUP::set_control_of ( s1, c1 );
+	MUP::set_control_of ( s2, c2 );
     }
 
     return count;
 }
 
-unsigned MACC::collector_increment ( unsigned level )
+// Hash Table Resizing
+//
+// The string, number, and label hash tables are
+// described by the following, which points at the
+// MINT::xxx_... hash table variables.  Table ids
+// used by INITING_HASH and COLLECTING_HASH are
+// 2 * k for the xxx_acc_hash table of hash_tables[k]
+// and 2 * k + 1 for its xxx_acc_hash_old table.
+//
+struct hash_table_info
 {
-    if (   MACC::process_acc_stack()
-         > 2 * MACC::acc_stack_trigger )
-        return level;
+    const char * name;
+    min::stub *** acc_hash;
+    min::stub *** aux_hash;
+    min::unsptr * size;
+    min::unsptr * mask;
+    min::unsptr * count;
+    min::stub *** acc_hash_old;
+    min::stub *** aux_hash_old;
+    min::unsptr * old_size;
+    min::unsptr * rehashed;
+
+    min::uns32 ( * hash ) ( min::stub * s );
+        // Returns the hash of a stub in the table.
+
+    min::unsptr pages;
+    min::unsptr old_pages;
+        // Number of pages in the pool holding the
+	// xxx_acc_hash and xxx_aux_hash tables, or in
+	// the pool holding the old tables.  0 if the
+	// tables are in the pool allocated by stub_
+	// allocator_initializer, which is never freed.
+
+#   if MIN_FLAT_HASH_INDEX
+	MINT::hash_index * index;
+	    // Hash index of the table stubs, from which
+	    // collected stubs must be removed.
+#   endif
+};
 
-    int result = level;
+static min::uns32 str_stub_hash ( min::stub * s )
+{
+    if ( MUP::type_of ( s ) == min::SHORT_STR )
+	return min::strnhash ( s->v.c8, 8 );
+    else
+	return MUP::hash_of ( MUP::long_str_of ( s ) );
+}
 
-    MACC::level & lev = levels[level];
+static min::uns32 lab_stub_hash ( min::stub * s )
+{
+    return min::labhash ( s );
+}
 
-    switch ( lev.collector_phase )
+# if MIN_IS_COMPACT
+    static min::uns32 num_stub_hash ( min::stub * s )
     {
+	return min::floathash ( MUP::float_of ( s ) );
+    }
+# endif
 
-    case COLLECTOR_NOT_RUNNING:
-        break;
+static hash_table_info hash_tables[] =
+{
+    { "string",
+      & MINT::str_acc_hash, & MINT::str_aux_hash,
+      & MINT::str_hash_size, & MINT::str_hash_mask,
+      & MINT::str_hash_count,
+      & MINT::str_acc_hash_old,
+      & MINT::str_aux_hash_old,
+      & MINT::str_hash_old_size,
+      & MINT::str_hash_rehashed,
+      str_stub_hash, 0, 0
+#   if MIN_FLAT_HASH_INDEX
+	, & MINT::str_hash_index
+#   endif
+    },
+    { "label",
+      & MINT::lab_acc_hash, & MINT::lab_aux_hash,
+      & MINT::lab_hash_size, & MINT::lab_hash_mask,
+      & MINT::lab_hash_count,
+      & MINT::lab_acc_hash_old,
+      & MINT::lab_aux_hash_old,
+      & MINT::lab_hash_old_size,
+      & MINT::lab_hash_rehashed,
+      lab_stub_hash, 0, 0
+#   if MIN_FLAT_HASH_INDEX
+	, & MINT::lab_hash_index
+#   endif
+    },
+#   if MIN_IS_COMPACT
+	{ "number",
+	  & MINT::num_acc_hash, & MINT::num_aux_hash,
+	  & MINT::num_hash_size, & MINT::num_hash_mask,
+	  & MINT::num_hash_count,
+	  & MINT::num_acc_hash_old,
+	  & MINT::num_aux_hash_old,
+	  & MINT::num_hash_old_size,
+	  & MINT::num_hash_rehashed,
+	  num_stub_hash, 0, 0
+#	if MIN_FLAT_HASH_INDEX
+	    , & MINT::num_hash_index
+#	endif
+	},
+#   endif
+};
+const unsigned number_of_hash_tables =
+    sizeof ( hash_tables ) / sizeof ( hash_table_info );
+
+// Set table and size to the acc hash table with the
+// given table id (see above).  If there is no such
+// table because no resize is in progress, set table
+// to NULL and size to 0.  Return false if the table
+// id is beyond the last table id.
+//
+static bool acc_hash_table
+	( unsigned id,
+	  min::stub ** & table, min::uns32 & size )
+{
+    if ( id >= 2 * number_of_hash_tables )
+        return false;
+    hash_table_info & ht = hash_tables[id/2];
+    if ( id % 2 == 0 )
+    {
+        table = * ht.acc_hash;
+	size = (min::uns32) * ht.size;
+    }
+    else if ( * ht.acc_hash_old != NULL )
+    {
+        table = * ht.acc_hash_old;
+	size = (min::uns32) * ht.old_size;
+    }
+    else
+    {
+        table = NULL;
+	size = 0;
+    }
+    return true;
+}
 
-    case COLLECTOR_START:
-    	{
-	    tracec << "START COLLECTOR level "
-	           << level << " generation counts:"
-		   << endl
-		   << print_generations() << endl;
+// Return true if the entry with the given index of the
+// acc hash table with the given table id has not been
+// initialized.  This is the case for new tables of a
+// resize in progress for entries with old table
+// indices that have not yet been rehashed.
+//
+inline bool acc_hash_entry_uninitialized
+	( unsigned id, min::unsptr index )
+{
+    hash_table_info & ht = hash_tables[id/2];
+    return id % 2 == 0
+           &&
+	   * ht.acc_hash_old != NULL
+	   &&
+	      ( index & ( * ht.old_size - 1 ) )
+	   >= * ht.rehashed;
+}
 
-	    // Check that to-be-scavenged stack is
-	    // empty.
-	    //
-	    lev.to_be_scavenged.rewind();
-	    MIN_REQUIRE
-	        ( lev.to_be_scavenged.at_end() );
+// Start a resize of a hash table, allocating new acc
+// and aux tables of twice the size.  The entries of
+// the new tables are not initialized until the
+// corresponding old table lists are rehashed.
+//
+static void start_resize ( hash_table_info & ht )
+{
+    min::unsptr new_size = 2 * * ht.size;
+    min::unsptr pages = number_of_pages
+        ( 2 * sizeof ( void * ) * new_size );
+    min::stub ** tables =
+        (min::stub **) MOS::new_pool ( pages );
+    const char * error = MOS::pool_error ( tables );
+    if ( error != NULL )
+    {
+        cout << "ERROR: " << error << endl
+	     << "       while allocating " << pages
+	     << " pages for resized " << ht.name
+	     << " hash tables"
+	     << endl
+	     << "       Suggest increasing"
+	        " hash_max_load."
+	     << endl;
+	MOS::dump_error_info ( cout );
+	exit ( 1 );
+    }
 
-	    // Check that flags are properly cleared.
-	    //
-	    MIN_REQUIRE
-	        (    (   MINT::acc_stack_mask
-	               & UNMARKED ( level ) )
-		  == 0 );
-	    MIN_REQUIRE
-	        (    (   MACC::acc_stack_scavenge_mask
-	               & SCAVENGED ( level ) )
-		  == 0 );
-	    MIN_REQUIRE
-	        (    (   MACC::removal_request_flags
-	               & UNMARKED ( level ) )
-		  == 0 );
-	    MIN_REQUIRE
-	        (    (   MINT::hash_acc_clear_flags
-	               & UNMARKED ( level ) )
-		  == 0 );
-	    MIN_REQUIRE
-	        (    (   MINT::new_acc_stub_flags
-	               & UNMARKED ( level ) )
-		  == 0 );
+    tracec << "RESIZING " << ht.name
+           << " HASH TABLES FROM " << * ht.size
+	   << " TO " << new_size << " ENTRIES"
+	   << endl;
+
+    * ht.acc_hash_old = * ht.acc_hash;
+    * ht.aux_hash_old = * ht.aux_hash;
+    * ht.old_size = * ht.size;
+    * ht.rehashed = 0;
+    ht.old_pages = ht.pages;
+
+    * ht.acc_hash = tables;
+    * ht.aux_hash = tables + new_size;
+    * ht.size = new_size;
+    * ht.mask = new_size - 1;
+    ht.pages = pages;
+}
 
-	    // Execute this phase.
-	    //
-	    MINT::new_acc_stub_flags |=
-	        UNMARKED ( level );
-	    lev.saved_count = lev.count;
+// Rehash up to limit lists of the old tables of a
+// resize in progress.  Return the number of lists
+// rehashed.
+//
+static min::unsptr rehash
+	( hash_table_info & ht, min::unsptr limit )
+{
+    min::stub ** acc_old = * ht.acc_hash_old;
+    min::stub ** aux_old = * ht.aux_hash_old;
+    min::stub ** acc_new = * ht.acc_hash;
+    min::stub ** aux_new = * ht.aux_hash;
+    min::unsptr old_size = * ht.old_size;
+    min::unsptr mask = * ht.mask;
 
-	    lev.collector_phase =
-		START_INITING_COLLECTIBLE;
+    min::unsptr count = 0;
+    while ( count < limit
+            &&
+	    * ht.rehashed < old_size )
+    {
+        min::unsptr i = * ht.rehashed;
+	acc_new[i] = acc_new[i + old_size] =
+	    MINT::null_stub;
+	aux_new[i] = aux_new[i + old_size] =
+	    MINT::null_stub;
+
+	min::stub * s = acc_old[i];
+	while ( s != MINT::null_stub )
+	{
+	    min::uns64 c = MUP::control_of ( s );
+	    min::stub * next_s =
+	        MUP::stub_of_acc_control ( c );
+	    min::unsptr h = ht.hash ( s ) & mask;
+	    c = MUP::renew_acc_control_stub
+	            ( c, acc_new[h] );
+	    MUP::set_control_of ( s, c );
+	    acc_new[h] = s;
+	    s = next_s;
 	}
-	MIN_FALLTHROUGH
 
-    case START_INITING_COLLECTIBLE:
+	s = aux_old[i];
+	while ( s != MINT::null_stub )
 	{
-	    if ( lev.g->lock >= 0 ) return lev.g->lock;
-	    lev.g->lock = level;
-	    lev.first_g = lev.last_g = lev.g;
-	    lev.last_stub = lev.g->last_before;
-	    lev.collector_phase =
-		LOCK_INITING_COLLECTIBLE;
-        }
-	MIN_FALLTHROUGH
+	    min::uns64 c = MUP::control_of ( s );
+	    min::stub * next_s =
+	        MUP::stub_of_control ( c );
+	    min::unsptr h =
+	          ht.hash
+	            ( (min::stub *) MUP::ptr_of ( s ) )
+		& mask;
+	    c = MUP::renew_control_stub
+	            ( c, aux_new[h] );
+	    MUP::set_control_of ( s, c );
+	    aux_new[h] = s;
+	    s = next_s;
+	}
 
-    case LOCK_INITING_COLLECTIBLE:
-	{
-	    // Establish the condition where
-	    // lev.first_g + 1 == lev.last_g and both
-	    // lev.first_g and lev.last_g are locked.
-	    //
-	    // lev.last_stub is the last stub scanned
-	    // (or the stub before the first stub
-	    // scanned).
-	    //
+	acc_old[i] = aux_old[i] = MINT::null_stub;
+	++ * ht.rehashed;
+	++ count;
+    }
 
-	    MIN_REQUIRE
-	        ( lev.first_g == lev.last_g );
-	    MIN_REQUIRE
-	        ( lev.first_g->lock == (int) level );
+    if ( * ht.rehashed == old_size )
+    {
+	tracec << "FINISHED RESIZING " << ht.name
+	       << " HASH TABLES" << endl;
+
+	if ( ht.old_pages != 0 )
+	    MOS::free_pool ( ht.old_pages, acc_old );
+	* ht.acc_hash_old = NULL;
+	* ht.aux_hash_old = NULL;
+	* ht.old_size = 0;
+	* ht.rehashed = 0;
+	ht.old_pages = 0;
+    }
 
-	    if ( lev.last_g[1].lock >= 0 )
-	        return lev.last_g[1].lock;
+    return count;
+}
 
-	    lev.last_g[1].lock = level;
-	    ++ lev.last_g;
+// Start hash table resizes that are needed and perform
+// up to MACC::rehash_limit rehashes of resizes in
+// progress.  Does nothing while the level 0 INITING_
+// HASH or COLLECTING_HASH phases have the first
+// generation of level 1 locked.
+//
+static void hash_table_increment ( void )
+{
+    if ( MACC::levels[0].g[1].lock >= 0 ) return;
 
-	    lev.collector_phase = INITING_COLLECTIBLE;
+    min::unsptr limit = MACC::rehash_limit;
+    for ( unsigned k = 0; k < number_of_hash_tables;
+                          ++ k )
+    {
+        hash_table_info & ht = hash_tables[k];
+	if ( * ht.acc_hash_old == NULL )
+	{
+	    if ( MACC::hash_max_load == 0
+	         ||
+		    * ht.count
+		 <= MACC::hash_max_load * * ht.size
+		 ||
+		 * ht.size >= ( 1 << 30 ) )
+	        continue;
+	    start_resize ( ht );
 	}
-	MIN_FALLTHROUGH
+	limit -= rehash ( ht, limit );
+	if ( limit == 0 ) break;
+    }
+}
 
-    case INITING_COLLECTIBLE:
-        {
-	    // Set the flags of lev.first_g.
-	    //
-	    MIN_REQUIRE
-	        ( lev.first_g + 1 == lev.last_g );
-	    MIN_REQUIRE
-	        ( lev.first_g->lock == (int) level );
-	    MIN_REQUIRE
-	        ( lev.last_g->lock == (int) level );
+// Scavenger Prefetching
+//
+// Scavenging a stub usually misses the cache on the
+// stub and then again on its body.  Before a stub is
+// taken from a to-be-scavenged list, the stub MACC::
+// scavenge_prefetch elements further along is pre-
+// fetched, and so is the body of the stub half that
+// far along, whose control and pointer should by then
+// be in the cache.  Prefetches are only hints, so
+// stale or non-body pointers are harmless.
+
+inline void prefetch_body ( min::stub * s )
+{
+    int type = MUP::type_of ( s );
+    if ( type >= 0
+         &&
+	 MINT::scavenger_routines[type] != NULL )
+	__builtin_prefetch ( MUP::ptr_of ( s ) );
+}
 
-	    end_g->last_before =
-		MINT::last_allocated_stub;
+inline void prefetch_to_be_scavenged
+	( MACC::stub_stack & ss )
+{
+    unsigned d = MACC::scavenge_prefetch;
+    if ( d == 0 ) return;
 
-	    min::uns64 scanned = 0;
-	    min::uns64 c =
-		MUP::control_of ( lev.last_stub );
+    min::stub * s = ss.lookahead ( d );
+    if ( s != NULL ) __builtin_prefetch ( s, 1 );
+    s = ss.lookahead ( d / 2 );
+    if ( s != NULL ) prefetch_body ( s );
+}
 
-	    while ( scanned < MACC::scan_limit )
-	    {
-		if (    lev.last_stub
-		     != lev.last_g->last_before )
-		{
-		    min::stub * s =
-			MUP::stub_of_acc_control ( c );
-		    c = MUP::control_of ( s );
-		    c |= UNMARKED ( level );
-		    c &= ~ SCAVENGED ( level );
-		    MUP::set_control_of ( s, c );
-		    lev.last_stub = s;
-		    ++ scanned;
-		    continue;
-		}
+# if MIN_PARALLEL_MARKERS
 
-		lev.first_g->lock = -1;
-		lev.first_g = lev.last_g;
+// Parallel Markers
+//
+// A SCAVENGING_ROOT or SCAVENGING_THREAD increment of a
+// level 0 collection hands its to-be-scavenged stack
+// to the marker threads, which scavenge it together
+// with the collector thread while the mutator waits.
+// As the mutator does not run, the acc stack, which
+// was processed at the start of the increment, needs
+// no further attention.
+//
+// Each marker scavenges stubs from a private stack
+// into that stack.  When its private stack is empty,
+// a marker takes a batch of stubs from the shared
+// to-be-scavenged stack, and when other markers are
+// idle, a busy marker returns part of its private
+// stack to the shared stack for them to take.  All
+// operations on the shared stack are done under
+// marker_mutex.
+//
+// Several markers may find the same unmarked stub at
+// the same time, so scavenger routines claim a stub
+// by atomically turning off its UNMARKED flag, and
+// only the marker that succeeds pushes the stub (see
+// MINT::scavenge_claim in min.h).
 
-		if ( lev.last_g == end_g )
-		{
-		    lev.last_g->lock = -1;
+struct marker
+{
+    MINT::scavenge_control sc;
+        // Private copy of MINT::scavenge_controls[0].
+    min::stub ** begin, ** next, ** end;
+        // Private to-be-scavenged stack.
+    min::uns64 scavenged;
+        // Number of stubs scavenged this increment.
+};
+
+// Size of a private stack, and maximum number of stubs
+// taken from the shared stack at one time.
+//
+static const min::unsptr MARKER_STACK_SIZE = 4096;
+static const min::unsptr MARKER_BATCH = 64;
+
+static marker markers[1 + MIN_MAX_MARKER_THREADS];
+    // markers[0] is run by the collector thread.
+static unsigned markers_started = 0;
+
+static pthread_mutex_t marker_mutex =
+    PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t marker_start =
+    PTHREAD_COND_INITIALIZER;
+static pthread_cond_t marker_finish =
+    PTHREAD_COND_INITIALIZER;
+static pthread_cond_t marker_work =
+    PTHREAD_COND_INITIALIZER;
+    // Broadcast when stubs are returned to the shared
+    // stack or a marker finishes.
+
+// The following are protected by marker_mutex.
+//
+static min::uns64 marker_round = 0;
+    // Incremented to start the markers.
+static unsigned markers_running;
+    // Number of marker threads that have not finished
+    // the current round.
+static unsigned markers_busy;
+    // Number of markers scavenging their private
+    // stacks.
+static min::uns64 marker_budget;
+    // Number of stubs that may still be scavenged.
+static MACC::stub_stack * marker_stack;
+    // The shared to-be-scavenged stack.
+
+// Set when the round starts and read without locking.
+//
+static min::uns64 marker_remove;
+static volatile unsigned markers_waiting;
 
-		    // Start next phase.
-		    //
-		    if ( level == 0 )
-			lev.collector_phase =
-			    START_INITING_HASH;
-		    else
-			lev.collector_phase =
-			    START_INITING_ROOT;
-		    break;
-		}
-		else if ( lev.last_g[1].lock >= 0 )
-		{
-		    lev.collector_phase =
-			LOCK_INITING_COLLECTIBLE;
-		    result = lev.last_g[1].lock;
-		    break;
-		}
-		else
-		{
-		    lev.last_g[1].lock = level;
-		    ++ lev.last_g;
-		}
-	    }
+// Move stubs from the top of m's private stack to the
+// shared stack until at most `keep' are left.
+//
+static void marker_share ( marker & m, min::unsptr keep )
+{
+    pthread_mutex_lock ( & marker_mutex );
+    while ( m.next > m.begin + keep )
+	marker_stack->push ( * -- m.next );
+    pthread_cond_broadcast ( & marker_work );
+    pthread_mutex_unlock ( & marker_mutex );
+}
 
-	    lev.count.collectible_inited += scanned;
+// Scavenge up to limit stubs from m's private stack.
+// Return the number scavenged.
+//
+static min::uns64 marker_scavenge
+	( marker & m, min::uns64 limit )
+{
+    MINT::scavenge_control & sc = m.sc;
+    min::uns64 scavenged = 0;
+    while ( m.next > m.begin && scavenged < limit )
+    {
+	if ( markers_waiting > 0
+	     &&
+	     m.next - m.begin > 1 )
+	    marker_share ( m, ( m.next - m.begin ) / 2 );
+
+	// The private stack is popped from its top, so
+	// prefetch below the top (see Scavenger Pre-
+	// fetching).
+	//
+	unsigned d = MACC::scavenge_prefetch;
+	if ( d != 0 && m.next - m.begin > d )
+	{
+	    __builtin_prefetch ( * ( m.next - 1 - d ), 1 );
+	    prefetch_body ( * ( m.next - 1 - d / 2 ) );
 	}
-        break;
 
-    case START_INITING_HASH:
+	sc.s1 = * -- m.next;
+	min::uns64 c = MUP::control_of ( sc.s1 );
+	if ( c & marker_remove ) continue;
+	__atomic_fetch_or
+	    ( & sc.s1->c.u64, SCAVENGED ( 0 ),
+	      __ATOMIC_RELAXED );
+
+	int type = MUP::type_of_control ( c );
+	MINT::scavenger_routine scav =
+	    MINT::scavenger_routines[type];
+	if ( scav == NULL )
 	{
-	    lev.hash_table_id = 0;
-	    lev.hash_table_index = 0;
-	    lev.hash_stub = MINT::null_stub;
-	    lev.collector_phase = LOCK_INITING_HASH;
+	    MIN_REQUIRE ( type == min::DEALLOCATED );
+	    continue;
 	}
-	MIN_FALLTHROUGH
 
-    case LOCK_INITING_HASH:
+	sc.state = 0;
+	while ( true )
 	{
-	    if ( lev.g[1].lock >= 0 )
-		return lev.g[1].lock;
-	    lev.g[1].lock = level;
-	    lev.collector_phase = INITING_HASH;
+	    sc.to_be_scavenged = m.next;
+	    sc.to_be_scavenged_limit = m.end;
+	    (* scav) ( sc );
+	    m.next = sc.to_be_scavenged;
+	    if ( sc.state == 0 ) break;
+
+	    // Private stack is full.
+	    //
+	    if ( sc.state == sc.RESTART )
+		sc.state = 0;
+	    marker_share ( m, 0 );
 	}
-	MIN_FALLTHROUGH
-	    
-    case INITING_HASH:
-        {
-	    MIN_REQUIRE ( level == 0 );
-	    MIN_REQUIRE
-	        ( lev.g[1].lock == (int) level );
+	++ scavenged;
+    }
+    return scavenged;
+}
 
-	    min::uns64 scanned = 0;
-	    min::stub * s = lev.last_stub;
+// Run marker m for the current round.  Called and
+// returns with marker_mutex locked.
+//
+static void marker_run ( marker & m )
+{
+    m.sc = MINT::scavenge_controls[0];
+    m.sc.gen_count = 0;
+    m.sc.stub_count = 0;
+    m.sc.gen_limit = 0xFFFFFFFF;
+    m.scavenged = 0;
 
-	    min::stub ** hash_table = NULL;
-	    min::uns32 hash_table_size;
-	    while ( scanned < MACC::scan_limit )
-	    {
-	        if ( s != MINT::null_stub )
-		{
-		    min::uns64 c =
-		        MUP::control_of ( s );
-		    c |= UNMARKED ( level );
-		    c &= ~ SCAVENGED ( level );
-		    MUP::set_control_of ( s, c );
-		    s = MUP::stub_of_acc_control ( c );
-		    ++ scanned;
-		    continue;
-		}
+    while ( true )
+    {
+	while (   (min::unsptr) ( m.next - m.begin )
+	        < MARKER_BATCH
+	        &&
+		! marker_stack->at_end() )
+	{
+	    * m.next ++ = marker_stack->current();
+	    marker_stack->remove();
+	}
 
-	        if ( hash_table == NULL )
-		{
-		    switch ( lev.hash_table_id )
-		    {
-		    case 0:
-			hash_table =
-			    MINT::str_acc_hash;
-			hash_table_size =
-			    MINT::str_hash_size;
-			break;
-		    case 1:
-			hash_table =
-			    MINT::lab_acc_hash;
-			hash_table_size =
-			    MINT::lab_hash_size;
-			break;
-    #		    if MIN_IS_COMPACT
-			case 2:
-			    hash_table =
-				MINT::num_acc_hash;
-			    hash_table_size =
-				MINT::num_hash_size;
-			    break;
-    #		    endif
-		    }
+	if ( m.next > m.begin && marker_budget > 0 )
+	{
+	    min::uns64 grant = MARKER_BATCH;
+	    if ( grant > marker_budget )
+		grant = marker_budget;
+	    marker_budget -= grant;
+	    ++ markers_busy;
+	    pthread_mutex_unlock ( & marker_mutex );
+
+	    min::uns64 scavenged =
+		marker_scavenge ( m, grant );
+
+	    pthread_mutex_lock ( & marker_mutex );
+	    -- markers_busy;
+	    marker_budget += grant - scavenged;
+	    m.scavenged += scavenged;
+	    continue;
+	}
 
-		    if ( hash_table == NULL )
-		    {
-			lev.g[1].lock = -1;
-			lev.collector_phase =
-			    START_INITING_ROOT;
-			break;
-		    }
-		}
+	// Return stubs left by an exhausted budget.
+	//
+	while ( m.next > m.begin )
+	    marker_stack->push ( * -- m.next );
 
-		if (    lev.hash_table_index
-		     >= hash_table_size )
-		{
-		    ++ lev.hash_table_id;
-		    lev.hash_table_index = 0;
-		    hash_table = NULL;
-		    continue;
-		}
+	if ( marker_budget == 0 || markers_busy == 0 )
+	    break;
 
-		s = hash_table [lev.hash_table_index++];
-	    }
+	++ markers_waiting;
+	pthread_cond_wait
+	    ( & marker_work, & marker_mutex );
+	-- markers_waiting;
+    }
 
-	    lev.hash_stub = s;
-	    lev.count.acc_hash_inited += scanned;
-	}
-	break;
+    pthread_cond_broadcast ( & marker_work );
+}
 
-    case START_INITING_ROOT:
-    case LOCK_INITING_ROOT:
-        {
-	    if ( lev.root_lock >= 0 )
-		return lev.root_lock;
-	    lev.root_lock = level;
-	    lev.root.rewind();
-	    lev.collector_phase = INITING_ROOT;
-	}
-	MIN_FALLTHROUGH
+static void * marker_thread ( void * p )
+{
+    marker & m = * (marker *) p;
+    min::uns64 round = 0;
 
-    case INITING_ROOT:
-	{
-	    MIN_REQUIRE
-	        ( lev.root_lock == (int) level );
+    pthread_mutex_lock ( & marker_mutex );
+    while ( true )
+    {
+	while ( round == marker_round )
+	    pthread_cond_wait
+		( & marker_start, & marker_mutex );
+	round = marker_round;
 
-	    min::uns64 scanned = 0;
+	marker_run ( m );
 
-	    while ( ! lev.root.at_end()
-	            &&
-		    scanned < MACC::scan_limit )
-	    {
-	        min::stub * s = lev.root.current();
-		lev.root.next();
-		++ scanned;
-		MUP::clear_flags_of
-		    ( s, SCAVENGED ( level ) );
-	    }
+	if ( -- markers_running == 0 )
+	    pthread_cond_signal ( & marker_finish );
+    }
+    return NULL;
+}
 
-	    lev.count.root_inited += scanned;
+static void allocate_marker_stack ( marker & m )
+{
+    m.begin = m.next =
+	new min::stub * [MARKER_STACK_SIZE];
+    m.end = m.begin + MARKER_STACK_SIZE;
+}
 
-	    if ( lev.root.at_end() )
-	    {
-		if ( trace_collector )
-		{
-		    cout << "END COLLECTOR INITING"
-		            " level " << level
-		         << " collectible "
-		         << lev.count
-			       .collectible_inited
-		          - lev.saved_count
-		               .collectible_inited;
-		    if ( level == 0 )
-		        cout << " acc hash "
-		             << lev.count
-			           .acc_hash_inited
-		              - lev.saved_count
-			           .acc_hash_inited;
-		    else
-		        cout << " root "
-		             << lev.count.root_inited
-		              - lev.saved_count
-			           .root_inited;
-		    cout << endl;
-		}
-		lev.collector_phase =
-		    START_SCAVENGING_ROOT;
-	    }
+// Scavenge the level 0 to-be-scavenged stack with the
+// marker threads, starting the threads if necessary.
+// The gen and stub counts of the markers are added to
+// sc, and the number of stubs scavenged is returned.
+//
+static min::uns64 parallel_scavenge
+	( MACC::level & lev,
+	  MINT::scavenge_control & sc )
+{
+    if ( markers_started == 0 )
+	allocate_marker_stack ( markers[0] );
+    while ( markers_started < MACC::marker_threads )
+    {
+	marker & m = markers[++ markers_started];
+	allocate_marker_stack ( m );
+	pthread_t thread;
+	if ( pthread_create
+		 ( & thread, NULL, marker_thread,
+		   & m ) != 0 )
+	{
+	    cout << "ERROR: could not create marker"
+		    " thread" << endl;
+	    exit ( 1 );
 	}
-	break;
+	pthread_detach ( thread );
+    }
 
-    case START_SCAVENGING_ROOT:
-        {
-	    MINT::acc_stack_mask |=
-		UNMARKED ( level );
-	    MACC::acc_stack_scavenge_mask |=
-		SCAVENGED ( level );
+    pthread_mutex_lock ( & marker_mutex );
+    marker_stack = & lev.to_be_scavenged;
+    marker_budget = MACC::marker_limit;
+    marker_remove = MACC::removal_request_flags;
+    markers_busy = 0;
+    markers_running = markers_started;
+    ++ marker_round;
+    pthread_cond_broadcast ( & marker_start );
 
-	    MINT::scavenge_control & sc =
-		MINT::scavenge_controls[level];
-	    sc.state = 0;
+    marker_run ( markers[0] );
+
+    while ( markers_running > 0 )
+	pthread_cond_wait
+	    ( & marker_finish, & marker_mutex );
+    pthread_mutex_unlock ( & marker_mutex );
+
+    min::uns64 scavenged = 0;
+    for ( unsigned i = 0; i <= markers_started; ++ i )
+    {
+	marker & m = markers[i];
+	MIN_REQUIRE ( m.next == m.begin );
+	sc.gen_count += m.sc.gen_count;
+	sc.stub_count += m.sc.stub_count;
+	scavenged += m.scavenged;
+    }
+    return scavenged;
+}
+
+# endif // MIN_PARALLEL_MARKERS
+
+// Deallocate the body of collected stub s of the given
+// type, first calling the release function of its
+// packed structure type, if any.
+//
+static void deallocate_collected_body
+	( min::stub * s, int type )
+{
+    if ( type == min::PACKED_STRUCT )
+    {
+	MINT::packed_struct_descriptor * psd =
+	    (MINT::packed_struct_descriptor *)
+	    (*MINT::packed_subtypes)
+	        [MUP::packed_subtype_of ( s )];
+	if ( psd->release != NULL )
+	    ( * psd->release ) ( s );
+    }
+
+    min::unsptr size = MUP::body_size_of ( s );
+    if ( size != 0 )
+	MUP::deallocate_body ( s, size );
+}
+
+# if MIN_CONCURRENT_SWEEP
+
+// Concurrent Sweep
+//
+// When MACC::sweep_thread is 1, a COLLECTING increment
+// hands the unscanned part of the first locked gener-
+// ation, the stubs after lev.last_stub up to and in-
+// cluding lev.first_g[1].last_before, to the sweeper
+// thread and returns.  The sweeper reads the controls
+// of these stubs while the mutator runs, counting the
+// marked stubs and recording each unmarked stub and
+// its predecessor in sweep_candidates.
+//
+// The sweeper only reads.  Stubs in locked generations
+// are not removed from the acc list except by the
+// level holding the locks, which waits for the
+// sweeper, and the mutator only changes their flags.
+// The last stub of the range is not followed, as its
+// successor may be changed by stub allocation.
+//
+// Later increments check each candidate again, as a
+// hash table lookup may have cleared its UNMARKED
+// flag, and then remove it from the acc list and its
+// aux hash table and put it on the swept list.  Swept
+// stubs keep their bodies until they are freed in
+// batches by MINT::acc_expand_stub_free_list, or when
+// MACC::collect returns.
+
+struct sweep_candidate
+{
+    min::stub * previous;
+        // Stub before s on the acc list when s was
+	// scanned.
+    min::stub * s;
+};
+
+static const min::unsptr SWEEP_BUFFER_SIZE = 4096;
+static sweep_candidate sweep_candidates
+			   [SWEEP_BUFFER_SIZE];
+
+static bool sweeper_started = false;
+
+static pthread_mutex_t sweep_mutex =
+    PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sweep_start =
+    PTHREAD_COND_INITIALIZER;
+static pthread_cond_t sweep_finish =
+    PTHREAD_COND_INITIALIZER;
+
+// The following are protected by sweep_mutex.
+//
+static min::uns64 sweep_round = 0;
+    // Incremented to start the sweeper.
+static bool sweep_finished;
+
+// Set before the sweeper starts and read by it without
+// locking.
+//
+static min::stub * sweep_first;
+    // Stub before the first stub to be scanned.
+static min::stub * sweep_first_next;
+    // First stub to be scanned.
+static min::stub * sweep_end;
+    // Last stub to be scanned.
+static min::uns64 sweep_unmarked;
+    // UNMARKED ( level ) of the sweeping level.
+
+// Set by the sweeper before it finishes.
+//
+static min::stub * sweep_last;
+    // Last stub scanned.
+static min::unsptr sweep_count;
+    // Number of sweep_candidates.
+static min::uns64 sweep_kept;
+static min::uns64 sweep_aux_hash_kept;
+
+// Used only by the mutator.
+//
+static MACC::level * sweep_lev = NULL;
+    // Level whose COLLECTING phase owns the sweeper,
+    // or NULL if the sweeper has no job.
+static min::unsptr sweep_next;
+    // Index of the next sweep_candidate to process.
+static min::stub * sweep_removed;
+static min::stub * sweep_removed_previous;
+    // Last candidate processed and its predecessor on
+    // the acc list when it was removed, or NULL if
+    // the last candidate processed was kept.
+static bool sweep_waits = false;
+    // True if increments wait for the sweeper to
+    // finish, as they do within MACC::collect.
+
+// Swept list of stubs removed from the acc list but
+// not yet freed, linked through their controls in the
+// order they were removed.
+//
+static min::stub * first_swept = NULL;
+static min::stub * last_swept;
+
+static void sweep_scan ( void )
+{
+    min::stub * last = sweep_first;
+    min::stub * s = sweep_first_next;
+    sweep_count = 0;
+    sweep_kept = 0;
+    sweep_aux_hash_kept = 0;
+    while ( last != sweep_end
+            &&
+	    sweep_count < SWEEP_BUFFER_SIZE )
+    {
+	min::uns64 c =
+	    __atomic_load_n
+	        ( & s->c.u64, __ATOMIC_RELAXED );
+	if ( c & sweep_unmarked )
+	{
+	    sweep_candidate & sc =
+	        sweep_candidates[sweep_count ++];
+	    sc.previous = last;
+	    sc.s = s;
+	}
+	else if ( MINT::is_name_type
+	              ( MUP::type_of_control ( c ) ) )
+	    ++ sweep_aux_hash_kept;
+	else
+	    ++ sweep_kept;
+	last = s;
+	s = MUP::stub_of_acc_control ( c );
+    }
+    sweep_last = last;
+}
+
+static void * sweeper ( void * p )
+{
+    min::uns64 round = 0;
+
+    pthread_mutex_lock ( & sweep_mutex );
+    while ( true )
+    {
+	while ( round == sweep_round )
+	    pthread_cond_wait
+		( & sweep_start, & sweep_mutex );
+	round = sweep_round;
+	pthread_mutex_unlock ( & sweep_mutex );
+
+	sweep_scan();
+
+	pthread_mutex_lock ( & sweep_mutex );
+	sweep_finished = true;
+	pthread_cond_signal ( & sweep_finish );
+    }
+    return NULL;
+}
+
+// Start the sweeper on the unscanned part of lev.
+// first_g, starting the sweeper thread if necessary.
+//
+static void start_sweep
+	( MACC::level & lev, unsigned level )
+{
+    if ( ! sweeper_started )
+    {
+	pthread_t thread;
+	if ( pthread_create
+		 ( & thread, NULL, sweeper, NULL )
+	     != 0 )
+	{
+	    cout << "ERROR: could not create sweeper"
+		    " thread" << endl;
+	    exit ( 1 );
+	}
+	pthread_detach ( thread );
+	sweeper_started = true;
+    }
+
+    sweep_lev = & lev;
+    sweep_next = 0;
+    sweep_removed = NULL;
+
+    sweep_first = lev.last_stub;
+    sweep_first_next =
+        MUP::stub_of_acc_control
+	    ( MUP::control_of ( lev.last_stub ) );
+    sweep_end = lev.first_g[1].last_before;
+    sweep_unmarked = UNMARKED ( level );
+
+    pthread_mutex_lock ( & sweep_mutex );
+    sweep_finished = false;
+    ++ sweep_round;
+    pthread_cond_signal ( & sweep_start );
+    pthread_mutex_unlock ( & sweep_mutex );
+}
+
+// Put s, which has control c, at the end of the swept
+// list.
+//
+static void push_swept ( min::stub * s, min::uns64 c )
+{
+    MUP::set_control_of
+        ( s, MUP::renew_acc_control_stub
+		 ( c, MINT::null_stub ) );
+    if ( first_swept == NULL )
+	first_swept = s;
+    else
+	MUP::set_control_of
+	    ( last_swept,
+	      MUP::renew_acc_control_stub
+		  ( MUP::control_of ( last_swept ),
+		    s ) );
+    last_swept = s;
+}
+
+// Sweep lev.first_g for the COLLECTING phase of the
+// given level, processing at most MACC::collection_
+// limit sweep_candidates.  Return true if all stubs of
+// lev.first_g have been swept, and false if the incre-
+// ment should end, either because the sweeper is
+// running or because the limit was reached.
+//
+static bool sweep_generation
+	( MACC::level & lev, unsigned level )
+{
+    if ( sweep_lev == NULL )
+    {
+	if (    lev.last_stub
+	     == lev.first_g[1].last_before )
+	    return true;
+	start_sweep ( lev, level );
+	return false;
+    }
+
+    pthread_mutex_lock ( & sweep_mutex );
+    while ( sweep_waits && ! sweep_finished )
+	pthread_cond_wait
+	    ( & sweep_finish, & sweep_mutex );
+    bool finished = sweep_finished;
+    pthread_mutex_unlock ( & sweep_mutex );
+    if ( ! finished ) return false;
+
+    for ( min::uns64 processed = 0;
+          sweep_next < sweep_count
+	  &&
+	  processed < MACC::collection_limit;
+	  ++ processed )
+    {
+	sweep_candidate & sc =
+	    sweep_candidates[sweep_next ++];
+	min::stub * s = sc.s;
+	min::stub * previous = sc.previous;
+	if ( previous == sweep_removed )
+	    previous = sweep_removed_previous;
+
+	min::uns64 c = MUP::control_of ( s );
+	int type = MUP::type_of_control ( c );
+	if ( ( c & UNMARKED ( level ) ) == 0
+	     ||
+	     type == min::ACC_FREE
+	     ||
+	     type == min::FILLING
+	     ||
+	     s == MINT::last_allocated_stub )
+	{
+	    // See COLLECTING.
+	    //
+	    sweep_removed = NULL;
+	    if ( MINT::is_name_type ( type ) )
+		++ lev.count.aux_hash_kept;
+	    else
+		++ lev.count.kept;
+	    continue;
+	}
+
+	if ( s == lev.first_g[1].last_before )
+	{
+	    MACC::generation * g = lev.first_g + 1;
+	    do g->last_before = previous;
+	    while ( g ++ != lev.last_g );
+	}
+
+	MUP::set_control_of
+	    ( previous,
+	      MUP::renew_acc_control_stub
+		  ( MUP::control_of ( previous ),
+		    MUP::stub_of_acc_control ( c ) ) );
+
+	if ( MINT::remove_from_aux_hash_table ( c, s ) )
+	    ++ lev.count.aux_hash_collected;
+	else
+	    ++ lev.count.collected;
+	-- lev.first_g->count;
+
+	push_swept ( s, c );
+	sweep_removed = s;
+	sweep_removed_previous = previous;
+    }
+
+    if ( sweep_next < sweep_count ) return false;
+
+    lev.count.kept += sweep_kept;
+    lev.count.aux_hash_kept += sweep_aux_hash_kept;
+    lev.last_stub =
+        ( sweep_last == sweep_removed ?
+	  sweep_removed_previous : sweep_last );
+    sweep_lev = NULL;
+
+    if (    lev.last_stub
+	 == lev.first_g[1].last_before )
+	return true;
+    start_sweep ( lev, level );
+    return false;
+}
+
+static void free_swept_stubs ( min::unsptr n )
+{
+    while ( first_swept != NULL && n > 0 )
+    {
+	min::stub * s = first_swept;
+	if ( s == last_swept )
+	    first_swept = NULL;
+	else
+	    first_swept =
+		MUP::stub_of_acc_control
+		    ( MUP::control_of ( s ) );
+
+	deallocate_collected_body
+	    ( s, MUP::type_of ( s ) );
+	MINT::free_acc_stub ( s );
+	-- n;
+    }
+}
+
+# endif // MIN_CONCURRENT_SWEEP
+
+// Defined in the Compactor section below.
+//
+static void free_empty_subregions ( void );
+
+// Number of collections of any level that have
+// finished.  Used by MINT::acc_interrupt to start aux
+// compactor passes.
+//
+static min::uns64 collections_finished = 0;
+
+// Called by collector_increment below, which times it.
+//
+static unsigned collector_increment_body
+	( unsigned level )
+{
+    if (   MACC::process_acc_stack()
+         > 2 * MACC::acc_stack_trigger )
+        return level;
+
+    hash_table_increment();
+
+    int result = level;
+
+    MACC::level & lev = levels[level];
+
+    switch ( lev.collector_phase )
+    {
+
+    case COLLECTOR_NOT_RUNNING:
+        break;
+
+    case COLLECTOR_START:
+    	{
+	    tracec << "START COLLECTOR level "
+	           << level << " generation counts:"
+		   << endl
+		   << print_generations() << endl;
+
+	    // Check that to-be-scavenged stack is
+	    // empty.
+	    //
+	    lev.to_be_scavenged.rewind();
+	    MIN_REQUIRE
+	        ( lev.to_be_scavenged.at_end() );
+
+	    // Check that flags are properly cleared.
+	    //
+	    MIN_REQUIRE
+	        (    (   MINT::acc_stack_mask
+	               & UNMARKED ( level ) )
+		  == 0 );
+	    MIN_REQUIRE
+	        (    (   MACC::acc_stack_scavenge_mask
+	               & SCAVENGED ( level ) )
+		  == 0 );
+	    MIN_REQUIRE
+	        (    (   MACC::removal_request_flags
+	               & UNMARKED ( level ) )
+		  == 0 );
+	    MIN_REQUIRE
+	        (    (   MINT::hash_acc_clear_flags
+	               & UNMARKED ( level ) )
+		  == 0 );
+	    MIN_REQUIRE
+	        (    (   MINT::new_acc_stub_flags
+	               & UNMARKED ( level ) )
+		  == 0 );
+
+	    // Execute this phase.
+	    //
+	    MINT::new_acc_stub_flags |=
+	        UNMARKED ( level );
+	    lev.saved_count = lev.count;
+
+	    lev.collector_phase =
+		START_INITING_COLLECTIBLE;
+	}
+	MIN_FALLTHROUGH
+
+    case START_INITING_COLLECTIBLE:
+	{
+	    if ( lev.g->lock >= 0 ) return lev.g->lock;
+	    lev.g->lock = level;
+	    lev.first_g = lev.last_g = lev.g;
+	    lev.last_stub = lev.g->last_before;
+	    lev.collector_phase =
+		LOCK_INITING_COLLECTIBLE;
+        }
+	MIN_FALLTHROUGH
+
+    case LOCK_INITING_COLLECTIBLE:
+	{
+	    // Establish the condition where
+	    // lev.first_g + 1 == lev.last_g and both
+	    // lev.first_g and lev.last_g are locked.
+	    //
+	    // lev.last_stub is the last stub scanned
+	    // (or the stub before the first stub
+	    // scanned).
+	    //
+
+	    MIN_REQUIRE
+	        ( lev.first_g == lev.last_g );
+	    MIN_REQUIRE
+	        ( lev.first_g->lock == (int) level );
+
+	    if ( lev.last_g[1].lock >= 0 )
+	        return lev.last_g[1].lock;
+
+	    lev.last_g[1].lock = level;
+	    ++ lev.last_g;
+
+	    lev.collector_phase = INITING_COLLECTIBLE;
+	}
+	MIN_FALLTHROUGH
+
+    case INITING_COLLECTIBLE:
+        {
+	    // Set the flags of lev.first_g.
+	    //
+	    MIN_REQUIRE
+	        ( lev.first_g + 1 == lev.last_g );
+	    MIN_REQUIRE
+	        ( lev.first_g->lock == (int) level );
+	    MIN_REQUIRE
+	        ( lev.last_g->lock == (int) level );
+
+	    end_g->last_before =
+		MINT::last_allocated_stub;
+
+	    min::uns64 scanned = 0;
+	    min::uns64 c =
+		MUP::control_of ( lev.last_stub );
+
+	    while ( scanned < MACC::scan_limit )
+	    {
+		if (    lev.last_stub
+		     != lev.last_g->last_before )
+		{
+		    min::stub * s =
+			MUP::stub_of_acc_control ( c );
+		    c = MUP::control_of ( s );
+		    c |= UNMARKED ( level );
+		    c &= ~ SCAVENGED ( level );
+		    MUP::set_control_of ( s, c );
+		    lev.last_stub = s;
+		    ++ scanned;
+		    continue;
+		}
+
+		lev.first_g->lock = -1;
+		lev.first_g = lev.last_g;
+
+		if ( lev.last_g == end_g )
+		{
+		    lev.last_g->lock = -1;
+
+		    // Start next phase.
+		    //
+		    if ( level == 0 )
+			lev.collector_phase =
+			    START_INITING_HASH;
+		    else
+			lev.collector_phase =
+			    START_INITING_ROOT;
+		    break;
+		}
+		else if ( lev.last_g[1].lock >= 0 )
+		{
+		    lev.collector_phase =
+			LOCK_INITING_COLLECTIBLE;
+		    result = lev.last_g[1].lock;
+		    break;
+		}
+		else
+		{
+		    lev.last_g[1].lock = level;
+		    ++ lev.last_g;
+		}
+	    }
+
+	    lev.count.collectible_inited += scanned;
+	}
+        break;
+
+    case START_INITING_HASH:
+	{
+	    lev.hash_table_id = 0;
+	    lev.hash_table_index = 0;
+	    lev.hash_stub = MINT::null_stub;
+	    lev.collector_phase = LOCK_INITING_HASH;
+	}
+	MIN_FALLTHROUGH
+
+    case LOCK_INITING_HASH:
+	{
+	    if ( lev.g[1].lock >= 0 )
+		return lev.g[1].lock;
+	    lev.g[1].lock = level;
+	    lev.collector_phase = INITING_HASH;
+	}
+	MIN_FALLTHROUGH
+	    
+    case INITING_HASH:
+        {
+	    MIN_REQUIRE ( level == 0 );
+	    MIN_REQUIRE
+	        ( lev.g[1].lock == (int) level );
+
+	    min::uns64 scanned = 0;
+	    min::stub * s = lev.hash_stub;
+
+	    min::stub ** hash_table = NULL;
+	    min::uns32 hash_table_size = 0;
+	    while ( scanned < MACC::scan_limit )
+	    {
+	        if ( s != MINT::null_stub )
+		{
+		    min::uns64 c =
+		        MUP::control_of ( s );
+		    c |= UNMARKED ( level );
+		    c &= ~ SCAVENGED ( level );
+		    MUP::set_control_of ( s, c );
+		    s = MUP::stub_of_acc_control ( c );
+		    ++ scanned;
+		    continue;
+		}
+
+	        if ( hash_table == NULL
+		     &&
+		     ! acc_hash_table
+		           ( lev.hash_table_id,
+			     hash_table,
+			     hash_table_size ) )
+		{
+		    lev.g[1].lock = -1;
+		    lev.collector_phase =
+			START_INITING_ROOT;
+		    break;
+		}
+
+		if (    lev.hash_table_index
+		     >= hash_table_size )
+		{
+		    ++ lev.hash_table_id;
+		    lev.hash_table_index = 0;
+		    hash_table = NULL;
+		    continue;
+		}
+
+		if ( acc_hash_entry_uninitialized
+		         ( lev.hash_table_id,
+			   lev.hash_table_index ) )
+		{
+		    ++ lev.hash_table_index;
+		    continue;
+		}
+
+		s = hash_table [lev.hash_table_index++];
+	    }
+
+	    lev.hash_stub = s;
+	    lev.count.acc_hash_inited += scanned;
+	}
+	break;
+
+    case START_INITING_ROOT:
+    case LOCK_INITING_ROOT:
+        {
+	    if ( lev.root_lock >= 0 )
+		return lev.root_lock;
+	    lev.root_lock = level;
+	    lev.root.rewind();
+	    lev.collector_phase = INITING_ROOT;
+	}
+	MIN_FALLTHROUGH
+
+    case INITING_ROOT:
+	{
+	    MIN_REQUIRE
+	        ( lev.root_lock == (int) level );
+
+	    min::uns64 scanned = 0;
+
+	    while ( ! lev.root.at_end()
+	            &&
+		    scanned < MACC::scan_limit )
+	    {
+	        min::stub * s = lev.root.current();
+		lev.root.next();
+		++ scanned;
+		MUP::clear_flags_of
+		    ( s, SCAVENGED ( level ) );
+	    }
+
+	    lev.count.root_inited += scanned;
+
+	    if ( lev.root.at_end() )
+	    {
+		if ( trace_collector )
+		{
+		    cout << "END COLLECTOR INITING"
+		            " level " << level
+		         << " collectible "
+		         << lev.count
+			       .collectible_inited
+		          - lev.saved_count
+		               .collectible_inited;
+		    if ( level == 0 )
+		        cout << " acc hash "
+		             << lev.count
+			           .acc_hash_inited
+		              - lev.saved_count
+			           .acc_hash_inited;
+		    else
+		        cout << " root "
+		             << lev.count.root_inited
+		              - lev.saved_count
+			           .root_inited;
+		    cout << endl;
+		}
+		lev.collector_phase =
+		    START_SCAVENGING_ROOT;
+	    }
+	}
+	break;
+
+    case START_SCAVENGING_ROOT:
+        {
+	    MINT::acc_stack_mask |=
+		UNMARKED ( level );
+	    MACC::acc_stack_scavenge_mask |=
+		SCAVENGED ( level );
+
+	    MINT::scavenge_control & sc =
+		MINT::scavenge_controls[level];
+	    sc.state = 0;
 	    sc.clear_flag = UNMARKED ( level );
 	    sc.set_flag = SCAVENGED ( level );
 	    sc.gen_limit = MACC::scan_limit;
@@ -2238,9 +3978,26 @@ unsigned MACC::collector_increment ( unsigned level )
 		    else if ( ! lev.to_be_scavenged
 		                   .at_end() )
 		    {
+#			if MIN_PARALLEL_MARKERS
+			    if ( level == 0
+			         &&
+				 MACC::marker_threads > 0 )
+			    {
+				scavenged +=
+				    parallel_scavenge
+					( lev, sc );
+				if ( ! lev.to_be_scavenged
+				          .at_end() )
+				    break;
+				continue;
+			    }
+#			endif
+
 		        // sc.s1 comes from scavenged
 			// list.
 			//
+			prefetch_to_be_scavenged
+			    ( lev.to_be_scavenged );
 		        sc.s1 = lev.to_be_scavenged
 			           .current();
 		        lev.to_be_scavenged.remove();
@@ -2441,6 +4198,23 @@ unsigned MACC::collector_increment ( unsigned level )
 			     >= lev.scavenge_limit )
 			    break;
 
+#			if MIN_PARALLEL_MARKERS
+			    if ( level == 0
+			         &&
+				 MACC::marker_threads > 0 )
+			    {
+				scavenged +=
+				    parallel_scavenge
+					( lev, sc );
+				if ( ! lev.to_be_scavenged
+				          .at_end() )
+				    break;
+				continue;
+			    }
+#			endif
+
+			prefetch_to_be_scavenged
+			    ( lev.to_be_scavenged );
 		        sc.s1 = lev.to_be_scavenged
 			           .current();
 		        lev.to_be_scavenged.remove();
@@ -2607,333 +4381,732 @@ unsigned MACC::collector_increment ( unsigned level )
 		    ~ UNMARKED ( level );
 		MACC::acc_stack_scavenge_mask &=
 		    ~ SCAVENGED ( level );
+
+		// All the stubs on the to-be-scavenged
+		// list have been removed, but the list
+		// must be flushed to empty it for the
+		// next collection.
+		//
+		lev.to_be_scavenged.flush();
+
 		lev.collector_phase =
 		    START_REMOVING_TO_BE_SCAVENGED;
 	    }
 	}
 	break;
 
-    case START_REMOVING_TO_BE_SCAVENGED:
+    case START_REMOVING_TO_BE_SCAVENGED:
+	{
+
+	    for ( unsigned L1 = 0;
+		  L1 <= ephemeral_levels; ++ L1 )
+		lev.to_be_scavenged_wait[L1] =
+		    levels[L1].to_be_scavenged.in;
+	    lev.collector_phase =
+		REMOVING_TO_BE_SCAVENGED;
+	}
+	MIN_FALLTHROUGH
+
+    case REMOVING_TO_BE_SCAVENGED:
+        {
+	    for ( unsigned L1 = 0; L1 < level; ++ L1 )
+	    {
+	        if (   lev.to_be_scavenged_wait[L1]
+		     > levels[L1].to_be_scavenged.out )
+		    return L1;
+	    }
+
+	    if ( level == ephemeral_levels )
+	    {
+		if ( level == 0 )
+		    lev.collector_phase =
+			START_COLLECTING_HASH;
+		else
+		    lev.collector_phase =
+			START_COLLECTING;
+	    }
+	    else
+		lev.collector_phase =
+		    START_REMOVING_ROOT;
+	}
+	break;
+
+    case START_REMOVING_ROOT:
+        {
+	    lev.next_level = level + 1;
+	    lev.collector_phase = LOCK_REMOVING_ROOT;
+	}
+	MIN_FALLTHROUGH
+
+    case LOCK_REMOVING_ROOT:
+        {
+	    MACC::level * rrlev =
+	        levels + lev.next_level;
+	    if ( rrlev->root_lock >= 0 )
+		return rrlev->root_lock;
+
+	    rrlev->root_lock = level;
+	    rrlev->root.rewind();
+	    lev.collector_phase = REMOVING_ROOT;
+	    // Fall through to REMOVING_ROOT.
+	}
+	MIN_FALLTHROUGH
+
+    case REMOVING_ROOT:
+        {
+	    min::uns64 root_kept = 0;
+	    min::uns64 root_removed = 0;
+	    min::uns64 remove =
+	        MACC::removal_request_flags;
+	    MACC::level * rrlev =
+	        levels + lev.next_level;
+	    MIN_REQUIRE
+	        ( rrlev->root_lock == (int) level );
+	    while (   root_kept + root_removed
+		    < MACC::scan_limit )
+	    {
+		if ( ! rrlev->root.at_end() )
+		{
+		    min::stub * s =
+			rrlev->root.current();
+		    if ( MUP::test_flags_of
+			     ( s, remove ) )
+		    {
+			rrlev->root.remove();
+			++ root_removed;
+		    }
+		    else
+		    {
+			rrlev->root.keep();
+			++ root_kept;
+		    }
+		    continue;
+		}
+
+		rrlev->root.flush();
+		rrlev->root_lock = -1;
+
+		++ lev.next_level;
+		rrlev = levels + lev.next_level;
+		if ( lev.next_level > ephemeral_levels )
+		    break;
+		else if ( rrlev->root_lock >= 0 )
+		{
+		    lev.collector_phase =
+			LOCK_REMOVING_ROOT;
+		    result = rrlev->root_lock;
+		    break;
+		}
+		else
+		{
+		    rrlev->root_lock = level;
+		    rrlev->root.rewind();
+		}
+	    }
+	    lev.count.root_kept += root_kept;
+	    lev.count.root_removed += root_removed;
+
+	    if ( lev.next_level > ephemeral_levels )
+	    {
+		tracec << "END COLLECTOR REMOVING"
+			  " level " << level
+		       << " root kept "
+		       << lev.count.root_kept
+			- lev.saved_count
+			     .root_kept
+		       << " root removed "
+		       << lev.count.root_removed
+			- lev.saved_count
+			     .root_removed
+		       << endl;
+
+		if ( level == 0 )
+		    lev.collector_phase =
+			START_COLLECTING_HASH;
+		else
+		    lev.collector_phase =
+			START_COLLECTING;
+		break;
+	    }
+	}
+
+	break;
+
+    case START_COLLECTING_HASH:
+        {
+	    lev.hash_table_id = 0;
+	    lev.hash_table_index = 0;
+	    lev.collector_phase = LOCK_COLLECTING_HASH;
+        }
+	MIN_FALLTHROUGH
+
+    case LOCK_COLLECTING_HASH:
+        {
+	    if ( lev.g[1].lock >= 0 )
+	        return lev.g[1].lock;
+	    lev.g[1].lock = level;
+	    lev.collector_phase = COLLECTING_HASH;
+	}
+	MIN_FALLTHROUGH
+
+    case COLLECTING_HASH:
+        {
+	    MIN_REQUIRE ( level == 0 );
+	    MIN_REQUIRE
+	        ( lev.g[1].lock == (int) level );
+
+	    min::uns64 collected = 0;
+	    min::uns64 kept = 0;
+
+	    min::stub ** hash_table = NULL;
+	    min::uns32 hash_table_size = 0;
+	    while (   collected + kept
+	            < MACC::collection_limit )
+	    {
+	        if ( hash_table == NULL
+		     &&
+		     ! acc_hash_table
+		           ( lev.hash_table_id,
+			     hash_table,
+			     hash_table_size ) )
+		{
+		    lev.g[1].lock = -1;
+		    lev.collector_phase =
+			START_COLLECTING;
+		    break;
+		}
+
+		if (    lev.hash_table_index
+		     >= hash_table_size )
+		{
+		    ++ lev.hash_table_id;
+		    lev.hash_table_index = 0;
+		    hash_table = NULL;
+		    continue;
+		}
+
+		if ( acc_hash_entry_uninitialized
+		         ( lev.hash_table_id,
+			   lev.hash_table_index ) )
+		{
+		    ++ lev.hash_table_index;
+		    continue;
+		}
+
+		min::stub * last_s = NULL;
+		min::uns64 last_c;
+		min::stub * s =
+		    hash_table [lev.hash_table_index];
+		while ( s != MINT::null_stub )
+		{
+		    min::uns64 c =
+		        MUP::control_of ( s );
+		    min::stub * next_s =
+			MUP::stub_of_acc_control ( c );
+		    if ( c & UNMARKED ( level ) )
+		    {
+			// Remove s from hash list.
+			//
+			// Note that during scavenging
+			// and collection, if any hashed
+			// stub is returned by hash
+			// table lookup its unmarked
+			// flag is cleared, as per
+			// MINT::hash_acc_clear_flags.
+			//
+			if ( last_s != NULL )
+			{
+			    last_c =
+			      MUP::
+			        renew_acc_control_stub
+				    ( last_c, next_s );
+			    MUP::set_control_of
+			      ( last_s, last_c );
+			}
+			else
+			    hash_table
+			        [lev.hash_table_index] =
+				next_s;
+
+#			if MIN_FLAT_HASH_INDEX
+			    // Remove s from hash index,
+			    // computing its hash before
+			    // its body is deallocated.
+			    //
+			    hash_table_info & ht =
+			        hash_tables
+				    [lev.hash_table_id/2];
+			    MINT::hash_index_remove
+			        ( * ht.index,
+				  ht.hash ( s ), s );
+#			endif
+
+			// Deallocate body of s.
+			//
+			min::unsptr size =
+			    MUP::body_size_of ( s );
+			if ( size != 0 )
+			    MUP::deallocate_body
+				( s, size );
+
+			// Free stub s.
+			//
+			MINT::free_acc_stub ( s );
+			-- * hash_tables
+			       [lev.hash_table_id/2]
+			     .count;
+			++ collected;
+		    }
+		    else
+		    {
+		        last_c = c;
+			last_s = s;
+			++ kept;
+		    }
+		    s = next_s;
+		}
+		++ lev.hash_table_index;
+	    }
+
+	    lev.count.acc_hash_collected += collected;
+	    lev.count.acc_hash_kept += kept;
+	}
+	break;
+
+    case START_COLLECTING:
 	{
-
-	    for ( unsigned L1 = 0;
-		  L1 <= ephemeral_levels; ++ L1 )
-		lev.to_be_scavenged_wait[L1] =
-		    levels[L1].to_be_scavenged.in;
-	    lev.collector_phase =
-		REMOVING_TO_BE_SCAVENGED;
+	    if ( lev.g->lock >= 0 )
+		return lev.g->lock;
+	    lev.g->lock = level;
+	    lev.first_g = lev.last_g = lev.g;
+	    lev.last_stub = lev.g->last_before;
+	    lev.collector_phase = LOCK_COLLECTING;
 	}
 	MIN_FALLTHROUGH
 
-    case REMOVING_TO_BE_SCAVENGED:
-        {
-	    for ( unsigned L1 = 0; L1 < level; ++ L1 )
-	    {
-	        if (   lev.to_be_scavenged_wait[L1]
-		     > levels[L1].to_be_scavenged.out )
-		    return L1;
-	    }
+    case LOCK_COLLECTING:
+	{
+	    end_g->last_before =
+		MINT::last_allocated_stub;
 
-	    if ( level == ephemeral_levels )
+	    // We must make last_g > first_g and
+	    //		last_g[1].last_before
+	    //	     != last_g[0].last_before
+	    //    unless last_g == end_g.
+
+	    while ( lev.last_g != end_g
+	            &&
+		    ( lev.last_g == lev.first_g
+		      ||
+		         lev.last_g->last_before
+		      == lev.last_g[1].last_before ) )
 	    {
-		if ( level == 0 )
-		    lev.collector_phase =
-			START_COLLECTING_HASH;
-		else
-		    lev.collector_phase =
-			START_COLLECTING;
+	        if ( lev.last_g[1].lock >= 0 )
+		    return lev.last_g[1].lock;
+		lev.last_g[1].lock = level;
+		++ lev.last_g;
 	    }
-	    else
-		lev.collector_phase =
-		    START_REMOVING_ROOT;
-	}
-	break;
 
-    case START_REMOVING_ROOT:
-        {
-	    lev.next_level = level + 1;
-	    lev.collector_phase = LOCK_REMOVING_ROOT;
+	    lev.collector_phase = COLLECTING;
 	}
 	MIN_FALLTHROUGH
 
-    case LOCK_REMOVING_ROOT:
+    case COLLECTING:
         {
-	    MACC::level * rrlev =
-	        levels + lev.next_level;
-	    if ( rrlev->root_lock >= 0 )
-		return rrlev->root_lock;
+	    MIN_REQUIRE
+	        ( lev.first_g->lock == (int) level );
+	    MIN_REQUIRE
+	        ( lev.last_g->lock == (int) level );
 
-	    rrlev->root_lock = level;
-	    rrlev->root.rewind();
-	    lev.collector_phase = REMOVING_ROOT;
-	    // Fall through to REMOVING_ROOT.
-	}
-	MIN_FALLTHROUGH
+	    end_g->last_before =
+		MINT::last_allocated_stub;
 
-    case REMOVING_ROOT:
-        {
-	    min::uns64 root_kept = 0;
-	    min::uns64 root_removed = 0;
-	    min::uns64 remove =
-	        MACC::removal_request_flags;
-	    MACC::level * rrlev =
-	        levels + lev.next_level;
-	    MIN_REQUIRE
-	        ( rrlev->root_lock == (int) level );
-	    while (   root_kept + root_removed
-		    < MACC::scan_limit )
+	    end_g[-1].count +=
+		  MUP::acc_stubs_allocated
+		- MACC::saved_acc_stubs_count;
+	    MACC::saved_acc_stubs_count =
+		MUP::acc_stubs_allocated;
+
+	    bool done = false;
+
+	    min::uns64 collected = 0;
+	    min::uns64 kept = 0;
+	    min::uns64 aux_hash_collected = 0;
+	    min::uns64 aux_hash_kept = 0;
+	    min::uns64 scanned = 0;
+
+	    min::uns64 last_c =
+	        MUP::control_of ( lev.last_stub );
+	    while ( scanned < MACC::collection_limit )
 	    {
-		if ( ! rrlev->root.at_end() )
+#		if MIN_CONCURRENT_SWEEP
+		    if ( MACC::sweep_thread
+		         &&
+			 (    sweep_lev == NULL
+			   || sweep_lev == & lev ) )
+		    {
+			if ( ! sweep_generation
+			           ( lev, level ) )
+			    break;
+		    }
+		    else
+#		endif
+		if (    lev.last_stub
+		     != lev.first_g[1].last_before )
 		{
 		    min::stub * s =
-			rrlev->root.current();
-		    if ( MUP::test_flags_of
-			     ( s, remove ) )
+			MUP::stub_of_acc_control
+			    ( last_c );
+		    min::uns64 c =
+		        MUP::control_of ( s );
+		    int type =
+		        MUP::type_of_control ( c );
+		    if ( c & UNMARKED ( level )
+		         &&
+			 type != min::ACC_FREE
+			 &&
+			 type != min::FILLING
+			 &&
+			 s != MINT::last_allocated_stub )
 		    {
-			rrlev->root.remove();
-			++ root_removed;
+			// Remove s from acc list.
+			//
+			// Note that ACC_FREE stubs
+			// may have just been allocated
+			// but not yet put in a place
+			// that the collector can find
+			// and mark them, so they are
+			// not collected.  FILLING stubs
+			// are preallocated stubs being
+			// filled and are similarly
+			// not collected.  The last
+			// allocated stub is not
+			// collected as MINT::free_acc_
+			// stub puts freed stubs after
+			// it.
+			//
+			if ( s == lev.first_g[1]
+				     .last_before )
+			{
+			    // If we are removing the
+			    // last stub of a generation
+			    // we must update the last_
+			    // before's of succeeding
+			    // generations.
+			    //
+			    MACC::generation * g =
+				lev.first_g + 1;
+			    do g->last_before =
+				   lev.last_stub;
+			    while
+			        ( g ++ != lev.last_g );
+			}
+
+			last_c =
+			    MUP::renew_control_stub
+				( last_c,
+				  MUP::
+				    stub_of_acc_control
+				      ( c ) );
+			MUP::set_control_of
+			    ( lev.last_stub, last_c );
+
+			// Remove s from aux hash table.
+			//
+			if ( MINT::
+			     remove_from_aux_hash_table
+			         ( c, s ) )
+			    ++ aux_hash_collected;
+			else
+			    ++ collected;
+
+			// Deallocate body of s.
+			//
+			deallocate_collected_body
+			    ( s, type );
+
+			// Free stub s.
+			//
+			MINT::free_acc_stub ( s );
+			-- lev.first_g->count;
 		    }
 		    else
 		    {
-			rrlev->root.keep();
-			++ root_kept;
+			last_c = c;
+			lev.last_stub = s;
+			if ( MINT::is_name_type
+			               ( type ) )
+			    ++ aux_hash_kept;
+			else
+			    ++ kept;
 		    }
+
+		    ++ scanned;
 		    continue;
 		}
 
-		rrlev->root.flush();
-		rrlev->root_lock = -1;
-
-		++ lev.next_level;
-		rrlev = levels + lev.next_level;
-		if ( lev.next_level > ephemeral_levels )
-		    break;
-		else if ( rrlev->root_lock >= 0 )
-		{
-		    lev.collector_phase =
-			LOCK_REMOVING_ROOT;
-		    result = rrlev->root_lock;
+		lev.first_g->lock = -1;
+
+		while (    ++ lev.first_g
+			!= lev.last_g )
+		    lev.first_g->lock = -1;
+
+		if ( lev.first_g == end_g )
+		{
+		    end_g->lock = -1;
+		    done = true;
+		    break;
+		}
+
+		// We must make last_g > first_g and
+		//		last_g[1].last_before
+		//	     != last_g[0].last_before
+		//    unless last_g == end_g.
+
+		while ( lev.last_g != end_g
+			&&
+			( lev.last_g == lev.first_g
+			  ||
+			     lev.last_g->last_before
+			  == lev.last_g[1]
+				.last_before ) )
+		{
+		    if ( lev.last_g[1].lock >= 0 )
+		    {
+			lev.collector_phase =
+			    LOCK_COLLECTING;
+			result = lev.last_g[1].lock;
+			break;
+		    }
+		    ++ lev.last_g;
+		    lev.last_g->lock = level;
+		}
+
+		if (    lev.collector_phase
+		     == LOCK_COLLECTING )
 		    break;
-		}
-		else
-		{
-		    rrlev->root_lock = level;
-		    rrlev->root.rewind();
-		}
 	    }
-	    lev.count.root_kept += root_kept;
-	    lev.count.root_removed += root_removed;
 
-	    if ( lev.next_level > ephemeral_levels )
+	    lev.count.collected += collected;
+	    lev.count.kept += kept;
+	    lev.count.aux_hash_collected +=
+		aux_hash_collected;
+	    lev.count.aux_hash_kept +=
+		aux_hash_kept;
+
+	    if ( done )
 	    {
-		tracec << "END COLLECTOR REMOVING"
-			  " level " << level
-		       << " root kept "
-		       << lev.count.root_kept
-			- lev.saved_count
-			     .root_kept
-		       << " root removed "
-		       << lev.count.root_removed
-			- lev.saved_count
-			     .root_removed
-		       << endl;
+		if ( trace_collector )
+		{
+		    cout << "END COLLECTOR COLLECTING"
+			    " level "
+		         << level << endl;
+		    if ( level == 0 )
+			cout << "         "
+		             << " ACC HASH: kept "
+		             << lev.count.acc_hash_kept
+			      - lev.saved_count
+			           .acc_hash_kept
+		             << " collected "
+		             << lev.count
+			           .acc_hash_collected
+			      - lev.saved_count
+			           .acc_hash_collected;
+		    else
+			cout << "         "
+		             << " AUX HASH: kept "
+		             << lev.count
+			           .aux_hash_kept
+			      - lev.saved_count
+			           .aux_hash_kept
+		             << " collected "
+		             << lev.count
+			           .aux_hash_collected
+			      - lev.saved_count
+			           .aux_hash_collected
+			     << endl
+		             << "         "
+		             << " NON-HASH: kept "
+		             << lev.count.kept
+			      - lev.saved_count.kept
+		             << " collected "
+		             << lev.count.collected
+			      - lev.saved_count
+			           .collected
+		             << endl;
+		}
+
+		MACC::removal_request_flags &=
+		    ~ UNMARKED ( level );
+		MINT::hash_acc_clear_flags &=
+		    ~ UNMARKED ( level );
 
 		if ( level == 0 )
 		    lev.collector_phase =
-			START_COLLECTING_HASH;
+			COLLECTOR_STOP;
 		else
 		    lev.collector_phase =
-			START_COLLECTING;
-		break;
+			START_LEVEL_PROMOTING;
 	    }
 	}
+        break;
 
-	break;
-
-    case START_COLLECTING_HASH:
-        {
-	    lev.hash_table_id = 0;
-	    lev.hash_table_index = 0;
-	    lev.collector_phase = LOCK_COLLECTING_HASH;
-        }
-	MIN_FALLTHROUGH
-
-    case LOCK_COLLECTING_HASH:
-        {
+    case START_LEVEL_PROMOTING:
+    case LOCK_LEVEL_PROMOTING:
+	{
+	    if ( lev.g->lock >= 0 )
+		return lev.g->lock;
 	    if ( lev.g[1].lock >= 0 )
-	        return lev.g[1].lock;
+		return lev.g[1].lock;
+	    lev.g->lock = level;
 	    lev.g[1].lock = level;
-	    lev.collector_phase = COLLECTING_HASH;
+
+	    lev.collector_phase = LEVEL_PROMOTING;
 	}
 	MIN_FALLTHROUGH
 
-    case COLLECTING_HASH:
+    case LEVEL_PROMOTING:
         {
-	    MIN_REQUIRE ( level == 0 );
+	    MIN_REQUIRE ( level > 0 );
+	    MIN_REQUIRE
+	        ( lev.g->lock == (int) level );
 	    MIN_REQUIRE
 	        ( lev.g[1].lock == (int) level );
 
-	    min::uns64 collected = 0;
-	    min::uns64 kept = 0;
+	    end_g->last_before =
+		MINT::last_allocated_stub;
 
-	    min::stub ** hash_table = NULL;
-	    min::uns32 hash_table_size;
-	    while (   collected + kept
-	            < MACC::collection_limit )
+	    end_g[-1].count +=
+		  MUP::acc_stubs_allocated
+		- MACC::saved_acc_stubs_count;
+	    MACC::saved_acc_stubs_count =
+		MUP::acc_stubs_allocated;
+
+	    min::uns64 promoted = 0;
+	    min::uns64 evacuated = 0;
+	    min::uns64 last_c =
+		MUP::control_of ( lev.g->last_before );
+
+	    while (   promoted
+		    < MACC::scan_limit
+		    &&
+		       lev.g->last_before
+		    != lev.g[1].last_before )
 	    {
-	        if ( hash_table == NULL )
-		    switch ( lev.hash_table_id )
-		{
-		case 0:
-		    hash_table =
-			MINT::str_acc_hash;
-		    hash_table_size =
-			MINT::str_hash_size;
-		    break;
-		case 1:
-		    hash_table =
-			MINT::lab_acc_hash;
-		    hash_table_size =
-			MINT::lab_hash_size;
-		    break;
-#		if MIN_IS_COMPACT
-		    case 2:
-			hash_table =
-			    MINT::num_acc_hash;
-			hash_table_size =
-			    MINT::num_hash_size;
-			break;
-#		endif
-		}
+		min::stub * s =
+		    MUP::stub_of_acc_control
+			( last_c );
+
+		// Stubs promoted to level 0 have their
+		// bodies evacuated from fixed size
+		// blocks.
+		//
+		if ( level == 1
+		     &&
+		     evacuate_fixed_body ( s ) )
+		    ++ evacuated;
 
-		if ( hash_table == NULL )
+		min::uns64 c = MUP::control_of ( s );
+		c &= ~ COLLECTIBLE ( level );
+		int type =
+		    MUP::type_of_control ( c );
+		if ( MINT::is_scavengable ( type ) )
 		{
-		    lev.g[1].lock = -1;
-		    lev.collector_phase =
-			START_COLLECTING;
-		    break;
+		    c &= ~ NON_ROOT ( level );
+		    lev.root.push ( s );
+		    // Note: you do NOT need
+		    // lev.root_lock to push.
 		}
+		MUP::set_control_of ( s, c );
 
-		if (    lev.hash_table_index
-		     >= hash_table_size )
+		// The last stub of the generation is
+		// not moved to the acc hash table, as
+		// it marks the end of the generation
+		// on the acc list.
+		//
+		if ( level != 1
+		     ||
+		     s == lev.g[1].last_before
+		     ||
+		     ! MINT::move_to_acc_hash_table
+			   ( c, s,
+			     last_c,
+			     lev.g->last_before ) )
 		{
-		    ++ lev.hash_table_id;
-		    lev.hash_table_index = 0;
-		    hash_table = NULL;
-		    continue;
+		    lev.g->last_before = s;
+		    last_c = c;
+		    ++ lev.g[-1].count;
 		}
+		else
+		    ++ lev.count.hash_moved;
 
-		min::stub * last_s = NULL;
-		min::uns64 last_c;
-		min::stub * s =
-		    hash_table [lev.hash_table_index];
-		while ( s != MINT::null_stub )
-		{
-		    min::uns64 c =
-		        MUP::control_of ( s );
-		    min::stub * next_s =
-			MUP::stub_of_acc_control ( c );
-		    if ( c & UNMARKED ( level ) )
-		    {
-			// Remove s from hash list.
-			//
-			// Note that during scavenging
-			// and collection, if any hashed
-			// stub is returned by hash
-			// table lookup its unmarked
-			// flag is cleared, as per
-			// MINT::hash_acc_clear_flags.
-			//
-			if ( last_s != NULL )
-			{
-			    last_c =
-			      MUP::
-			        renew_acc_control_stub
-				    ( last_c, next_s );
-			    MUP::set_control_of
-			      ( last_s, last_c );
-			}
-			else
-			    hash_table
-			        [lev.hash_table_index] =
-				next_s;
+		-- lev.g->count;
+		++ promoted;
+	    }
 
-			// Deallocate body of s.
-			//
-			min::unsptr size =
-			    MUP::body_size_of ( s );
-			if ( size != 0 )
-			    MUP::deallocate_body
-				( s, size );
+	    lev.count.promoted += promoted;
+	    lev.count.evacuated += evacuated;
 
-			// Free stub s.
-			//
-			MINT::free_acc_stub ( s );
-			++ collected;
-		    }
-		    else
-		    {
-		        last_c = c;
-			last_s = s;
-			++ kept;
-		    }
-		    s = next_s;
-		}
-		++ lev.hash_table_index;
+	    if (    lev.g->last_before
+		 == lev.g[1].last_before )
+	    {
+	        MIN_REQUIRE ( lev.g->count == 0 );
+		lev.g->lock = -1;
+
+		// Return fixed size block subregions
+		// emptied by evacuation to their
+		// superregions.
+		//
+		if ( level == 1 )
+		    free_empty_subregions();
+		lev.collector_phase =
+		    START_GENERATION_PROMOTING;
 	    }
-
-	    lev.count.acc_hash_collected += collected;
-	    lev.count.acc_hash_kept += kept;
+	    else
+	        break;
 	}
-	break;
+	MIN_FALLTHROUGH
 
-    case START_COLLECTING:
+    case START_GENERATION_PROMOTING:
 	{
-	    if ( lev.g->lock >= 0 )
-		return lev.g->lock;
-	    lev.g->lock = level;
-	    lev.first_g = lev.last_g = lev.g;
-	    lev.last_stub = lev.g->last_before;
-	    lev.collector_phase = LOCK_COLLECTING;
+	    lev.first_g = lev.last_g = lev.g + 1;
+	    lev.collector_phase =
+		LOCK_GENERATION_PROMOTING;
 	}
 	MIN_FALLTHROUGH
 
-    case LOCK_COLLECTING:
-	{
-	    end_g->last_before =
-		MINT::last_allocated_stub;
+    case LOCK_GENERATION_PROMOTING:
+        {
+	    // Establish the condition where
+	    // lev.first_g + 1 == lev.last_g and both
+	    // lev.first_g and lev.last_g are locked.
 
-	    // We must make last_g > first_g and
-	    //		last_g[1].last_before
-	    //	     != last_g[0].last_before
-	    //    unless last_g == end_g.
+	    MIN_REQUIRE ( lev.first_g == lev.last_g );
+	    MIN_REQUIRE
+	        ( lev.first_g->lock == (int) level );
 
-	    while ( lev.last_g != end_g
-	            &&
-		    ( lev.last_g == lev.first_g
-		      ||
-		         lev.last_g->last_before
-		      == lev.last_g[1].last_before ) )
-	    {
-	        if ( lev.last_g[1].lock >= 0 )
-		    return lev.last_g[1].lock;
-		lev.last_g[1].lock = level;
-		++ lev.last_g;
-	    }
+	    if ( lev.last_g[1].lock >= 0 )
+	        return lev.last_g[1].lock;
 
-	    lev.collector_phase = COLLECTING;
+	    lev.last_g[1].lock = level;
+	    ++ lev.last_g;
+
+	    lev.collector_phase = GENERATION_PROMOTING;
 	}
 	MIN_FALLTHROUGH
 
-    case COLLECTING:
+    case GENERATION_PROMOTING:
         {
+	    MIN_REQUIRE ( level > 0 );
+	    MIN_REQUIRE
+	        ( lev.first_g + 1 == lev.last_g );
 	    MIN_REQUIRE
 	        ( lev.first_g->lock == (int) level );
 	    MIN_REQUIRE
 	        ( lev.last_g->lock == (int) level );
 
 	    end_g->last_before =
-		MINT::last_allocated_stub;
+	        MINT::last_allocated_stub;
 
 	    end_g[-1].count +=
 		  MUP::acc_stubs_allocated
@@ -2941,460 +5114,982 @@ unsigned MACC::collector_increment ( unsigned level )
 	    MACC::saved_acc_stubs_count =
 		MUP::acc_stubs_allocated;
 
-	    bool done = false;
+	    end_g->count = 0;
 
-	    min::uns64 collected = 0;
-	    min::uns64 kept = 0;
-	    min::uns64 aux_hash_collected = 0;
-	    min::uns64 aux_hash_kept = 0;
-	    min::uns64 scanned = 0;
+	    while ( true ) {
+	        lev.first_g->last_before =
+		    lev.last_g->last_before;
+	        lev.first_g[-1].count +=
+		    lev.first_g->count;
+		lev.first_g->count = 0;
 
-	    min::uns64 last_c =
-	        MUP::control_of ( lev.last_stub );
-	    while ( scanned < MACC::collection_limit )
-	    {
-		if (    lev.last_stub
-		     != lev.first_g[1].last_before )
+		lev.first_g->lock = -1;
+		++ lev.first_g;
+		MIN_REQUIRE
+		    ( lev.first_g == lev.last_g );
+
+		if (    lev.first_g - lev.g
+		     == lev.number_of_sublevels )
 		{
-		    min::stub * s =
-			MUP::stub_of_acc_control
-			    ( last_c );
-		    min::uns64 c =
-		        MUP::control_of ( s );
-		    int type =
-		        MUP::type_of_control ( c );
-		    if ( c & UNMARKED ( level )
-		         &&
-			 type != min::ACC_FREE
-			 &&
-			 type != min::FILLING )
-		    {
-			// Remove s from acc list.
-			//
-			// Note that ACC_FREE stubs
-			// may have just been allocated
-			// but not yet put in a place
-			// that the collector can find
-			// and mark them, so they are
-			// not collected.  FILLING stubs
-			// are preallocated stubs being
-			// filled and are similarly
-			// not collected.
-			//
-			if ( s == lev.first_g[1]
-				     .last_before )
-			{
-			    // If we are removing the
-			    // last stub of a generation
-			    // we must update the last_
-			    // before's of succeeding
-			    // generations.
-			    //
-			    MACC::generation * g =
-				lev.first_g + 1;
-			    do g->last_before =
-				   lev.last_stub;
-			    while
-			        ( g ++ != lev.last_g );
-			}
+		    lev.first_g->lock = -1;
+		    break;
+		}
 
-			last_c =
-			    MUP::renew_control_stub
-				( last_c,
-				  MUP::
-				    stub_of_acc_control
-				      ( c ) );
-			MUP::set_control_of
-			    ( lev.last_stub, last_c );
+		if ( lev.first_g[1].lock >= 0 )
+		{
+		    lev.collector_phase =
+		        LOCK_GENERATION_PROMOTING;
+		    return lev.first_g[1].lock;
+		}
+		lev.first_g[1].lock = level;
+		++ lev.last_g;
+	    }
 
-			// Remove s from aux hash table.
-			//
-			if ( MINT::
-			     remove_from_aux_hash_table
-			         ( c, s ) )
-			    ++ aux_hash_collected;
-			else
-			    ++ collected;
+	    // We are done with the last generation.
 
-			// Deallocate body of s.
-			//
-			min::unsptr size =
-			    MUP::body_size_of ( s );
-			if ( size != 0 )
-			    MUP::deallocate_body
-				( s, size );
+	    if ( trace_collector )
+	    {
+		cout << "END COLLECTOR PROMOTING level "
+		     << level
+		     << " promoted "
+		     << lev.count.promoted
+		      - lev.saved_count.promoted;
+		if ( level == 1 )
+		    cout << " hash moved "
+		         << lev.count.hash_moved
+		          - lev.saved_count.hash_moved
+		         << " evacuated "
+		         << lev.count.evacuated
+		          - lev.saved_count.evacuated;
+		cout << endl;
+	    }
 
-			// Free stub s.
-			//
-			MINT::free_acc_stub ( s );
-			-- lev.first_g->count;
-		    }
-		    else
-		    {
-			last_c = c;
-			lev.last_stub = s;
-			if ( MINT::is_name_type
-			               ( type ) )
-			    ++ aux_hash_kept;
-			else
-			    ++ kept;
-		    }
+	    lev.collector_phase = COLLECTOR_STOP;
+	}
+        break;
+
+    case COLLECTOR_STOP:
+	{
+	    MACC::return_fixed_block_runs();
+
+	    tracec << "COLLECTOR DONE level "
+		   << level << " generation counts:"
+		   << endl
+		   << print_generations() << endl;
+
+	    lev.collector_phase =
+		COLLECTOR_NOT_RUNNING;
+	    ++ collections_finished;
+	}
+	break;
+
+    default:
+        MIN_ABORT ( "bad collector phase" );
+    }
+    return result;
+}
+
+// Return the current time in nanoseconds from some
+// arbitrary origin.
+//
+static min::uns64 nanoseconds ( void )
+{
+    timespec ts;
+    clock_gettime ( CLOCK_MONOTONIC, & ts );
+    return (min::uns64) ts.tv_sec * 1000000000
+         + ts.tv_nsec;
+}
+
+// Update the maximum m to be at least the difference
+// between the counter c and its value before, b.
+//
+static void update_max
+	( min::uns64 & m, min::uns64 c, min::uns64 b )
+{
+    if ( c - b > m ) m = c - b;
+}
+
+// Return the work counted against scan_limit and
+// collection_limit by the counters c.
+//
+inline min::uns64 scan_work ( MACC::counters & c )
+{
+    return c.scanned + c.collectible_inited
+         + c.root_inited + c.acc_hash_inited;
+}
+inline min::uns64 collection_work
+	( MACC::counters & c )
+{
+    return c.collected + c.acc_hash_collected
+         + c.aux_hash_collected;
+}
+
+// If work > 0, move limit halfway toward the work
+// that could be done in target nanoseconds at the
+// throughput of work in ns nanoseconds, but keep
+// limit within [minimum,maximum].
+//
+static void pace_limit
+	( min::uns64 & limit, min::uns64 work,
+	  min::uns64 ns, min::uns64 target,
+	  min::uns64 minimum, min::uns64 maximum )
+{
+    if ( work == 0 ) return;
+    if ( ns == 0 ) ns = 1;
+    double estimate = (double) work * target / ns;
+    if ( estimate > maximum ) estimate = maximum;
+    limit = ( limit + (min::uns64) estimate ) / 2;
+    if ( limit < minimum ) limit = minimum;
+    if ( limit > maximum ) limit = maximum;
+}
+
+unsigned MACC::collector_increment ( unsigned level )
+{
+    stop_mutators_lock stop;
+    MACC::level & lev = levels[level];
+    unsigned phase = lev.collector_phase;
+    min::uns64 scanned = lev.count.scanned;
+    min::uns64 scavenged = lev.count.scavenged;
+    min::uns64 collected = lev.count.collected;
+    min::uns64 scan_before = scan_work ( lev.count );
+    min::uns64 collection_before =
+        collection_work ( lev.count );
+    min::uns64 begin = nanoseconds();
+
+    unsigned result = collector_increment_body ( level );
+
+    min::uns64 ns = nanoseconds() - begin;
+    ++ lev.increments;
+    ++ lev.phase_increments[phase];
+    lev.phase_ns[phase] += ns;
+    update_max ( lev.max_scanned,
+                 lev.count.scanned, scanned );
+    update_max ( lev.max_scavenged,
+                 lev.count.scavenged, scavenged );
+    update_max ( lev.max_collected,
+                 lev.count.collected, collected );
+    MACC::collector_increment_pauses.record ( ns );
+
+    if ( MACC::pause_target != 0 )
+    {
+	min::uns64 target =
+	    1000 * (min::uns64) MACC::pause_target;
+	pace_limit ( MACC::scan_limit,
+		     scan_work ( lev.count )
+		     - scan_before,
+		     ns, target, 100, 1 << 30 );
+	pace_limit ( MACC::scavenge_limit,
+		     lev.count.scavenged - scavenged,
+		     ns, target, 10, 1 << 30 );
+	pace_limit ( MACC::collection_limit,
+		     collection_work ( lev.count )
+		     - collection_before,
+		     ns, target, 10, 1 << 30 );
+    }
+    return result;
+}
+
+// Helper function for `collect'.  Run one increment at
+// the given level, if necessary running increments at
+// other levels to do this.
+//
+static void run_one ( unsigned level )
+{
+    while ( true )
+    {
+	unsigned L = collector_increment ( level );
+	if ( L == level ) return;
+	run_one ( L );
+    }
+}
+
+void MACC::collect ( unsigned level )
+{
+    stop_mutators_lock stop;
+    if (    levels[level].collector_phase
+         == COLLECTOR_NOT_RUNNING )
+        levels[level].collector_phase = COLLECTOR_START;
+#   if MIN_CONCURRENT_SWEEP
+	sweep_waits = true;
+#   endif
+    while (    levels[level].collector_phase
+            != COLLECTOR_NOT_RUNNING )
+        run_one ( level );
+#   if MIN_CONCURRENT_SWEEP
+	sweep_waits = false;
+	free_swept_stubs ( (min::unsptr) -1 );
+#   endif
+    budget_base = MUP::acc_stubs_allocated;
+    set_acc_budget_limit();
+}
+
+// Compactor
+// ---------
 
-		    ++ scanned;
-		    continue;
-		}
+min::uns64 MACC::compactor_limit;
+min::uns64 MACC::compactor_threshold;
+min::uns64 MACC::compactor_bytes_moved = 0;
+min::uns64 MACC::compactor_regions_freed = 0;
+min::uns64 MACC::compactor_subregions_freed = 0;
+min::uns64 MACC::compactor_stub_pages_freed = 0;
+min::uns64 MACC::aux_compactor_limit;
+min::uns64 MACC::aux_compactor_threshold;
+min::uns64 MACC::aux_compactor_objects = 0;
+min::uns64 MACC::aux_compactor_elements_freed = 0;
+
+static void compactor_initializer ( void )
+{
+    MACC::compactor_limit =
+	MIN_DEFAULT_COMPACTOR_LIMIT;
+    get_param ( "compactor_limit",
+		MACC::compactor_limit,
+		1, 1 << 30 );
+
+    MACC::compactor_threshold =
+	MIN_DEFAULT_COMPACTOR_THRESHOLD;
+    get_param ( "compactor_threshold",
+		MACC::compactor_threshold,
+		0, 100 );
+
+    MACC::aux_compactor_limit =
+	MIN_DEFAULT_AUX_COMPACTOR_LIMIT;
+    get_param ( "aux_compactor_limit",
+		MACC::aux_compactor_limit,
+		1, 1 << 30 );
+
+    MACC::aux_compactor_threshold =
+	MIN_DEFAULT_AUX_COMPACTOR_THRESHOLD;
+    get_param ( "aux_compactor_threshold",
+		MACC::aux_compactor_threshold,
+		0, 100 );
+}
 
-		lev.first_g->lock = -1;
+// Compaction state.  If a compaction is in progress,
+// all live blocks in the paged body region list that
+// are before the block at compact_p in region compact_
+// sr, the source region, have been moved to regions
+// up to and including compact_dr, the destination
+// region, which is compact_sr or the region before it
+// on the list.  Compact_to is the address in compact_
+// dr to which the next live block will be moved.  If
+// compact_dr != compact_sr, compact_dr->next ==
+// compact_to.
+//
+static bool compacting = false;
+static MACC::region * compact_sr;
+static MACC::region * compact_dr;
+static min::uns8 * compact_p;
+static min::uns8 * compact_to;
+
+// Return true if region r is the source or destination
+// region of a compaction in progress, so the size of
+// its last block may not be changed (see MUP::resize_
+// body_in_place).
+//
+static bool compacting_region ( MACC::region * r )
+{
+    return compacting
+           &&
+	   ( r == compact_sr || r == compact_dr );
+}
 
-		while (    ++ lev.first_g
-			!= lev.last_g )
-		    lev.first_g->lock = -1;
+// Purge the pages of paged block region r from `to'
+// to r->next and then set r->next = to.
+//
+static void compact_tail
+	( MACC::region * r, min::uns8 * to )
+{
+    min::unsptr pages =
+	( r->next - to ) / MACC::page_size;
+    if ( pages > 0 )
+	MOS::purge_pool ( pages, to );
+    r->next = to;
+}
 
-		if ( lev.first_g == end_g )
-		{
-		    end_g->lock = -1;
-		    done = true;
-		    break;
-		}
+// Make the n bytes at p in paged block region r into
+// a FREE block, if n > 0.
+//
+static void compact_free
+	( MACC::region * r, min::uns8 * p,
+	  min::unsptr n )
+{
+    if ( n == 0 ) return;
+    MACC::free_variable_size_block * b =
+	(MACC::free_variable_size_block *) p;
+    b->block_control = MUP::new_control_with_locator
+	( r - MACC::region_table, MINT::null_stub );
+    b->block_subcontrol = MUP::new_control_with_type
+	( MACC::FREE, n );
+    r->free_size += n;
+}
 
-		// We must make last_g > first_g and
-		//		last_g[1].last_before
-		//	     != last_g[0].last_before
-		//    unless last_g == end_g.
+// Return subregion r to the free list of its super-
+// region.  The block control word of r already has the
+// locator of its superregion and MINT::null_stub, so
+// after its pages are purged r is made into a free
+// fixed size block of its superregion.  Caller must
+// first remove r from any list it is on.
+//
+static void free_subregion ( MACC::region * r )
+{
+    min::uns64 control = r->block_control;
+    MACC::region * sr =
+	MACC::region_of_body ( & r->block_control );
+    MOS::purge_pool
+	( MACC::subregion_size / MACC::page_size, r );
 
-		while ( lev.last_g != end_g
-			&&
-			( lev.last_g == lev.first_g
-			  ||
-			     lev.last_g->last_before
-			  == lev.last_g[1]
-				.last_before ) )
-		{
-		    if ( lev.last_g[1].lock >= 0 )
-		    {
-			lev.collector_phase =
-			    LOCK_COLLECTING;
-			result = lev.last_g[1].lock;
-			break;
-		    }
-		    ++ lev.last_g;
-		    lev.last_g->lock = level;
-		}
+    MINT::free_fixed_size_block * b =
+	(MINT::free_fixed_size_block *) r;
+    b->block_control = control;
+    if ( sr->last_free == NULL )
+	sr->last_free = b->next = b;
+    else
+    {
+	b->next = sr->last_free->next;
+	sr->last_free->next = b;
+	sr->last_free = b;
+    }
+    ++ sr->free_count;
+    ++ MACC::compactor_subregions_freed;
+}
 
-		if (    lev.collector_phase
-		     == LOCK_COLLECTING )
-		    break;
-	    }
+// Return fixed size block subregions that have no used
+// blocks, other than current regions, and variable
+// size block subregions all of whose blocks are free,
+// other than the last such region, to the free lists
+// of their superregions.
+//
+static void free_empty_subregions ( void )
+{
+    for ( unsigned j = 0;
+	  j < MIN_ABSOLUTE_MAX_FIXED_BLOCK_SIZE_LOG-2;
+	  ++ j )
+    {
+	MINT::fixed_block_list_extension * fblext =
+	    fixed_block_extensions + j;
+	MACC::region * last = fblext->last_region;
+	if ( last == NULL ) continue;
+	MACC::region * r = last;
+	MACC::region * next = r->region_next;
+	do
+	{
+	    r = next;
+	    next = r->region_next;
 
-	    lev.count.collected += collected;
-	    lev.count.kept += kept;
-	    lev.count.aux_hash_collected +=
-		aux_hash_collected;
-	    lev.count.aux_hash_kept +=
-		aux_hash_kept;
+	    if ( r == fblext->current_region
+		 ||
+		 r->free_count < r->max_free_count )
+		continue;
 
-	    if ( done )
-	    {
-		if ( trace_collector )
-		{
-		    cout << "END COLLECTOR COLLECTING"
-			    " level "
-		         << level << endl;
-		    if ( level == 0 )
-			cout << "         "
-		             << " ACC HASH: kept "
-		             << lev.count.acc_hash_kept
-			      - lev.saved_count
-			           .acc_hash_kept
-		             << " collected "
-		             << lev.count
-			           .acc_hash_collected
-			      - lev.saved_count
-			           .acc_hash_collected;
-		    else
-			cout << "         "
-		             << " AUX HASH: kept "
-		             << lev.count
-			           .aux_hash_kept
-			      - lev.saved_count
-			           .aux_hash_kept
-		             << " collected "
-		             << lev.count
-			           .aux_hash_collected
-			      - lev.saved_count
-			           .aux_hash_collected
-			     << endl
-		             << "         "
-		             << " NON-HASH: kept "
-		             << lev.count.kept
-			      - lev.saved_count.kept
-		             << " collected "
-		             << lev.count.collected
-			      - lev.saved_count
-			           .collected
-		             << endl;
-		}
+	    MACC::remove ( fblext->last_region, r );
+	    free_subregion ( r );
 
-		MACC::removal_request_flags &=
-		    ~ UNMARKED ( level );
-		MINT::hash_acc_clear_flags &=
-		    ~ UNMARKED ( level );
+	} while ( r != last );
+    }
 
-		if ( level == 0 )
-		    lev.collector_phase =
-			COLLECTOR_STOP;
-		else
-		    lev.collector_phase =
-			START_LEVEL_PROMOTING;
-	    }
+    MACC::region * last = MACC::last_variable_body_region;
+    if ( last == NULL ) return;
+    MACC::region * r = last->region_next;
+    while ( r != last )
+    {
+	MACC::region * next = r->region_next;
+	if (    r->free_size
+	     == (min::unsptr) ( r->next - r->begin ) )
+	{
+	    MACC::remove
+		( MACC::last_variable_body_region, r );
+	    free_subregion ( r );
 	}
-        break;
+	r = next;
+    }
+}
 
-    case START_LEVEL_PROMOTING:
-    case LOCK_LEVEL_PROMOTING:
-	{
-	    if ( lev.g->lock >= 0 )
-		return lev.g->lock;
-	    if ( lev.g[1].lock >= 0 )
-		return lev.g[1].lock;
-	    lev.g->lock = level;
-	    lev.g[1].lock = level;
+// If all the stubs from some page boundary of the
+// stub region up to MACC::stub_next are on the free
+// list, remove them from the free list, move MACC::
+// stub_next back to the lowest such boundary, and free
+// the pages of the stubs removed.
+//
+// Allocated stubs may be ACC_FREE, so the free list
+// is counted to be sure that all the ACC_FREE stubs
+// at the end of the stub region are on it.
+//
+static void free_end_stubs ( void )
+{
+    min::stub * top = MACC::stub_next;
+    while ( top > MACC::stub_begin + 1
+            &&
+	       MUP::type_of ( top - 1 )
+	    == min::ACC_FREE )
+	-- top;
+
+    min::unsptr top_pages =
+        number_of_pages
+	    (   (min::uns8 *) top
+	      - (min::uns8 *) MACC::stub_begin );
+    top = (min::stub *)
+        (   (min::uns8 *) MACC::stub_begin
+	  + top_pages * MACC::page_size );
+    if ( top >= MACC::stub_next ) return;
 
-	    lev.collector_phase = LEVEL_PROMOTING;
+    min::unsptr count = 0;
+    min::stub * s = MINT::last_allocated_stub;
+    for ( min::unsptr i = 0;
+          i < MINT::number_of_free_stubs; ++ i )
+    {
+	s = MUP::stub_of_acc_control
+	        ( MUP::control_of ( s ) );
+	if ( s >= top ) ++ count;
+    }
+    if (    count
+         != (min::unsptr) ( MACC::stub_next - top ) )
+	return;
+
+    min::stub * previous = MINT::last_allocated_stub;
+    min::unsptr n = MINT::number_of_free_stubs;
+    while ( n -- > 0 )
+    {
+	min::uns64 c = MUP::control_of ( previous );
+	s = MUP::stub_of_acc_control ( c );
+	if ( s >= top )
+	{
+	    MUP::set_control_of
+	        ( previous,
+		  MUP::renew_acc_control_stub
+		      ( c,
+		        MUP::stub_of_acc_control
+			    ( MUP::control_of ( s ) ) ) );
+	    -- MINT::number_of_free_stubs;
 	}
-	MIN_FALLTHROUGH
+	else
+	    previous = s;
+    }
+    if ( MINT::number_of_free_stubs > 0 )
+	MINT::last_free_stub = previous;
 
-    case LEVEL_PROMOTING:
-        {
-	    MIN_REQUIRE ( level > 0 );
-	    MIN_REQUIRE
-	        ( lev.g->lock == (int) level );
-	    MIN_REQUIRE
-	        ( lev.g[1].lock == (int) level );
+    min::stub * end =
+        ( MACC::stub_commit_pages == 0 ?
+	  MACC::stub_next : MACC::stub_commit_end );
+    min::unsptr pages =
+        number_of_pages
+	    ( (min::uns8 *) end - (min::uns8 *) top );
 
-	    end_g->last_before =
-		MINT::last_allocated_stub;
+    if ( MACC::stub_commit_pages == 0 )
+	MOS::purge_pool ( pages, top );
+    else
+    {
+	MOS::inaccess_pool ( pages, top );
+	MACC::stub_commit_end = top;
+    }
+    MACC::stub_next = top;
+    MACC::compactor_stub_pages_freed += pages;
+}
 
-	    end_g[-1].count +=
-		  MUP::acc_stubs_allocated
-		- MACC::saved_acc_stubs_count;
-	    MACC::saved_acc_stubs_count =
-		MUP::acc_stubs_allocated;
+// Finish a compaction.
+//
+static void compact_finish ( void )
+{
+    if ( compact_dr == compact_sr )
+	compact_tail ( compact_sr, compact_to );
+    compacting = false;
+    free_end_stubs();
+
+    tracecp << "TRACE: compaction finished: "
+	    << MACC::compactor_bytes_moved
+	    << " bytes moved, "
+	    << MACC::compactor_regions_freed
+	    << " regions freed, "
+	    << MACC::compactor_subregions_freed
+	    << " subregions freed, "
+	    << MACC::compactor_stub_pages_freed
+	    << " stub pages freed" << endl;
+}
 
-	    min::uns64 promoted = 0;
-	    min::uns64 last_c =
-		MUP::control_of ( lev.g->last_before );
+// Abandon a compaction because the block at compact_p
+// cannot be moved.  The space from which blocks have
+// been moved but to which blocks have not been moved
+// is made into a FREE block.
+//
+static void compact_abandon ( void )
+{
+    if ( compact_dr == compact_sr )
+	compact_free
+	    ( compact_sr, compact_to,
+	      compact_p - compact_to );
+    else
+	compact_free
+	    ( compact_sr, compact_sr->begin,
+	      compact_p - compact_sr->begin );
+    compacting = false;
 
-	    while (   promoted
-		    < MACC::scan_limit
-		    &&
-		       lev.g->last_before
-		    != lev.g[1].last_before )
-	    {
-		min::stub * s =
-		    MUP::stub_of_acc_control
-			( last_c );
-		min::uns64 c = MUP::control_of ( s );
-		c &= ~ COLLECTIBLE ( level );
-		int type =
-		    MUP::type_of_control ( c );
-		if ( MINT::is_scavengable ( type ) )
-		{
-		    c &= ~ NON_ROOT ( level );
-		    lev.root.push ( s );
-		    // Note: you do NOT need
-		    // lev.root_lock to push.
-		}
-		MUP::set_control_of ( s, c );
+    tracecp << "TRACE: compaction abandoned at"
+	       " unmovable block" << endl;
+}
 
-		if ( level != 1
-		     ||
-		     ! MINT::move_to_acc_hash_table
-			   ( c, s,
-			     last_c,
-			     lev.g->last_before ) )
-		{
-		    lev.g->last_before = s;
-		    last_c = c;
-		    ++ lev.g[-1].count;
-		}
-		else
-		    ++ lev.count.hash_moved;
+// Next stub to be examined by the aux compactor.  NULL
+// means MACC::stub_begin.
+//
+static min::stub * aux_compact_next = NULL;
 
-		-- lev.g->count;
-		++ promoted;
-	    }
+// Reorganize the object with stub s if it can be and
+// enough of its aux area is unused.
+//
+static void aux_compact ( min::stub * s )
+{
+    if ( min::private_flag_of ( min::new_stub_gen ( s ) )
+         ||
+	 min::public_flag_of ( min::new_stub_gen ( s ) ) )
+        return;
+
+    min::obj_vec_insptr vp ( s );
+    min::unsptr total_size = min::total_size_of ( vp );
+    min::unsptr aux_size = min::aux_size_of ( vp );
+    if ( aux_size == 0 ) return;
+
+    min::gen * base = MUP::base ( vp );
+    min::unsptr unused = 0;
+    for ( min::unsptr i = total_size - aux_size;
+          i < total_size; ++ i )
+    {
+        if ( base[i] == min::NONE() ) ++ unused;
+    }
+    if (   100 * unused
+         < MACC::aux_compactor_threshold * aux_size
+	 ||
+	 unused == 0 )
+        return;
+
+    min::reorganize ( vp, min::hash_size_of ( vp ),
+                          min::var_size_of ( vp ),
+			  min::unused_size_of ( vp ),
+			  false );
+    ++ MACC::aux_compactor_objects;
+    MACC::aux_compactor_elements_freed +=
+        aux_size - min::aux_size_of ( vp );
+}
 
-	    lev.count.promoted += promoted;
+bool MACC::aux_compactor_increment ( void )
+{
+    stop_mutators_lock stop;
+    if ( MACC::aux_compactor_threshold == 0 )
+        return false;
 
-	    if (    lev.g->last_before
-		 == lev.g[1].last_before )
-	    {
-	        MIN_REQUIRE ( lev.g->count == 0 );
-		lev.g->lock = -1;
-		lev.collector_phase =
-		    START_GENERATION_PROMOTING;
-	    }
-	    else
-	        break;
-	}
-	MIN_FALLTHROUGH
+    min::stub * s = aux_compact_next;
+    if ( s == NULL ) s = MACC::stub_begin;
 
-    case START_GENERATION_PROMOTING:
+    for ( min::uns64 count = 0;
+          count < MACC::aux_compactor_limit;
+	  ++ count, ++ s )
+    {
+	// Stubs allocated by reorganize are after the
+	// stubs examined, so MACC::stub_next is re-read
+	// each time.
+	//
+        if ( s >= MACC::stub_next )
 	{
-	    lev.first_g = lev.last_g = lev.g + 1;
-	    lev.collector_phase =
-		LOCK_GENERATION_PROMOTING;
+	    aux_compact_next = NULL;
+	    return false;
 	}
-	MIN_FALLTHROUGH
+	if (    ( MUP::type_of ( s ) & min::OBJ_MASK )
+	     == min::OBJ )
+	    aux_compact ( s );
+    }
 
-    case LOCK_GENERATION_PROMOTING:
-        {
-	    // Establish the condition where
-	    // lev.first_g + 1 == lev.last_g and both
-	    // lev.first_g and lev.last_g are locked.
+    aux_compact_next = s;
+    return true;
+}
 
-	    MIN_REQUIRE ( lev.first_g == lev.last_g );
-	    MIN_REQUIRE
-	        ( lev.first_g->lock == (int) level );
+bool MACC::compactor_increment ( bool force )
+{
+    stop_mutators_lock stop;
+    if ( ! compacting )
+    {
+	MACC::region * last =
+	    MACC::last_paged_body_region;
 
-	    if ( lev.last_g[1].lock >= 0 )
-	        return lev.last_g[1].lock;
+	if ( ! force )
+	{
+	    if ( last == NULL ) return false;
 
-	    lev.last_g[1].lock = level;
-	    ++ lev.last_g;
+	    min::uns64 used = 0, free = 0;
+	    MACC::region * r = last;
+	    do
+	    {
+		r = r->region_next;
+		used += r->next - r->begin;
+		free += r->free_size;
+	    } while ( r != last );
 
-	    lev.collector_phase = GENERATION_PROMOTING;
+	    if ( free == 0
+		 ||
+		   100 * free
+		 < MACC::compactor_threshold * used )
+		return false;
 	}
-	MIN_FALLTHROUGH
-
-    case GENERATION_PROMOTING:
-        {
-	    MIN_REQUIRE ( level > 0 );
-	    MIN_REQUIRE
-	        ( lev.first_g + 1 == lev.last_g );
-	    MIN_REQUIRE
-	        ( lev.first_g->lock == (int) level );
-	    MIN_REQUIRE
-	        ( lev.last_g->lock == (int) level );
 
-	    end_g->last_before =
-	        MINT::last_allocated_stub;
+	tracecp << "TRACE: compaction started" << endl;
 
-	    end_g[-1].count +=
-		  MUP::acc_stubs_allocated
-		- MACC::saved_acc_stubs_count;
-	    MACC::saved_acc_stubs_count =
-		MUP::acc_stubs_allocated;
+	free_empty_subregions();
+	if ( last == NULL )
+	{
+	    compact_finish();
+	    return false;
+	}
 
-	    end_g->count = 0;
+	compact_sr = compact_dr = last->region_next;
+	compact_p = compact_to = compact_sr->begin;
+	compacting = true;
+    }
 
-	    while ( true ) {
-	        lev.first_g->last_before =
-		    lev.last_g->last_before;
-	        lev.first_g[-1].count +=
-		    lev.first_g->count;
-		lev.first_g->count = 0;
+    MACC::region * & sr = compact_sr;
+    MACC::region * & dr = compact_dr;
+    min::uns8 * & p = compact_p;
+    min::uns8 * & to = compact_to;
 
-		lev.first_g->lock = -1;
-		++ lev.first_g;
-		MIN_REQUIRE
-		    ( lev.first_g == lev.last_g );
+    for ( min::uns64 count = 0;
+	  count < MACC::compactor_limit; )
+    {
+	if ( p >= sr->next )
+	{
+	    // Source region finished.  Note that
+	    // the last region may still be used for
+	    // allocation, so sr->next is re-read each
+	    // time.
 
-		if (    lev.first_g - lev.g
-		     == lev.number_of_sublevels )
-		    break;
+	    MACC::region * next = sr->region_next;
+	    bool last =
+		( sr == MACC::last_paged_body_region );
 
-		if ( lev.first_g[1].lock >= 0 )
-		{
-		    lev.collector_phase =
-		        LOCK_GENERATION_PROMOTING;
-		    return lev.first_g[1].lock;
-		}
-		lev.first_g[1].lock = level;
-		++ lev.last_g;
+	    if ( sr != dr )
+	    {
+		// All blocks of sr have been moved or
+		// were free, so sr can be freed.
+		//
+		MIN_REQUIRE ( sr->free_size == 0 );
+		MACC::remove
+		    ( MACC::last_paged_body_region,
+		      sr );
+		free_paged_block_region ( sr );
+		++ MACC::compactor_regions_freed;
+		sr = dr;
 	    }
+	    else
+		compact_tail ( sr, to );
 
-	    // We are done with the last generation.
-
-	    if ( trace_collector )
+	    if ( last )
 	    {
-		cout << "END COLLECTOR PROMOTING level "
-		     << level
-		     << " promoted "
-		     << lev.count.promoted
-		      - lev.saved_count.promoted;
-		if ( level == 1 )
-		    cout << " hash moved "
-		         << lev.count.hash_moved
-		          - lev.saved_count.hash_moved;
-		cout << endl;
+		compact_finish();
+		return false;
 	    }
 
-	    lev.collector_phase = COLLECTOR_STOP;
+	    sr = next;
+	    p = sr->begin;
+	    continue;
 	}
-        break;
 
-    case COLLECTOR_STOP:
+	++ count;
+
+	min::uns64 * bp = (min::uns64 *) p;
+	min::stub * s = MACC::stub_of_body ( bp );
+	if ( s == MINT::null_stub )
 	{
-	    tracec << "COLLECTOR DONE level "
-		   << level << " generation counts:"
-		   << endl
-		   << print_generations() << endl;
+	    min::unsptr n =
+		MUP::value_of_control ( bp[1] );
+	    MIN_REQUIRE ( sr->free_size >= n );
+	    sr->free_size -= n;
+	    p += n;
+	    continue;
+	}
 
-	    lev.collector_phase =
-		COLLECTOR_NOT_RUNNING;
+	min::unsptr n = MUP::body_size_of ( s );
+	if ( n == 0 )
+	{
+	    compact_abandon();
+	    return false;
 	}
-	break;
+	n = ( n + 8 + sr->round_mask )
+	  & ~ sr->round_mask;
 
-    default:
-        MIN_ABORT ( "bad collector phase" );
+	if ( dr != sr && to + n > dr->end )
+	{
+	    // Destination region is full, and as
+	    // regions between dr and sr have been
+	    // freed, sr becomes the destination.
+	    //
+	    dr = dr->region_next;
+	    MIN_REQUIRE ( dr == sr );
+	    to = sr->begin;
+	}
+
+	if ( to != p )
+	{
+	    MOS::move_pool
+		( n / MACC::page_size, to, p );
+	    bp = (min::uns64 *) to;
+	    if ( dr != sr )
+		* bp = MUP::new_control_with_locator
+			   ( dr - MACC::region_table,
+			     s );
+	    MUP::set_ptr_of ( s, bp + 1 );
+	    MACC::compactor_bytes_moved += n;
+	}
+	to += n;
+	p += n;
+	if ( dr != sr ) dr->next = to;
     }
-    return result;
+
+    return true;
 }
 
-// Helper function for `collect'.  Run one increment at
-// the given level, if necessary running increments at
-// other levels to do this.
+void MACC::compact ( void )
+{
+    stop_mutators_lock stop;
+    // Finish any pass in progress, then make a full
+    // pass.
+    //
+    if ( aux_compact_next != NULL )
+	while ( aux_compactor_increment() );
+    while ( aux_compactor_increment() );
+
+    if ( ! compacting
+	 &&
+	 ! compactor_increment ( true ) )
+	return;
+    while ( compactor_increment() );
+}
+
+
+// ACC Interrupt
+// --- ---------
+
+// Set MINT::acc_budget_limit so that new_acc_stub
+// schedules an interrupt when the allocation budget is
+// exhausted, if pacing is on and no collection of the
+// youngest level is running (while one is running,
+// acc stack interrupts run its increments).
 //
-static void run_one ( unsigned level )
+static void set_acc_budget_limit ( void )
 {
-    while ( true )
+    MACC::level & young =
+        levels[MACC::ephemeral_levels];
+    if ( MACC::pause_target != 0
+         &&
+            young.collector_phase
+	 == COLLECTOR_NOT_RUNNING )
+	MINT::acc_budget_limit =
+	    budget_base + MACC::allocation_budget;
+    else
+	MINT::acc_budget_limit = (min::uns64) -1;
+}
+
+// Paced interrupt work: see MACC::pause_target.
+//
+static void pace_collections ( void )
+{
+    MACC::process_acc_stack();
+
+    MACC::level & young =
+        levels[MACC::ephemeral_levels];
+    if (    young.collector_phase
+         == COLLECTOR_NOT_RUNNING
+	 &&
+	    MUP::acc_stubs_allocated - budget_base
+	 >= MACC::allocation_budget )
     {
-	unsigned L = collector_increment ( level );
-	if ( L == level ) return;
-	run_one ( L );
+        young.collector_phase = COLLECTOR_START;
+	budget_base = MUP::acc_stubs_allocated;
+    }
+
+    for ( int L = MACC::ephemeral_levels; L >= 0; -- L )
+    {
+        if (    levels[L].collector_phase
+	     != COLLECTOR_NOT_RUNNING )
+	{
+	    run_one ( L );
+	    break;
+	}
     }
+
+    MINT::acc_stack_limit =
+	  MINT::acc_stack
+	+ 2 * MACC::acc_stack_trigger;
 }
 
-void MACC::collect ( unsigned level )
+// Value of collections_finished when the current or
+// last aux compactor pass started.
+//
+static min::uns64 aux_pass_collections = 0;
+
+// True while aux_compact_interrupt is running, so that
+// an interrupt inside a reorganize does not recurse.
+//
+static bool aux_compacting = false;
+
+// Perform one aux compactor increment if a pass over
+// the stub region is in progress, or if a collection
+// has finished since the last pass started, in which
+// case a new pass is started.
+//
+static void aux_compact_interrupt ( void )
 {
-    if (    levels[level].collector_phase
-         == COLLECTOR_NOT_RUNNING )
-        levels[level].collector_phase = COLLECTOR_START;
-    while (    levels[level].collector_phase
-            != COLLECTOR_NOT_RUNNING )
-        run_one ( level );
+    if ( aux_compacting ) return;
+    if ( aux_compact_next == NULL )
+    {
+        if (    aux_pass_collections
+	     == collections_finished )
+	    return;
+	aux_pass_collections = collections_finished;
+    }
+    aux_compacting = true;
+    MACC::aux_compactor_increment();
+    aux_compacting = false;
+}
+
+// Value of collections_finished when compact_interrupt
+// last checked compactor_threshold.
+//
+static min::uns64 compact_check_collections = 0;
+
+// Perform one compactor increment if a compaction is in
+// progress, or if a collection has finished since the
+// last check, in which case a compaction is started if
+// compactor_threshold is met.
+//
+static void compact_interrupt ( void )
+{
+    if ( ! compacting )
+    {
+        if (    compact_check_collections
+	     == collections_finished )
+	    return;
+	compact_check_collections =
+	    collections_finished;
+    }
+    MACC::compactor_increment();
 }
-
-// Compactor
-// ---------
-
-// ACC Interrupt
-// --- ---------
 
 bool MINT::acc_interrupt ( void )
 {
     min::initialize();
-    // TBD
+#   if MIN_MUTATOR_THREADS
+	// If another thread stopped the mutator
+	// threads, this thread has waited for it
+	// and its acc stack has been emptied.
+	//
+	if ( ! MINT::stop_mutators() ) return true;
+#   endif
+    ++ MACC::acc_interrupts;
+    min::uns64 begin = nanoseconds();
+    if ( MACC::pause_target != 0 )
+        pace_collections();
+    else
+    {
+        // Empty the acc stack so that stores do not
+	// cause an interrupt at every check until the
+	// next collector increment.
+	//
+	MACC::process_acc_stack();
+	MINT::acc_stack_limit =
+	      MINT::acc_stack
+	    + 2 * MACC::acc_stack_trigger;
+    }
+    aux_compact_interrupt();
+    compact_interrupt();
+    set_acc_budget_limit();
+    MACC::acc_interrupt_pauses.record
+        ( nanoseconds() - begin );
+#   if MIN_MUTATOR_THREADS
+	MINT::start_mutators();
+#   endif
     return true;
 }
+
+// Mutator Threads
+// ------- -------
+
+# if MIN_MUTATOR_THREADS
+
+void MINT::acc_stop_mutators ( void )
+{
+    // A thread constructing its min::mutator_thread
+    // allocates its acc stack here, as min_os may only
+    // be used by one thread at a time.
+    //
+    if ( MACC::acc_stack_begin == NULL )
+        new_acc_stack();
+
+    // Move the pairs of the other threads' acc stacks
+    // to the acc stack of this thread.
+    //
+    for ( MINT::mutator_context * c =
+              MINT::mutator_contexts;
+	  c != NULL; c = c->next )
+    {
+        if ( c->acc_stack == & MINT::acc_stack )
+	    continue;
+
+	min::stub ** p = c->acc_stack_begin;
+	min::stub ** end = * c->acc_stack;
+	while ( p < end )
+	{
+	    if ( MINT::acc_stack >= MACC::acc_stack_end )
+	        MACC::process_acc_stack();
+	    * MINT::acc_stack ++ = * p ++;
+	    * MINT::acc_stack ++ = * p ++;
+	}
+	* c->acc_stack = c->acc_stack_begin;
+	* c->acc_stack_limit =
+	      c->acc_stack_begin
+	    + 2 * MACC::acc_stack_trigger;
+    }
+
+    flush_stub_buffers();
+}
+
+void MINT::acc_start_mutators ( void )
+{
+    // Stubs taken by this thread while the others
+    // were stopped are returned, and a new stub
+    // sentinel is taken.
+    //
+    MINT::allocator_lock lock;
+    flush_stub_buffers();
+
+    MINT::acc_reserve_stub_free_list ( 1 );
+    stub_sentinel_previous = MINT::last_allocated_stub;
+    stub_sentinel = next_stub ( stub_sentinel_previous );
+    -- MINT::number_of_free_stubs;
+    MINT::last_allocated_stub = stub_sentinel;
+}
+
+void MINT::acc_initialize_thread
+	( MINT::mutator_context * context )
+{
+    MIN_REQUIRE ( MACC::acc_stack_begin != NULL );
+    context->acc_stack_begin = MACC::acc_stack_begin;
+    context->acc_stack_end = MACC::acc_stack_end;
+}
+
+void MINT::acc_finalize_thread
+	( MINT::mutator_context * context )
+{
+    ::return_fixed_block_runs
+        ( context->fixed_block_runs );
+    MACC::process_acc_stack();
+    MOS::free_pool
+        (   number_of_pages ( MACC::acc_stack_max_size )
+	  + 1,
+	  MACC::acc_stack_begin );
+}
+
+# endif // MIN_MUTATOR_THREADS
 
 // Statistics
 // ----------
 
 void MACC::print_acc_statistics ( std::ostream & s )
 {
+    stop_mutators_lock stop;
     min::unsptr nstubs =
         MACC::stub_next - MACC::stub_begin;
     cout << std::setw ( 32 ) << "Numbers of"
@@ -3424,7 +6119,8 @@ void MACC::print_acc_statistics ( std::ostream & s )
 	                  (min::uns64) fbl->size );
         MINT::fixed_block_list_extension * fblex =
 	    fbl->extension;
-	min::unsptr free = fbl->count;
+	min::unsptr free = fbl->count
+	                 + run_blocks ( fbl );
 	min::unsptr total = 0;
 	MACC::region * r = fblex->last_region;
 	if ( r != NULL ) do {
@@ -3448,6 +6144,330 @@ void MACC::print_acc_statistics ( std::ostream & s )
 	 << std::setw ( 14 ) << free_bytes
 	 << std::setw ( 14 ) << total_bytes
 	 << std::endl;
+
+    total_bytes = 0;
+    free_bytes = 0;
+    MACC::region * r = MACC::last_variable_body_region;
+    if ( r != NULL ) do {
+	total_bytes += r->next - r->begin;
+	free_bytes += r->free_size;
+	r = r->region_next;
+    } while ( r != MACC::last_variable_body_region );
+    if ( total_bytes > 0 )
+	cout << std::setw ( 32 )
+	     << "Bytes in Variable Size Blocks:"
+	     << std::setw ( 14 )
+	     << total_bytes - free_bytes
+	     << std::setw ( 14 ) << free_bytes
+	     << std::setw ( 14 ) << total_bytes
+	     << std::endl;
+}
+
+const char * MACC::phase_name[MACC::NUMBER_OF_PHASES] =
+{
+    "COLLECTOR_NOT_RUNNING",
+    "COLLECTOR_START",
+    "START_INITING_COLLECTIBLE",
+    "LOCK_INITING_COLLECTIBLE",
+    "INITING_COLLECTIBLE",
+    "START_INITING_HASH",
+    "LOCK_INITING_HASH",
+    "INITING_HASH",
+    "START_INITING_ROOT",
+    "LOCK_INITING_ROOT",
+    "INITING_ROOT",
+    "START_SCAVENGING_ROOT",
+    "LOCK_SCAVENGING_ROOT",
+    "SCAVENGING_ROOT",
+    "START_SCAVENGING_THREAD",
+    "SCAVENGING_THREAD",
+    "START_REMOVING_TO_BE_SCAVENGED",
+    "REMOVING_TO_BE_SCAVENGED",
+    "START_REMOVING_ROOT",
+    "LOCK_REMOVING_ROOT",
+    "REMOVING_ROOT",
+    "START_COLLECTING_HASH",
+    "LOCK_COLLECTING_HASH",
+    "COLLECTING_HASH",
+    "START_COLLECTING",
+    "LOCK_COLLECTING",
+    "COLLECTING",
+    "START_LEVEL_PROMOTING",
+    "LOCK_LEVEL_PROMOTING",
+    "LEVEL_PROMOTING",
+    "START_GENERATION_PROMOTING",
+    "LOCK_GENERATION_PROMOTING",
+    "GENERATION_PROMOTING",
+    "COLLECTOR_STOP"
+};
+
+MACC::pause_histogram MACC::collector_increment_pauses;
+MACC::pause_histogram MACC::acc_interrupt_pauses;
+min::uns64 MACC::acc_interrupts = 0;
+min::unsptr MACC::acc_stack_high_water = 0;
+min::uns64 MACC::acc_stack_rescans = 0;
+min::uns64 MACC::acc_stack_duplicates = 0;
+
+unsigned MACC::pause_histogram::bucket_of
+	( min::uns64 ns )
+{
+    const min::uns64 SUB = 1 << PAUSE_SUB_BITS;
+    if ( ns < SUB ) return (unsigned) ns;
+    unsigned e = 63 - __builtin_clzll ( ns );
+    unsigned shift = e - PAUSE_SUB_BITS;
+    return ( ( shift + 1 ) << PAUSE_SUB_BITS )
+         + (unsigned) ( ( ns >> shift ) & ( SUB - 1 ) );
+}
+
+min::uns64 MACC::pause_histogram::bucket_floor
+	( unsigned i )
+{
+    const unsigned SUB = 1 << PAUSE_SUB_BITS;
+    if ( i < SUB ) return i;
+    unsigned shift = ( i >> PAUSE_SUB_BITS ) - 1;
+    return (min::uns64) ( SUB + ( i & ( SUB - 1 ) ) )
+           << shift;
+}
+
+void MACC::pause_histogram::record ( min::uns64 ns )
+{
+    ++ count;
+    total += ns;
+    if ( ns > max ) max = ns;
+    ++ buckets[bucket_of ( ns )];
+}
+
+min::uns64 MACC::pause_histogram::percentile
+	( double p ) const
+{
+    if ( count == 0 ) return 0;
+    min::uns64 n = (min::uns64) ( p * count / 100 );
+    if ( n < p * count / 100 ) ++ n;
+    if ( n == 0 ) n = 1;
+    min::uns64 sum = 0;
+    for ( unsigned i = 0; i < PAUSE_BUCKETS; ++ i )
+    {
+        sum += buckets[i];
+	if ( sum < n ) continue;
+	if ( i + 1 == PAUSE_BUCKETS ) return max;
+	min::uns64 upper = bucket_floor ( i + 1 ) - 1;
+	return upper < max ? upper : max;
+    }
+    return max;
+}
+
+// Names and members of the counters struct, for
+// print_acc_statistics_json/csv.
+//
+static struct counter_field
+{
+    const char * name;
+    min::uns64 MACC::counters::* member;
+} counter_fields[] =
+{
+    { "collectible_inited",
+      & MACC::counters::collectible_inited },
+    { "root_inited", & MACC::counters::root_inited },
+    { "acc_hash_inited",
+      & MACC::counters::acc_hash_inited },
+    { "scanned", & MACC::counters::scanned },
+    { "stub_scanned", & MACC::counters::stub_scanned },
+    { "scavenged", & MACC::counters::scavenged },
+    { "thrash", & MACC::counters::thrash },
+    { "root_kept", & MACC::counters::root_kept },
+    { "root_removed", & MACC::counters::root_removed },
+    { "acc_hash_collected",
+      & MACC::counters::acc_hash_collected },
+    { "acc_hash_kept",
+      & MACC::counters::acc_hash_kept },
+    { "aux_hash_collected",
+      & MACC::counters::aux_hash_collected },
+    { "aux_hash_kept",
+      & MACC::counters::aux_hash_kept },
+    { "collected", & MACC::counters::collected },
+    { "kept", & MACC::counters::kept },
+    { "hash_moved", & MACC::counters::hash_moved },
+    { "promoted", & MACC::counters::promoted },
+    { "evacuated", & MACC::counters::evacuated }
+};
+static const unsigned NUMBER_OF_COUNTER_FIELDS =
+    sizeof ( counter_fields )
+    / sizeof ( counter_fields[0] );
+
+// Names and members of the level increment statistics.
+//
+static struct level_field
+{
+    const char * name;
+    min::uns64 MACC::level::* member;
+} level_fields[] =
+{
+    { "increments", & MACC::level::increments },
+    { "max_scanned", & MACC::level::max_scanned },
+    { "max_scavenged", & MACC::level::max_scavenged },
+    { "max_collected", & MACC::level::max_collected }
+};
+static const unsigned NUMBER_OF_LEVEL_FIELDS =
+    sizeof ( level_fields ) / sizeof ( level_fields[0] );
+
+// Pause histograms and their names, and the percent-
+// iles output for each.
+//
+static struct pause_field
+{
+    const char * name;
+    MACC::pause_histogram * histogram;
+} pause_fields[] =
+{
+    { "collector_increment",
+      & MACC::collector_increment_pauses },
+    { "acc_interrupt", & MACC::acc_interrupt_pauses }
+};
+static const unsigned NUMBER_OF_PAUSE_FIELDS =
+    sizeof ( pause_fields ) / sizeof ( pause_fields[0] );
+
+static struct percentile_field
+{
+    const char * name;
+    double p;
+} percentile_fields[] =
+{
+    { "p50", 50 }, { "p90", 90 }, { "p99", 99 },
+    { "p999", 99.9 }
+};
+static const unsigned NUMBER_OF_PERCENTILE_FIELDS =
+    sizeof ( percentile_fields )
+    / sizeof ( percentile_fields[0] );
+
+void MACC::print_acc_statistics_json ( std::ostream & s )
+{
+    stop_mutators_lock stop;
+    s << "{" << endl << "  \"levels\": [";
+    for ( unsigned L = 0;
+          L <= MACC::ephemeral_levels; ++ L )
+    {
+	MACC::level & lev = levels[L];
+	s << ( L == 0 ? "" : "," ) << endl
+	  << "    { \"level\": " << L << ","
+	  << endl << "      \"count\": {";
+	for ( unsigned i = 0;
+	      i < NUMBER_OF_COUNTER_FIELDS; ++ i )
+	    s << ( i == 0 ? " " : ", " )
+	      << "\"" << counter_fields[i].name
+	      << "\": "
+	      << lev.count.*counter_fields[i].member;
+	s << " },";
+	for ( unsigned i = 0;
+	      i < NUMBER_OF_LEVEL_FIELDS; ++ i )
+	    s << endl << "      \""
+	      << level_fields[i].name << "\": "
+	      << lev.*level_fields[i].member << ",";
+	s << endl << "      \"phases\": {";
+	bool first = true;
+	for ( unsigned p = 0;
+	      p < MACC::NUMBER_OF_PHASES; ++ p )
+	{
+	    if ( lev.phase_increments[p] == 0 )
+	        continue;
+	    s << ( first ? "" : "," ) << endl
+	      << "        \"" << MACC::phase_name[p]
+	      << "\": { \"increments\": "
+	      << lev.phase_increments[p]
+	      << ", \"ns\": " << lev.phase_ns[p]
+	      << " }";
+	    first = false;
+	}
+	s << ( first ? "" : "\n      " ) << "} }";
+    }
+    s << " ]," << endl
+      << "  \"acc_stack\": { \"high_water\": "
+      << MACC::acc_stack_high_water
+      << ", \"interrupts\": "
+      << MACC::acc_interrupts
+      << ", \"rescans\": "
+      << MACC::acc_stack_rescans
+      << ", \"duplicates\": "
+      << MACC::acc_stack_duplicates << " }," << endl
+      << "  \"pauses\": {";
+    for ( unsigned i = 0;
+          i < NUMBER_OF_PAUSE_FIELDS; ++ i )
+    {
+	MACC::pause_histogram & h =
+	    * pause_fields[i].histogram;
+        s << ( i == 0 ? "" : "," ) << endl
+	  << "    \"" << pause_fields[i].name
+	  << "\": { \"count\": " << h.count
+	  << ", \"total\": " << h.total
+	  << ", \"max\": " << h.max;
+	for ( unsigned j = 0;
+	      j < NUMBER_OF_PERCENTILE_FIELDS; ++ j )
+	    s << ", \"" << percentile_fields[j].name
+	      << "\": "
+	      << h.percentile ( percentile_fields[j].p );
+	s << " }";
+    }
+    s << " }" << endl << "}" << endl;
+}
+
+void MACC::print_acc_statistics_csv ( std::ostream & s )
+{
+    stop_mutators_lock stop;
+    s << "record,name,field,value" << endl;
+    for ( unsigned L = 0;
+          L <= MACC::ephemeral_levels; ++ L )
+    {
+	MACC::level & lev = levels[L];
+	for ( unsigned i = 0;
+	      i < NUMBER_OF_COUNTER_FIELDS; ++ i )
+	    s << "level," << L << ","
+	      << counter_fields[i].name << ","
+	      << lev.count.*counter_fields[i].member
+	      << endl;
+	for ( unsigned i = 0;
+	      i < NUMBER_OF_LEVEL_FIELDS; ++ i )
+	    s << "level," << L << ","
+	      << level_fields[i].name << ","
+	      << lev.*level_fields[i].member << endl;
+	for ( unsigned p = 0;
+	      p < MACC::NUMBER_OF_PHASES; ++ p )
+	{
+	    if ( lev.phase_increments[p] == 0 )
+	        continue;
+	    s << "phase," << L << "."
+	      << MACC::phase_name[p] << ",increments,"
+	      << lev.phase_increments[p] << endl
+	      << "phase," << L << "."
+	      << MACC::phase_name[p] << ",ns,"
+	      << lev.phase_ns[p] << endl;
+	}
+    }
+    s << "acc_stack,,high_water,"
+      << MACC::acc_stack_high_water << endl
+      << "acc_stack,,interrupts,"
+      << MACC::acc_interrupts << endl
+      << "acc_stack,,rescans,"
+      << MACC::acc_stack_rescans << endl
+      << "acc_stack,,duplicates,"
+      << MACC::acc_stack_duplicates << endl;
+    for ( unsigned i = 0;
+          i < NUMBER_OF_PAUSE_FIELDS; ++ i )
+    {
+	MACC::pause_histogram & h =
+	    * pause_fields[i].histogram;
+	const char * name = pause_fields[i].name;
+	s << "pauses," << name << ",count,"
+	  << h.count << endl
+	  << "pauses," << name << ",total,"
+	  << h.total << endl
+	  << "pauses," << name << ",max,"
+	  << h.max << endl;
+	for ( unsigned j = 0;
+	      j < NUMBER_OF_PERCENTILE_FIELDS; ++ j )
+	    s << "pauses," << name << ","
+	      << percentile_fields[j].name << ","
+	      << h.percentile ( percentile_fields[j].p )
+	      << endl;
+    }
 }
 
 ostream & operator <<
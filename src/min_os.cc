@@ -27,6 +27,7 @@ extern "C" {
 #   include <unistd.h>
 #   include <errno.h>
 #   include <sys/mman.h>
+#   include <fcntl.h>
 #   include <execinfo.h>
 }
 # define MUP min::unprotected
@@ -192,6 +193,62 @@ min::uns64 MOS::virtualsize ( void )
     return saved_virtualsize;
 }
 
+bool MOS::use_huge_pages = false;
+
+// Transparent huge pages are available if the kernel
+// reports their size and they are not disabled.
+//
+static min::unsptr saved_hugepagesize;
+static bool hugepagesize_read = false;
+inline min::unsptr hugepagesize ( void )
+{
+    if ( hugepagesize_read ) return saved_hugepagesize;
+    hugepagesize_read = true;
+
+    const char * dir = "/sys/kernel/mm/transparent_hugepage";
+    char name[100], line[100];
+    sprintf ( name, "%s/enabled", dir );
+    ifstream enabled ( name );
+    if ( ! enabled
+         ||
+	 ! enabled.getline ( line, 100 )
+	 ||
+	 strstr ( line, "[never]" ) != NULL )
+        return 0;
+
+    sprintf ( name, "%s/hpage_pmd_size", dir );
+    ifstream size ( name );
+    min::uns64 value;
+    if ( ! ( size >> value )
+         ||
+	 value <= ::pagesize()
+	 ||
+	 ( value & ( value - 1 ) ) != 0 )
+        return 0;
+
+    saved_hugepagesize = (min::unsptr) value;
+    return saved_hugepagesize;
+}
+min::uns64 MOS::hugepagesize ( void )
+{
+    return ::hugepagesize();
+}
+
+// If use_huge_pages, advise the OS to back the whole
+// huge pages of a segment with huge pages.  Mapping a
+// segment with mmap loses any previous advice, so this
+// is called after each such mapping.  Small segments
+// are advised too, as adjacent segments with the same
+// advice are merged by the OS.  Advice failure is
+// ignored, as the segment still works with normal
+// pages.
+//
+inline void advise_huge ( void * start, min::unsptr size )
+{
+    if ( ! MOS::use_huge_pages ) return;
+    madvise ( start, (size_t) size, MADV_HUGEPAGE );
+}
+
 // new_poolXX error messages:
 //
 static const unsigned pool_limit = 4;
@@ -532,37 +589,31 @@ static void dump_compare_pools ( void )
 // Find the lowest address not less than `begin' that
 // either ends a used pool or equals `begin', has size
 // unused bytes following it, and preceeds some used
-// pool.
+// pool.  Used_pools must be as read by read_used_pools,
+// which is sorted by address, so one pass suffices.
+// Address 0 is never returned, as callers take NULL
+// to mean no space was found, so the search starts at
+// least one page up.
 //
 static void * find_unused
     ( void * begin, min::unsptr size )
 {
-    void * best = NULL;
-    for ( int i = -1; i < (int) used_pools_count; ++ i )
+    char * next = (char *) begin;
+    if ( next < (char *) ::pagesize() )
+        next = (char *) ::pagesize();
+    for ( unsigned i = 0; i < used_pools_count; ++ i )
     {
-        void * next =
-	    ( i == -1 ? begin : used_pools[i].end );
-	if ( next < begin ) continue;
-	if ( best != NULL && best < next ) continue;
-	void * end = (void *) ( (char *) next + size );
-	if ( end < next ) continue;
+	char * end = next + size;
+	if ( end < next ) return NULL;
 	    // Wraparound check.
 
-	bool above_found = false;
-	int j;
-	for ( j = 0; j < (int) used_pools_count; ++ j )
-	{
-	    if ( j == i ) continue;
-	    if ( used_pools[j].start >= end )
-	        above_found = true;
-	    else if ( used_pools[j].end > next )
-	        break;
-	}
-	if (    above_found
-	     && j == (int) used_pools_count )
-	    best = next;
+	if ( (char *) used_pools[i].end <= next )
+	    continue;
+	if ( (char *) used_pools[i].start >= end )
+	    return next;
+	next = (char *) used_pools[i].end;
     }
-    return best;
+    return NULL;
 }
 
 // Execute new_pool_at without tracing.
@@ -615,9 +666,288 @@ static void * new_pool_at_internal
 	offset += increment;
     }
 
+    advise_huge ( start, size );
     return start;
 }
 
+// Address Space Reservation
+//
+// The reservation is a single PROT_NONE segment from
+// reserve_begin to reserve_end.  Its unallocated parts
+// are kept in free_ranges, sorted by address, with no
+// two ranges adjacent.  A pool is allocated from the
+// reservation by removing its pages from a free range
+// and mapping them readable and writable, and freed by
+// mapping them PROT_NONE and returning them to free_
+// ranges.  None of this reads /proc/<process-id>/maps.
+
+// Reservation size in bytes, or 0 if there is no
+// reservation.  Set from the `reserve_size' parameter
+// by reserve_init, which is first called when the
+// first pool is allocated.
+//
+static min::unsptr reserve_size = MIN_OS_RESERVE_SIZE;
+static bool reserve_inited = false;
+static char * reserve_begin = NULL;
+static char * reserve_end = NULL;
+
+static struct free_range
+{
+    char * start, * end;
+} * free_ranges;
+static unsigned free_ranges_count;
+    // Current number of free_ranges.
+static unsigned free_ranges_size;
+    // Current limit on free_ranges vector index.
+
+static void reserve_init ( void )
+{
+    if ( reserve_inited ) return;
+    reserve_inited = true;
+
+    const char * p =
+        MOS::get_parameter ( "reserve_size" );
+    if ( p != NULL )
+    {
+	char * q;
+	reserve_size = strtoull ( p, & q, 0 );
+	if ( * q && ! isspace ( * q ) )
+	{
+	    cout << "ERROR: bad reserve_size program"
+	            " parameter value" << endl;
+	    exit ( 1 );
+	}
+    }
+
+    // Leave most of the address space limit to pools
+    // that are not in the reservation.
+    //
+    if ( reserve_size > MOS::virtualsize() / 4 )
+        reserve_size = MOS::virtualsize() / 4;
+    reserve_size &= ~ ( ::pagesize() - 1 );
+    if ( reserve_size == 0 ) return;
+
+    void * result =
+        mmap ( NULL, (size_t) reserve_size,
+	       PROT_NONE,
+	       MAP_PRIVATE | MAP_ANONYMOUS
+	                   | MAP_NORESERVE,
+	       -1, 0 );
+    if ( result == MAP_FAILED )
+    {
+	// Run without a reservation.
+	//
+        reserve_size = 0;
+	return;
+    }
+
+    reserve_begin = (char *) result;
+    reserve_end = reserve_begin + reserve_size;
+    free_ranges_size = 100;
+    free_ranges = new free_range[free_ranges_size];
+    free_ranges[0].start = reserve_begin;
+    free_ranges[0].end = reserve_end;
+    free_ranges_count = 1;
+}
+
+// Return true if the segment is inside the reservation.
+//
+inline bool in_reserve
+	( void * start, min::unsptr size )
+{
+    return reserve_size != 0
+           &&
+	   (char *) start >= reserve_begin
+	   &&
+	   (char *) start + size <= reserve_end;
+}
+
+// Return the index of the first free range whose end
+// is above address.  Returns free_ranges_count if
+// there is none.
+//
+static unsigned free_range_above ( char * address )
+{
+    unsigned lo = 0, hi = free_ranges_count;
+    while ( lo < hi )
+    {
+        unsigned mid = ( lo + hi ) / 2;
+	if ( free_ranges[mid].end <= address )
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    return lo;
+}
+
+// Open a hole at index i of free_ranges by moving the
+// entries at and after i up one place.
+//
+static void free_ranges_open ( unsigned i )
+{
+    if ( free_ranges_count >= free_ranges_size )
+    {
+	free_range * new_free_ranges =
+	    new free_range[free_ranges_size + 100];
+	memcpy ( new_free_ranges, free_ranges,
+		   free_ranges_count
+		 * sizeof ( free_range ) );
+	delete [] free_ranges;
+	free_ranges = new_free_ranges;
+	free_ranges_size += 100;
+    }
+    memmove ( free_ranges + i + 1,
+	      free_ranges + i,
+		( free_ranges_count - i )
+	      * sizeof ( free_range ) );
+    ++ free_ranges_count;
+}
+
+// Remove the segment from start to end from free range
+// i, which must contain it.
+//
+static void free_range_remove
+	( unsigned i, char * start, char * end )
+{
+    free_range & r = free_ranges[i];
+    if ( r.start == start && r.end == end )
+    {
+	memmove ( free_ranges + i,
+	          free_ranges + i + 1,
+		    ( free_ranges_count - i - 1 )
+		  * sizeof ( free_range ) );
+	-- free_ranges_count;
+    }
+    else if ( r.start == start )
+        r.start = end;
+    else if ( r.end == end )
+        r.end = start;
+    else
+    {
+	free_ranges_open ( i );
+	free_ranges[i].end = start;
+	free_ranges[i+1].start = end;
+    }
+}
+
+// Allocate a pool of size bytes from the reservation
+// that is at or above begin and, if end != NULL, below
+// end.  The lowest such address is used.  Return NULL
+// if there is no such space.
+//
+static void * reserve_allocate
+	( min::unsptr size, void * begin, void * end )
+{
+    reserve_init();
+    if ( reserve_size == 0 ) return NULL;
+
+    char * b = (char *) begin;
+    min::unsptr mask = ::pagesize() - 1;
+    b = (char *) ( ( (min::unsptr) b + mask ) & ~ mask );
+    if ( b < reserve_begin ) b = reserve_begin;
+
+    for ( unsigned i = free_range_above ( b );
+          i < free_ranges_count; ++ i )
+    {
+        char * start = free_ranges[i].start;
+	if ( start < b ) start = b;
+	if ( MOS::use_huge_pages
+	     &&
+	     size >= ::hugepagesize() )
+	{
+	    // Align so whole huge pages can be used.
+	    //
+	    min::unsptr hmask = ::hugepagesize() - 1;
+	    start = (char *)
+	        ( ( (min::unsptr) start + hmask )
+		  & ~ hmask );
+	}
+	if ( end != NULL && start + size > end )
+	    return NULL;
+	if ( start + size > free_ranges[i].end )
+	    continue;
+
+	void * result =
+	    new_pool_at_internal ( size, start );
+	if ( MOS::pool_error ( result ) != NULL )
+	    return result;
+	free_range_remove ( i, start, start + size );
+	return result;
+    }
+    return NULL;
+}
+
+// Allocate a pool of size bytes at start, which must
+// be in the reservation.  Return error(1) if some of
+// the pool is already allocated.
+//
+static void * reserve_allocate_at
+	( min::unsptr size, void * start )
+{
+    char * s = (char *) start;
+    unsigned i = free_range_above ( s );
+    if ( i == free_ranges_count
+         ||
+	 free_ranges[i].start > s
+	 ||
+	 free_ranges[i].end < s + size )
+        return error(1);
+
+    void * result = new_pool_at_internal ( size, s );
+    if ( MOS::pool_error ( result ) == NULL )
+	free_range_remove ( i, s, s + size );
+    return result;
+}
+
+// Return a pool of size bytes at start, which must be
+// in the reservation, to the reservation.
+//
+static void reserve_free
+	( min::unsptr size, void * start )
+{
+    char * s = (char *) start;
+    char * e = s + size;
+
+    void * result =
+        mmap ( s, (size_t) size, PROT_NONE,
+	       MAP_FIXED | MAP_PRIVATE
+	                 | MAP_ANONYMOUS
+	                 | MAP_NORESERVE,
+	       -1, 0 );
+    if ( result == MAP_FAILED )
+	fatal_error ( errno );
+
+    unsigned i = free_range_above ( s );
+    assert ( i == free_ranges_count
+             ||
+	     free_ranges[i].start >= e );
+    bool join_below =
+        ( i > 0 && free_ranges[i-1].end == s );
+    bool join_above =
+        (    i < free_ranges_count
+	  && free_ranges[i].start == e );
+
+    if ( join_below && join_above )
+    {
+        free_ranges[i-1].end = free_ranges[i].end;
+	memmove ( free_ranges + i,
+	          free_ranges + i + 1,
+		    ( free_ranges_count - i - 1 )
+		  * sizeof ( free_range ) );
+	-- free_ranges_count;
+    }
+    else if ( join_below )
+        free_ranges[i-1].end = e;
+    else if ( join_above )
+        free_ranges[i].start = s;
+    else
+    {
+	free_ranges_open ( i );
+	free_ranges[i].start = s;
+	free_ranges[i].end = e;
+    }
+}
+
 inline void prolog
 	( const char * action, bool force_read = false )
 {
@@ -674,12 +1004,21 @@ void * MOS::new_pool_at
 	exit ( 2 );
     }
 
-    prolog ( "ALLOCATION", true );
+    reserve_init();
+    void * result;
+    if ( in_reserve ( start, size ) )
+    {
+	prolog ( "ALLOCATION" );
+	result = reserve_allocate_at ( size, start );
+    }
+    else
+    {
+	prolog ( "ALLOCATION", true );
 
-    if ( overlap ( start, end ) ) return error(1);
+	if ( overlap ( start, end ) ) return error(1);
 
-    void * result =
-        new_pool_at_internal ( size, start );
+	result = new_pool_at_internal ( size, start );
+    }
 
     postlog ( "ALLOCATED", result, pages );
 
@@ -703,19 +1042,25 @@ void * MOS::new_pool_between
     min::unsptr size =
         (min::unsptr) pages * ::pagesize();
 
-    prolog ( "ALLOCATION", true );
-
-    void * address = find_unused ( begin, size );
-    errno = 0;
-    if ( address == NULL )
-        return error(3);
-    if ( end != NULL 
-         &&
-	 (void *) ( (char *) address + size ) > end )
-        return error(3);
+    prolog ( "ALLOCATION" );
 
     void * result =
-        new_pool_at_internal ( size, address );
+        reserve_allocate ( size, begin, end );
+    if ( result == NULL )
+    {
+	read_used_pools();
+
+	void * address = find_unused ( begin, size );
+	errno = 0;
+	if ( address == NULL )
+	    return error(3);
+	if ( end != NULL 
+	     &&
+	     (void *) ( (char *) address + size ) > end )
+	    return error(3);
+
+	result = new_pool_at_internal ( size, address );
+    }
 
     postlog ( "ALLOCATED", result, pages );
 
@@ -733,16 +1078,26 @@ void * MOS::new_pool ( min::uns64 pages )
     min::unsptr size =
         (min::unsptr) pages * ::pagesize();
 
-    void * result;
+    prolog ( "ALLOCATION" );
 
-    if ( size <= max_mmap_size )
+    void * result =
+        reserve_allocate ( size, NULL, NULL );
+
+    if ( result == NULL && size <= max_mmap_size )
     {
     	// As an optimization, call mmap directly if
 	// size is not too large.
 
-	prolog ( "ALLOCATION" );
+	// If huge pages are used, allocate extra so
+	// the pool can start on a huge page boundary.
+	//
+	min::unsptr extra = 0;
+	if ( use_huge_pages
+	     &&
+	     size >= ::hugepagesize() )
+	    extra = ::hugepagesize() - ::pagesize();
 
-	result = mmap ( NULL, (size_t) size,
+	result = mmap ( NULL, (size_t) ( size + extra ),
     			PROT_READ | PROT_WRITE,
 			MAP_PRIVATE | MAP_ANONYMOUS,
 			-1, 0 );
@@ -767,10 +1122,29 @@ void * MOS::new_pool ( min::uns64 pages )
 		   " not on a page boundary" << endl;
 	    exit ( 2 );
 	}
+
+	if ( extra != 0 )
+	{
+	    min::unsptr hmask = ::hugepagesize() - 1;
+	    min::unsptr head =
+	          ( - (min::unsptr) result ) & hmask;
+	    if ( head > 0
+	         &&
+		 munmap ( result, (size_t) head ) == -1 )
+		fatal_error ( errno );
+	    result = (char *) result + head;
+	    if ( extra > head
+	         &&
+		    munmap ( (char *) result + size,
+		             (size_t) ( extra - head ) )
+		 == -1 )
+		fatal_error ( errno );
+	    advise_huge ( result, size );
+	}
     }
-    else
+    else if ( result == NULL )
     {
-	prolog ( "ALLOCATION", true );
+	read_used_pools();
 
 	void * address = find_unused ( NULL, size );
 	errno = 0;
@@ -807,9 +1181,9 @@ void MOS::free_pool
 
     prolog ( "DEALLOCATION" );
 
-    int result = munmap ( start, (size_t) size );
-
-    if ( result == -1 )
+    if ( in_reserve ( start, size ) )
+        reserve_free ( size, start );
+    else if ( munmap ( start, (size_t) size ) == -1 )
 	fatal_error ( errno );
 
     postlog ( "DEALLOCATED", start, pages );
@@ -839,6 +1213,23 @@ void MOS::purge_pool
 
     prolog ( "PURGING" );
 
+    // If huge pages are used, only whole huge pages are
+    // purged, so that huge pages are not split.  This
+    // is allowed as the contents of purged pages are
+    // undefined.
+    //
+    void * original_start = start;
+    if ( use_huge_pages && ::hugepagesize() != 0 )
+    {
+	min::unsptr hmask = ::hugepagesize() - 1;
+        min::unsptr b = (min::unsptr) start;
+	min::unsptr e = b + size;
+	b = ( b + hmask ) & ~ hmask;
+	e = e & ~ hmask;
+	start = (void *) b;
+	size = ( b < e ? e - b : 0 );
+    }
+
     min::unsptr offset = 0;
     while ( offset < size )
     {
@@ -862,8 +1253,9 @@ void MOS::purge_pool
 
 	offset += increment;
     }
+    advise_huge ( start, size );
 
-    postlog ( "PURGING", start, pages );
+    postlog ( "PURGING", original_start, pages );
 }
 
 inline void remap
@@ -895,6 +1287,9 @@ inline void renew
 	fatal_error ( errno );
 
     assert ( result == start );
+
+    if ( protection != PROT_NONE )
+        advise_huge ( start, size );
 }
 
 void MOS::move_pool
@@ -1085,3 +1480,55 @@ bool MOS::file_size ( min::uns64 & file_size,
     file_size = s.st_size;
     return true;
 }
+
+static const char empty_file_map[1] = { 0 };
+const char * MOS::map_file ( min::uns64 & file_size,
+			     const char * file_name,
+			     char error_message[512] )
+{
+    int fd = open ( file_name, O_RDONLY );
+    if ( fd < 0 )
+    {
+        ::strcpy ( error_message, strerror ( errno ) );
+	return NULL;
+    }
+
+    struct stat s;
+    if ( fstat ( fd, & s ) < 0 )
+    {
+        ::strcpy ( error_message, strerror ( errno ) );
+	close ( fd );
+	return NULL;
+    }
+    file_size = s.st_size;
+    if ( file_size == 0 )
+    {
+	close ( fd );
+        return ::empty_file_map;
+    }
+
+    void * result = mmap ( NULL, (size_t) file_size,
+                           PROT_READ, MAP_PRIVATE,
+			   fd, 0 );
+    if ( result == MAP_FAILED )
+    {
+        ::strcpy ( error_message, strerror ( errno ) );
+	close ( fd );
+	return NULL;
+    }
+    close ( fd );
+
+    // Files are normally read front to back.
+    //
+    madvise ( result, (size_t) file_size,
+              MADV_SEQUENTIAL );
+
+    return (const char *) result;
+}
+
+void MOS::unmap_file ( const char * map,
+		       min::uns64 file_size )
+{
+    if ( file_size == 0 ) return;
+    munmap ( (void *) map, (size_t) file_size );
+}
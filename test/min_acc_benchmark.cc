@@ -0,0 +1,175 @@
+// MIN Allocator/Collector/Compactor Benchmark
+//
+// File:	min_acc_benchmark.cc
+// Author:	Bob Walton (walton@acm.org)
+// Date:	Sat Oct 17 09:00:00 EDT 2026
+//
+// The authors have placed this program in the public
+// domain; they make no warranty and accept no liability
+// for this program.
+
+// Table of Contents:
+//
+//	Setup
+//	Heap
+//	Benchmarks
+//	Main Program
+
+// Setup
+// -----
+
+// This program is run by `make benchmark' once with
+// MIN_CONFIG="huge_pages=0" and once with MIN_CONFIG=
+// "huge_pages=1", and the outputs compared.  It is not
+// part of `make test' as its output is timing depen-
+// dent.
+
+# include <iostream>
+# include <iomanip>
+# include <fstream>
+# include <cstdlib>
+# include <cstring>
+# include <ctime>
+using std::cout;
+using std::endl;
+using std::setw;
+
+# define MIN_ASSERT MIN_ASSERT_CALL_ON_FAIL
+# include <min.h>
+# include <min_acc.h>
+# include <min_os.h>
+# define MUP min::unprotected
+# define MINT min::internal
+# define MACC min::acc
+# define MOS min::os
+
+// Heap
+// ----
+
+// Number of objects in the heap, and number of
+// pointers to other objects in each object.
+//
+const unsigned N = 400000;
+const unsigned POINTERS = 12;
+
+// Number of collections timed.
+//
+const unsigned REPEAT = 5;
+
+static unsigned random_uns32 ( void )
+{
+    static unsigned long long x = 12345;
+    x = x * 6364136223846793005ull
+      + 1442695040888963407ull;
+    return (unsigned) ( x >> 33 );
+}
+
+// Make N objects, each pointing at POINTERS objects
+// chosen at random, so the collector touches the stub
+// region and the body regions in random order, as it
+// does for large heaps.
+//
+static void make_heap ( min::gen v )
+{
+    min::obj_vec_insptr vp ( v );
+    for ( unsigned i = 0; i < N; ++ i )
+	min::attr_push(vp) =
+	    min::new_obj_gen ( POINTERS );
+    for ( unsigned i = 0; i < N; ++ i )
+    {
+	min::obj_vec_insptr ep ( min::attr ( vp, i ) );
+	for ( unsigned j = 0; j < POINTERS; ++ j )
+	    min::attr_push(ep) =
+	        min::attr ( vp, random_uns32() % N );
+    }
+}
+
+// Benchmarks
+// ----------
+
+static double seconds ( clock_t begin )
+{
+    return (double) ( clock() - begin )
+         / CLOCKS_PER_SEC;
+}
+
+// Print the AnonHugePages line of /proc/self/smaps_
+// rollup, if there is one.
+//
+static void print_huge_pages ( void )
+{
+    std::ifstream in ( "/proc/self/smaps_rollup" );
+    char line[200];
+    while ( in.getline ( line, 200 ) )
+    {
+	if ( strncmp ( line, "AnonHugePages:", 14 )
+	     == 0 )
+	{
+	    const char * p = line + 14;
+	    while ( * p == ' ' ) ++ p;
+	    cout << setw ( 30 ) << "huge pages in use:"
+	         << setw ( 12 ) << p << endl;
+	}
+    }
+}
+
+static void benchmark ( void )
+{
+    min::locatable_gen v;
+    v = min::new_obj_gen ( N );
+
+    clock_t begin = clock();
+    make_heap ( v );
+    cout << setw ( 30 ) << "heap build:"
+         << setw ( 12 ) << std::fixed
+	 << std::setprecision ( 2 )
+	 << seconds ( begin ) << " seconds" << endl;
+
+    // Promote the heap to level 0 so the timed
+    // collections scavenge all of it.
+    //
+    for ( int L = MACC::ephemeral_levels; L >= 0; -- L )
+	MACC::collect ( L );
+
+    MACC::level & lev = MACC::levels[0];
+    min::uns64 scanned = lev.count.scanned;
+    min::uns64 scavenged = lev.count.scavenged;
+    begin = clock();
+    for ( unsigned r = 0; r < REPEAT; ++ r )
+	MACC::collect ( 0 );
+    double time = seconds ( begin );
+    scanned = lev.count.scanned - scanned;
+    scavenged = lev.count.scavenged - scavenged;
+
+    cout << setw ( 30 ) << "level 0 collection:"
+         << setw ( 12 ) << std::fixed
+	 << std::setprecision ( 3 )
+	 << time / REPEAT << " seconds" << endl;
+    cout << setw ( 30 ) << "values scanned:"
+         << setw ( 12 ) << std::fixed
+	 << std::setprecision ( 1 )
+	 << ( scanned / time ) / 1e6
+	 << " million/second" << endl;
+    cout << setw ( 30 ) << "stubs scavenged:"
+         << setw ( 12 ) << std::fixed
+	 << std::setprecision ( 1 )
+	 << ( scavenged / time ) / 1e6
+	 << " million/second" << endl;
+    print_huge_pages();
+}
+
+// Main Program
+// ---- -------
+
+int main ()
+{
+    min::initialize();
+
+    cout << "huge_pages = " << MACC::huge_pages
+         << " (huge page size "
+	 << MOS::hugepagesize() << "): " << N
+	 << " objects with " << POINTERS
+	 << " pointers each" << endl;
+
+    benchmark();
+}
@@ -14,6 +14,7 @@
 //	Setup
 //	ACC Interface Test
 //	ACC Garbage Collector Test
+//	ACC Hash Table Resize Test
 
 // Setup
 // -----
@@ -22,6 +23,12 @@
 # include <iomanip>
 # include <cstdlib>
 # include <cstring>
+# include <sstream>
+# include <fstream>
+# include <string>
+# if MIN_MUTATOR_THREADS
+#   include <pthread.h>
+# endif
 using std::cout;
 using std::endl;
 using std::hex;
@@ -49,6 +56,32 @@ void test_acc_interface ( void )
     min::unsptr sbase = MUP::acc_stubs_allocated;
     cout << "initial stubs allocated = "
 	 << sbase << endl;
+#   if MIN_MUTATOR_THREADS
+	// Stubs come from the thread's stub buffer,
+	// precede the last_allocated_stub, and are
+	// counted when the buffer is refilled.
+	//
+	min::stub * stub1 = MUP::new_acc_stub();
+	min::stub * stub2 = MUP::new_acc_stub();
+	MIN_CHECK ( stub1 != MINT::last_allocated_stub );
+	MIN_CHECK ( stub2 != MINT::last_allocated_stub );
+	MIN_CHECK
+	    ( min::type_of ( stub1 ) == min::ACC_FREE );
+	MIN_CHECK
+	    ( min::type_of ( stub2 ) == min::ACC_FREE );
+
+	min::unsptr free_stubs =
+	    MINT::number_of_free_stubs;
+	MINT::acc_expand_stub_free_list
+	    ( free_stubs + 2 );
+	MIN_CHECK (    MINT::number_of_free_stubs
+		    >= free_stubs + 2 );
+
+	min::stub * stub3 = MUP::new_acc_stub();
+	min::stub * stub4 = MUP::new_acc_stub();
+	MIN_CHECK (    MUP::acc_stubs_allocated
+	            <= sbase + 4 );
+#   else
     min::stub * stub1 = MUP::new_acc_stub();
     MIN_CHECK ( stub1 == MINT::last_allocated_stub );
     MIN_CHECK ( MUP::acc_stubs_allocated == sbase + 1 );
@@ -74,6 +107,7 @@ void test_acc_interface ( void )
     MIN_CHECK ( MUP::acc_stubs_allocated == sbase + 4 );
     MIN_CHECK
 	( stub4 == MINT::last_allocated_stub );
+#   endif
 
 
     cout << endl;
@@ -163,19 +197,14 @@ static min::uns32 random_uns32 ( void )
     return ( m_z << 16 ) + m_w;
 }
 
-// Create an object of size
-//
-//	2 + ( random_uns32() % m ).
-//
-// Set element j equal to j, fo j = 0, 1, ...
+// Create an object of the given size.  Set element j
+// equal to j, for j = 0, 1, ...
 //
-static min::gen create_object ( min::unsptr m )
+static min::gen create_sized_object ( min::unsptr size )
 {
     bool print_save = min::assert_print;
     min::assert_print = false;
 
-    min::unsptr size = 2 + random_uns32() % m;
-
     min::locatable_gen obj;
     obj = min::new_obj_gen ( size );
     min::obj_vec_insptr ep ( obj );
@@ -188,6 +217,18 @@ static min::gen create_object ( min::unsptr m )
     return obj;
 }
 
+// Create an object of size
+//
+//	2 + ( random_uns32() % m ).
+//
+// Set element j equal to j, fo j = 0, 1, ...
+//
+static min::gen create_object ( min::unsptr m )
+{
+    return create_sized_object
+        ( 2 + random_uns32() % m );
+}
+
 // Create an object that is a vector of n new objects
 // each created by calling create_object(m).
 //
@@ -323,6 +364,1369 @@ void test_acc_garbage_collector ( void )
          << endl;
 }
 
+// ACC Hash Table Resize Test
+//
+static void hash_test_str ( char * buffer, unsigned i )
+{
+    if ( i % 2 == 0 )
+        sprintf ( buffer, "h%u", i );
+    else
+        sprintf ( buffer, "hash table test %u", i );
+}
+
+void test_acc_hash_table_resize ( void )
+{
+    cout << endl;
+    cout << "Start ACC Hash Table Resize Test!" << endl;
+
+    try {
+
+	min::unsptr n =
+	    4 * MIN_DEFAULT_STR_HASH_SIZE
+	      * MIN_DEFAULT_HASH_MAX_LOAD;
+	min::unsptr initial_size = MINT::str_hash_size;
+	cout << "initial string hash table size = "
+	     << initial_size << endl;
+
+	char buffer[100];
+	min::locatable_gen v;
+	v = min::new_obj_gen ( n );
+	{
+	    min::obj_vec_insptr vp ( v );
+	    for ( unsigned i = 0; i < n; ++ i )
+	    {
+		hash_test_str ( buffer, i );
+		min::attr_push(vp) =
+		    min::new_str_gen ( buffer );
+	    }
+	}
+
+	// Resizing is done by collector increments,
+	// even when no collection is running.
+	//
+	unsigned increments = 0;
+	while ( ( MINT::str_acc_hash_old != NULL
+	          ||
+		     MINT::str_hash_count
+		  >    MACC::hash_max_load
+		     * MINT::str_hash_size )
+		&&
+		increments < 100000 )
+	{
+	    MACC::collector_increment ( 0 );
+	    ++ increments;
+	}
+	MIN_CHECK
+	    ( MINT::str_hash_size > initial_size );
+	cout << "final string hash table size = "
+	     << MINT::str_hash_size << endl;
+	MIN_CHECK
+	    ( MINT::str_acc_hash_old == NULL );
+	MIN_CHECK
+	    (    MINT::str_hash_count
+	      <= MACC::hash_max_load
+	         * MINT::str_hash_size );
+
+	bool print_save = min::assert_print;
+	min::assert_print = false;
+	bool checks = true;
+	min::obj_vec_ptr vp ( v );
+	for ( unsigned i = 0; i < n; ++ i )
+	{
+	    hash_test_str ( buffer, i );
+	    if (    min::attr ( vp, i )
+	         != min::new_str_gen ( buffer ) )
+	    {
+		cout << "FAILURE: string " << i
+		     << " not found in resized"
+		        " hash table" << endl;
+	        checks = false;
+		break;
+	    }
+	}
+	min::assert_print = print_save;
+	MIN_CHECK ( checks );
+
+	MIN_CHECK
+	    (    ::teststr
+	      == min::new_str_gen
+	                ( "this is a test str" ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Hash Table Resize Test!"
+         << endl;
+}
+
+// ACC Compactor Test
+//
+// Return the number of bytes allocated to blocks,
+// used or free, in paged body regions, and set free
+// to the number of bytes in free blocks.
+//
+static min::uns64 paged_body_bytes ( min::uns64 & free )
+{
+    min::uns64 used = 0;
+    free = 0;
+    MACC::region * last = MACC::last_paged_body_region;
+    if ( last == NULL ) return 0;
+    MACC::region * r = last;
+    do
+    {
+        r = r->region_next;
+	used += r->next - r->begin;
+	free += r->free_size;
+    } while ( r != last );
+    return used;
+}
+
+void test_acc_compactor ( void )
+{
+    cout << endl;
+    cout << "Start ACC Compactor Test!" << endl;
+
+    try {
+
+	// Objects with this many elements have paged
+	// bodies.
+	//
+	const min::unsptr paged_n =
+	    MINT::max_fixed_block_size / 8 + 1000;
+	const unsigned N = 20;
+
+	min::locatable_gen v;
+	v = min::new_obj_gen ( N );
+	{
+	    min::obj_vec_insptr vp ( v );
+	    for ( unsigned i = 0; i < N; ++ i )
+		min::attr_push(vp) =
+		    create_sized_object ( paged_n );
+	}
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+
+	bool print_save = min::assert_print;
+	min::assert_print = false;
+
+	// Deallocate every other object.
+	//
+	{
+	    min::obj_vec_updptr vp ( v );
+	    for ( unsigned i = 0; i < N; i += 2 )
+	    {
+		min::deallocate
+		    ( MUP::stub_of
+		          ( min::attr ( vp, i ) ) );
+		min::attr ( vp, i ) =
+		    create_sized_object ( 10 );
+	    }
+	}
+
+	min::assert_print = print_save;
+
+	min::uns64 free_before, free_after;
+	min::uns64 used_before =
+	    paged_body_bytes ( free_before );
+	MIN_CHECK ( free_before > 0 );
+
+	// Allocate and then free enough 128K byte
+	// fixed size blocks to fill several subregions.
+	//
+	const unsigned M = 3 * MACC::subregion_size
+	                 / ( 1 << 17 ) + 10;
+	min::locatable_gen w;
+	w = min::new_obj_gen ( M );
+	min::assert_print = false;
+	{
+	    min::obj_vec_insptr wp ( w );
+	    for ( unsigned i = 0; i < M; ++ i )
+		min::attr_push(wp) =
+		    min::new_obj_gen ( 12000 );
+	    for ( unsigned i = 0; i < M; ++ i )
+	    {
+		min::deallocate
+		    ( MUP::stub_of
+		          ( min::attr ( wp, i ) ) );
+		min::attr ( wp, i ) = min::NONE();
+	    }
+	}
+
+	min::assert_print = print_save;
+
+	MACC::compact();
+
+	min::uns64 used_after =
+	    paged_body_bytes ( free_after );
+	MIN_CHECK ( free_after == 0 );
+	MIN_CHECK
+	    ( used_after == used_before - free_before );
+	MIN_CHECK ( MACC::compactor_bytes_moved > 0 );
+	MIN_CHECK ( MACC::compactor_subregions_freed >= 2 );
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+
+	// New paged bodies reuse the compacted space.
+	//
+	min::locatable_gen x;
+	x = create_sized_object ( paged_n );
+	paged_body_bytes ( free_after );
+	MIN_CHECK ( free_after == 0 );
+	MIN_CHECK
+	    (    paged_body_bytes ( free_after )
+	      <  used_before );
+
+	MIN_CHECK
+	    (    ::teststr
+	      == min::new_str_gen
+	                ( "this is a test str" ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Compactor Test!"
+         << endl;
+}
+
+// ACC Evacuation Test
+//
+// Return the number of elements of object vector v
+// whose bodies are in fixed size blocks.
+//
+static min::unsptr fixed_bodies ( min::gen v )
+{
+    min::unsptr count = 0;
+    min::obj_vec_ptr vp ( v );
+    for ( min::unsptr i = 0;
+          i < min::attr_size_of ( vp ); ++ i )
+    {
+	min::stub * s =
+	    MUP::stub_of ( min::attr ( vp, i ) );
+	if (   MUP::control_of ( s )
+	     & MINT::ACC_FIXED_BODY_FLAG )
+	    ++ count;
+    }
+    return count;
+}
+
+void test_acc_evacuation ( void )
+{
+    cout << endl;
+    cout << "Start ACC Evacuation Test!" << endl;
+
+    try {
+
+	min::locatable_gen v;
+	v = create_vec_of_objects ( 100, 30 );
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+
+	bool print_save = min::assert_print;
+	min::assert_print = false;
+	MIN_CHECK ( fixed_bodies ( v ) == 100 );
+	min::assert_print = print_save;
+
+	// Collect until the objects are promoted to
+	// level 0, which evacuates their bodies from
+	// fixed size blocks.
+	//
+	unsigned rounds = 0;
+	while ( fixed_bodies ( v ) > 0 && rounds < 20 )
+	{
+	    for ( unsigned L = MACC::ephemeral_levels;
+	          L > 0; -- L )
+		MACC::collect ( L );
+	    ++ rounds;
+	}
+	MIN_CHECK ( fixed_bodies ( v ) == 0 );
+	MIN_CHECK ( MACC::levels[1].count.evacuated
+	            >= 100 );
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+
+	cout << "After Evacuation" << endl;
+	MACC::print_acc_statistics ( cout );
+
+	MIN_CHECK
+	    (    ::teststr
+	      == min::new_str_gen
+	                ( "this is a test str" ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Evacuation Test!"
+         << endl;
+}
+
+// ACC Full Collection Test
+//
+void test_acc_full_collection ( void )
+{
+    cout << endl;
+    cout << "Start ACC Full Collection Test!" << endl;
+
+    try {
+
+	min::locatable_gen v;
+	v = create_vec_of_objects ( 1000, 30 );
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+
+	// Level 0 scavenging is done by the marker
+	// threads if compiled with MIN_PARALLEL_MARKERS.
+	//
+	MACC::collect ( 0 );
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+
+	MIN_CHECK
+	    (    ::teststr
+	      == min::new_str_gen
+	                ( "this is a test str" ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Full Collection Test!"
+         << endl;
+}
+
+// ACC Stub Region Test
+//
+void test_acc_stub_region ( void )
+{
+    cout << endl;
+    cout << "Start ACC Stub Region Test!" << endl;
+
+    try {
+
+	MIN_CHECK (    MACC::stub_next
+	            <= MACC::stub_commit_end );
+
+	// Allocate many stubs at the end of the stub
+	// region and then make them garbage.
+	//
+	{
+	    min::locatable_gen w;
+	    w = create_vec_of_objects ( 20000, 4 );
+	}
+	min::stub * next_before = MACC::stub_next;
+	MIN_CHECK (    MACC::stub_next
+	            <= MACC::stub_commit_end );
+
+	MACC::collect ( 0 );
+	MACC::compact();
+	MIN_CHECK ( MACC::stub_next < next_before );
+	MIN_CHECK
+	    ( MACC::compactor_stub_pages_freed > 0 );
+	MIN_CHECK (    MACC::stub_next
+	            <= MACC::stub_commit_end );
+
+	// The freed part of the stub region is reused.
+	//
+	min::locatable_gen v;
+	v = create_vec_of_objects ( 20000, 4 );
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+	MIN_CHECK (    MACC::stub_next
+	            <= MACC::stub_commit_end );
+	MACC::collect ( 0 );
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+
+	MIN_CHECK
+	    (    ::teststr
+	      == min::new_str_gen
+	                ( "this is a test str" ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Stub Region Test!"
+         << endl;
+}
+
+// ACC Statistics Test
+//
+void test_acc_statistics ( void )
+{
+    cout << endl;
+    cout << "Start ACC Statistics Test!" << endl;
+
+    try {
+
+	// Histogram buckets bound their values to
+	// within 1/8'th.
+	//
+	bool bounded = true;
+	for ( min::uns64 ns = 1; ns < ( 1ull << 40 );
+	      ns = 3 * ns + 1 )
+	{
+	    unsigned i =
+	        MACC::pause_histogram::bucket_of ( ns );
+	    min::uns64 floor =
+	        MACC::pause_histogram::bucket_floor ( i );
+	    min::uns64 ceiling =
+	        MACC::pause_histogram::bucket_floor
+		    ( i + 1 );
+	    if ( floor > ns || ns >= ceiling
+	         ||
+		 8 * ( ceiling - floor ) > floor + 8 )
+	        bounded = false;
+	}
+	MIN_CHECK ( bounded );
+
+	static MACC::pause_histogram h;
+	for ( min::uns64 ns = 1; ns <= 1000; ++ ns )
+	    h.record ( ns );
+	MIN_CHECK ( h.count == 1000 );
+	MIN_CHECK ( h.max == 1000 );
+	MIN_CHECK ( h.total == 500500 );
+	MIN_CHECK ( h.percentile ( 50 ) >= 500 );
+	MIN_CHECK ( h.percentile ( 50 ) < 500 + 500 / 8 );
+	MIN_CHECK ( h.percentile ( 99 ) >= 990 );
+	MIN_CHECK ( h.percentile ( 100 ) == 1000 );
+
+	// Collector statistics.
+	//
+	MACC::level & lev = MACC::levels[0];
+	min::uns64 increments = lev.increments;
+	min::uns64 pauses =
+	    MACC::collector_increment_pauses.count;
+	MACC::collect ( 0 );
+	MIN_CHECK ( lev.increments > increments );
+	MIN_CHECK (    MACC::collector_increment_pauses
+	                   .count
+		    >= pauses + lev.increments
+		              - increments );
+	MIN_CHECK ( lev.max_scanned > 0 );
+	MIN_CHECK ( lev.max_scanned <= lev.count.scanned );
+	MIN_CHECK
+	    (    lev.phase_increments
+	             [MACC::COLLECTOR_START]
+	      > 0 );
+	MIN_CHECK ( MACC::acc_interrupts > 0 );
+
+	std::ostringstream json;
+	MACC::print_acc_statistics_json ( json );
+	MIN_CHECK ( json.str()[0] == '{' );
+	MIN_CHECK (    json.str().find ( "\"levels\"" )
+	            != std::string::npos );
+	MIN_CHECK (    json.str().find
+	                   ( "\"COLLECTOR_START\"" )
+	            != std::string::npos );
+	MIN_CHECK (    json.str().find
+	                   ( "\"collector_increment\"" )
+	            != std::string::npos );
+
+	std::ostringstream csv;
+	MACC::print_acc_statistics_csv ( csv );
+	MIN_CHECK (    csv.str().find
+	                   ( "record,name,field,value\n" )
+	            == 0 );
+	MIN_CHECK (    csv.str().find
+	                   ( "\nlevel,0,increments," )
+	            != std::string::npos );
+	MIN_CHECK (    csv.str().find
+	                   ( "\nphase,0.COLLECTOR_START,ns," )
+	            != std::string::npos );
+	MIN_CHECK (    csv.str().find
+	                   ( "\npauses,acc_interrupt,p99," )
+	            != std::string::npos );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Statistics Test!"
+         << endl;
+}
+
+// ACC Pacing Test
+//
+void test_acc_pacing ( void )
+{
+    cout << endl;
+    cout << "Start ACC Pacing Test!" << endl;
+
+    min::uns64 scan_limit = MACC::scan_limit;
+    min::uns64 scavenge_limit = MACC::scavenge_limit;
+    min::uns64 collection_limit =
+        MACC::collection_limit;
+    min::uns64 allocation_budget =
+        MACC::allocation_budget;
+
+    try {
+
+	// The pause target is so long that limits
+	// move toward their maximums regardless of
+	// timing, so the trace output is repeatable.
+	//
+	MACC::pause_target = 1000000;
+	MACC::allocation_budget = 100;
+
+	MACC::collect ( 0 );
+	MIN_CHECK ( MACC::scan_limit > scan_limit );
+	MIN_CHECK ( MACC::scan_limit <= 1 << 30 );
+	MIN_CHECK
+	    ( MACC::scavenge_limit > scavenge_limit );
+	MIN_CHECK ( MACC::scavenge_limit <= 1 << 30 );
+
+	// Exhausting the allocation budget renewed by
+	// MACC::collect schedules an interrupt, which
+	// the next min::interrupt check takes, and which
+	// starts a collection of the youngest level.
+	// Later interrupts run it.
+	//
+	MACC::level & young =
+	    MACC::levels[MACC::ephemeral_levels];
+	min::uns64 increments = young.increments;
+	min::uns64 limit = MINT::acc_budget_limit;
+	MIN_CHECK (    limit
+	            ==   MUP::acc_stubs_allocated
+		       + MACC::allocation_budget );
+	MIN_CHECK ( ! min::pending() );
+#	if MIN_MUTATOR_THREADS
+	    // Stubs are counted when the stub buffer is
+	    // refilled, so that is when the exhausted
+	    // budget is found.
+	    //
+	    while ( ! min::pending() )
+		min::new_obj_gen ( 1 );
+	    MIN_CHECK ( MUP::acc_stubs_allocated >= limit );
+#	else
+	    while ( MUP::acc_stubs_allocated + 1 < limit )
+		min::new_obj_gen ( 1 );
+	    MIN_CHECK ( ! min::pending() );
+	    min::new_obj_gen ( 1 );
+	    MIN_CHECK ( min::pending() );
+#	endif
+	MIN_CHECK ( min::interrupt() );
+	MIN_CHECK ( young.increments > increments );
+	min::locatable_gen v;
+	v = create_vec_of_objects ( 2000, 4 );
+	// The bound is large because with a sweep thread
+	// the collection cannot finish until that thread
+	// has been scheduled.
+	//
+	for ( unsigned i = 0; i < 10000000; ++ i )
+	{
+	    if (    young.collector_phase
+	         == MACC::COLLECTOR_NOT_RUNNING )
+	        break;
+	    MINT::acc_interrupt();
+	}
+	MIN_CHECK (    young.collector_phase
+	            == MACC::COLLECTOR_NOT_RUNNING );
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    MACC::pause_target = 0;
+    MACC::scan_limit = scan_limit;
+    MACC::scavenge_limit = scavenge_limit;
+    MACC::collection_limit = collection_limit;
+    MACC::allocation_budget = allocation_budget;
+
+    cout << endl;
+    cout << "Finish ACC Pacing Test!"
+         << endl;
+}
+
+// ACC Fixed Block Run Test
+//
+// Return true if this thread has a fixed block run.
+//
+static bool fixed_block_runs_exist ( void )
+{
+    for ( unsigned j = 0;
+          j < MINT::number_fixed_block_lists; ++ j )
+    {
+	MINT::fixed_block_run * run =
+	    MINT::fixed_block_runs + j;
+	if ( run->next != run->end )
+	    return true;
+    }
+    return false;
+}
+
+void test_acc_fixed_block_runs ( void )
+{
+    cout << endl;
+    cout << "Start ACC Fixed Block Run Test!" << endl;
+
+    try {
+
+	// Never used fixed size blocks are allocated
+	// from runs, and the rest of each run is
+	// returned to its region at the end of each
+	// collection.
+	//
+	min::locatable_gen v;
+	v = create_vec_of_objects ( 20000, 4 );
+	MIN_CHECK ( fixed_block_runs_exist() );
+	MACC::collect ( 0 );
+	MIN_CHECK ( ! fixed_block_runs_exist() );
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+
+	min::locatable_gen w;
+	w = create_vec_of_objects ( 1000, 4 );
+	MACC::collect ( 0 );
+	MIN_CHECK ( check_vec_of_objects ( v ) );
+	MIN_CHECK ( check_vec_of_objects ( w ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Fixed Block Run Test!"
+         << endl;
+}
+
+// Packed vector type whose bodies fill their blocks.
+//
+static min::packed_vec<min::uns32> filled_vec_type
+    ( "filled_vec_type" );
+
+// Characters that fill packed char vectors in the
+// packed vector growth test.
+//
+static char char_vec_data[1 << 22];
+
+// Return true if packed vector v has length n and
+// holds the first n characters of char_vec_data.
+//
+static bool check_char_vec
+	( min::packed_vec_ptr<char> v, unsigned n )
+{
+    const char * p = (const char *) MUP::ptr_of ( v )
+                   + min::packed_vec<char>
+		         ::computed_header_size;
+    return v->length == n
+           &&
+	   memcmp ( p, char_vec_data, n ) == 0;
+}
+
+void test_acc_packed_vec_growth ( void )
+{
+    cout << endl;
+    cout << "Start ACC Packed Vector Growth Test!"
+         << endl;
+
+    try {
+
+	// A packed vector whose body is the last block
+	// of a paged body region grows in place.
+	//
+	const unsigned n =
+	    4 * MINT::max_fixed_block_size;
+	min::locatable_gen g;
+	g = min::char_packed_vec_type.new_gen ( n );
+	min::packed_vec_insptr<char> pv ( g );
+	for ( unsigned i = 0; i <= n; ++ i )
+	    char_vec_data[i] = (char) ( i % 251 );
+	min::push ( pv, n, char_vec_data );
+	const void * p = MUP::ptr_of ( pv );
+	min::push ( pv, 1, char_vec_data + n );
+	MIN_CHECK ( MUP::ptr_of ( pv ) == p );
+	MIN_CHECK ( pv->max_length > n );
+	MIN_CHECK ( check_char_vec ( pv, n + 1 ) );
+
+	// A packed vector that is not the last block
+	// is moved, and large paged bodies are moved
+	// by remapping their pages.
+	//
+	min::locatable_gen h;
+	h = min::char_packed_vec_type.new_gen ( n );
+	min::reserve ( pv, pv->max_length );
+	MIN_CHECK ( MUP::ptr_of ( pv ) != p );
+	MIN_CHECK ( check_char_vec ( pv, n + 1 ) );
+	MACC::collect ( 0 );
+	MIN_CHECK ( check_char_vec ( pv, n + 1 ) );
+
+	// A type with fill_body set grows to fill the
+	// block its body is allocated in.
+	//
+	filled_vec_type.fill_body = true;
+	min::locatable_gen f;
+	f = filled_vec_type.new_gen ( 10 );
+	min::packed_vec_insptr<min::uns32> fv ( f );
+	min::uns32 e[11] =
+	    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	min::push ( fv, 11, e );
+	min::unsptr size =
+	      filled_vec_type.computed_header_size
+	    + fv->max_length * sizeof ( min::uns32 );
+	MIN_CHECK ( fv->max_length > 15 );
+	MIN_CHECK
+	    (   size + sizeof ( min::uns32 )
+	      > MUP::optimal_body_size ( size ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Packed Vector Growth Test!"
+         << endl;
+}
+
+void test_acc_bulk_push ( void )
+{
+    cout << endl;
+    cout << "Start ACC Bulk Push Test!" << endl;
+
+    try {
+
+	// Objects are moved in bulk from t to x between
+	// the increments of a collection, so some are
+	// stored in x after x is scavenged but before
+	// they are marked.  The write barrier pass of
+	// each bulk push must keep them.  Pushes alter-
+	// nate between copying from a C++ vector and
+	// copying directly from the body of t.
+	//
+	const unsigned n = 2000, k = 5;
+	min::locatable_gen t, x;
+	t = create_vec_of_objects ( n, 10 );
+	x = min::new_obj_gen ( n );
+
+	min::gen buffer[k];
+	bool from_body = false;
+	bool print_save = min::assert_print;
+	min::assert_print = false;
+	MACC::levels[0].collector_phase =
+	    MACC::COLLECTOR_START;
+	while (    MACC::levels[0].collector_phase
+	        != MACC::COLLECTOR_NOT_RUNNING )
+	{
+	    {
+		min::obj_vec_insptr tp ( t );
+		min::obj_vec_insptr xp ( x );
+		min::unsptr b = min::attr_size_of ( tp );
+		min::unsptr m = b < k ? b : k;
+		b -= m;
+		if ( from_body )
+		    min::attr_push
+			( xp, m,
+			  min::begin_ptr_of ( tp ) + b );
+		else
+		{
+		    for ( min::unsptr i = 0; i < m; ++ i )
+			buffer[i] = min::attr ( tp, b + i );
+		    min::attr_push ( xp, m, buffer );
+		}
+		for ( min::unsptr i = b; i < b + m; ++ i )
+		    min::attr ( tp, i ) = min::NONE();
+		min::attr_pop ( tp, m );
+		from_body = ! from_body;
+	    }
+
+	    unsigned L = MACC::collector_increment ( 0 );
+	    if ( L != 0 ) MACC::collect ( L );
+	}
+	{
+	    min::obj_vec_insptr tp ( t );
+	    min::obj_vec_insptr xp ( x );
+	    min::unsptr m = min::attr_size_of ( tp );
+	    min::attr_push
+		( xp, m, min::begin_ptr_of ( tp ) );
+	    min::attr_pop ( tp, m );
+	}
+	min::assert_print = print_save;
+	MACC::collect ( 0 );
+
+	{
+	    min::obj_vec_ptr xp ( x );
+	    MIN_CHECK ( min::attr_size_of ( xp ) == n );
+	    min::assert_print = false;
+	    bool all_objects = true;
+	    for ( min::unsptr i = 0; i < n; ++ i )
+	    {
+		if ( ! min::is_obj ( min::attr ( xp, i ) ) )
+		    all_objects = false;
+	    }
+	    min::assert_print = print_save;
+	    MIN_CHECK ( all_objects );
+	}
+	MIN_CHECK ( check_vec_of_objects ( x ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Bulk Push Test!" << endl;
+}
+
+void test_acc_rescan ( void )
+{
+    cout << endl;
+    cout << "Start ACC Rescan Test!" << endl;
+
+    try {
+
+	// As in the bulk push test objects are moved
+	// from t to x between the increments of a col-
+	// lection, but one at a time and each stored
+	// twice, so the acc stack holds many pairs, some
+	// duplicates, with the same source x.  Process_
+	// acc_stack should skip the duplicates and put x
+	// back on the to-be-scavenged list.
+	//
+	const unsigned n = 2000, k = 40;
+	min::locatable_gen t, x;
+	t = create_vec_of_objects ( n, 10 );
+	x = min::new_obj_gen ( n );
+
+	min::uns64 rescans = MACC::acc_stack_rescans;
+	min::uns64 duplicates =
+	    MACC::acc_stack_duplicates;
+	bool print_save = min::assert_print;
+	min::assert_print = false;
+	MACC::levels[0].collector_phase =
+	    MACC::COLLECTOR_START;
+	while (    MACC::levels[0].collector_phase
+	        != MACC::COLLECTOR_NOT_RUNNING )
+	{
+	    {
+		min::obj_vec_insptr tp ( t );
+		min::obj_vec_insptr xp ( x );
+		min::unsptr b = min::attr_size_of ( tp );
+		min::unsptr m = b < k ? b : k;
+		b -= m;
+		for ( min::unsptr i = b; i < b + m; ++ i )
+		{
+		    min::gen g = min::attr ( tp, i );
+		    min::attr_push ( xp ) = g;
+		    min::attr
+		        ( xp, min::attr_size_of ( xp ) - 1 )
+			= g;
+		    min::attr ( tp, i ) = min::NONE();
+		}
+		min::attr_pop ( tp, m );
+	    }
+
+	    unsigned L = MACC::collector_increment ( 0 );
+	    if ( L != 0 ) MACC::collect ( L );
+	}
+	{
+	    min::obj_vec_insptr tp ( t );
+	    min::obj_vec_insptr xp ( x );
+	    min::unsptr m = min::attr_size_of ( tp );
+	    min::attr_push
+		( xp, m, min::begin_ptr_of ( tp ) );
+	    min::attr_pop ( tp, m );
+	}
+	MACC::collect ( 0 );
+
+	{
+	    min::obj_vec_ptr xp ( x );
+	    bool all_objects =
+	        ( min::attr_size_of ( xp ) == n );
+	    for ( min::unsptr i = 0; i < n; ++ i )
+	    {
+		if ( ! min::is_obj ( min::attr ( xp, i ) ) )
+		    all_objects = false;
+	    }
+	    min::assert_print = print_save;
+	    MIN_CHECK ( all_objects );
+	}
+#	if ! MIN_PARALLEL_MARKERS
+	    MIN_CHECK
+	        ( MACC::acc_stack_rescans > rescans );
+	    MIN_CHECK
+		( MACC::acc_stack_duplicates > duplicates );
+#	else
+	    // With parallel markers level 0 scavenging
+	    // completes in one increment, so no pairs
+	    // are pushed.
+	    //
+	    MIN_CHECK
+	        ( MACC::acc_stack_rescans == rescans );
+	    MIN_CHECK
+		( MACC::acc_stack_duplicates == duplicates );
+#	endif
+	MIN_CHECK ( check_vec_of_objects ( x ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Rescan Test!" << endl;
+}
+
+// Put a list of the n values in the aux area of new
+// object x and then remove all but the last k, leaving
+// n - k NONE() values.  Return the aux area size.
+//
+static min::unsptr make_aux_garbage
+	( min::gen x, const min::gen * values,
+	  unsigned n, unsigned k )
+{
+    min::obj_vec_insptr xp ( x );
+    min::attr_push ( xp ) = min::EMPTY_SUBLIST();
+    min::list_insptr lp ( xp );
+    min::start_attr ( lp, 0 );
+    min::start_sublist ( lp );
+    min::insert_reserve ( lp, 1, n );
+    min::insert_before ( lp, values, n );
+    min::start_attr ( lp, 0 );
+    min::start_sublist ( lp );
+    min::remove ( lp, n - k );
+    return min::aux_size_of ( xp );
+}
+
+void test_acc_aux_compactor ( void )
+{
+    cout << endl;
+    cout << "Start ACC Aux Compactor Test!" << endl;
+
+    try {
+
+	const unsigned n = 500, k = 10;
+	min::gen values[n];
+	for ( unsigned i = 0; i < n; ++ i )
+	    values[i] = min::new_num_gen ( i );
+
+	// After a collection finishes, interrupts should
+	// advance an aux compactor pass that reorganizes
+	// w.
+	//
+	min::locatable_gen w;
+	w = min::new_obj_gen ( 10 );
+	min::unsptr aux_before =
+	    make_aux_garbage ( w, values, n, k );
+	MACC::collect ( 0 );
+	bool print_save = min::assert_print;
+	min::assert_print = false;
+	unsigned interrupts = 0;
+	while ( interrupts < 100000 )
+	{
+	    MINT::acc_stack_limit = MINT::acc_stack;
+	    MIN_CHECK ( min::interrupt() );
+	    ++ interrupts;
+	    min::obj_vec_ptr wp ( w );
+	    if ( min::aux_size_of ( wp ) < aux_before )
+	        break;
+	}
+	min::assert_print = print_save;
+	MIN_CHECK ( interrupts < 100000 );
+	{
+	    min::obj_vec_ptr wp ( w );
+	    min::list_ptr lp ( wp );
+	    min::start_attr ( lp, 0 );
+	    min::start_sublist ( lp );
+	    MIN_CHECK ( min::current ( lp ) == values[n-k] );
+	}
+
+	// MACC::compact should reorganize x.
+	//
+	min::locatable_gen x;
+	x = min::new_obj_gen ( 10 );
+	aux_before = make_aux_garbage ( x, values, n, k );
+
+	min::uns64 objects = MACC::aux_compactor_objects;
+	min::uns64 freed =
+	    MACC::aux_compactor_elements_freed;
+	MACC::compact();
+
+	min::obj_vec_ptr xp ( x );
+	MIN_CHECK ( min::aux_size_of ( xp ) < aux_before );
+	MIN_CHECK
+	    ( MACC::aux_compactor_objects > objects );
+	MIN_CHECK
+	    (    MACC::aux_compactor_elements_freed
+	      >= freed + ( n - k ) );
+
+	min::list_ptr lp ( xp );
+	min::start_attr ( lp, 0 );
+	min::start_sublist ( lp );
+	bool list_ok = true;
+	for ( unsigned i = n - k; i < n; ++ i )
+	{
+	    if ( min::current ( lp ) != values[i] )
+	        list_ok = false;
+	    min::next ( lp );
+	}
+	MIN_CHECK ( list_ok );
+	MIN_CHECK
+	    ( min::is_list_end ( min::current ( lp ) ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Aux Compactor Test!" << endl;
+}
+
+// ACC Freeze Test
+//
+void test_acc_freeze ( void )
+{
+    cout << endl;
+    cout << "Start ACC Freeze Test!" << endl;
+
+    try {
+
+	// A frozen object with thousands of names gets
+	// a perfect hash table that survives a collec-
+	// tion.
+	//
+	const unsigned N = 5000;
+	static min::gen names[N];
+	char buffer[40];
+	min::locatable_gen obj;
+	obj = min::new_obj_gen ( 3 * N, N );
+	bool print_save = min::assert_print;
+	min::assert_print = false;
+	for ( unsigned i = 0; i < N; ++ i )
+	{
+	    sprintf ( buffer, "frozen-name-%u", i );
+	    names[i] = min::new_str_gen ( buffer );
+	    min::set ( obj, names[i],
+	               min::new_num_gen ( i ) );
+	}
+	min::assert_print = print_save;
+
+	min::freeze ( obj );
+	MACC::collect ( 0 );
+
+	min::obj_vec_ptr vp ( obj );
+	MIN_CHECK ( min::frozen_flag_of ( vp ) );
+	MIN_CHECK ( min::public_flag_of ( vp ) );
+	MIN_CHECK ( min::hash_count_of ( vp ) == N );
+	MIN_CHECK ( min::hash_size_of ( vp ) >= N );
+	MIN_CHECK ( min::hash_size_of ( vp ) <= 2 * N );
+
+	// Every hash-list holds at most one name-
+	// descriptor pair, and every name is found.
+	//
+	bool one_pair = true;
+	bool found = true;
+	min::list_ptr lp ( vp );
+	for ( unsigned i = 0;
+	      i < min::hash_size_of ( vp ); ++ i )
+	{
+	    unsigned count = 0;
+	    for ( min::gen c = min::start_hash ( lp, i );
+		  ! min::is_list_end ( c );
+		  c = min::next ( lp ) )
+		++ count;
+	    if ( count > 2 ) one_pair = false;
+	}
+	min::attr_ptr ap ( vp );
+	for ( unsigned i = 0; i < N; ++ i )
+	{
+	    min::locate ( ap, names[i] );
+	    if (    min::get ( ap )
+	         != min::new_num_gen ( i ) )
+		found = false;
+	}
+	MIN_CHECK ( one_pair );
+	MIN_CHECK ( found );
+
+	min::locate
+	    ( ap, min::new_str_gen ( "frozen-name-X" ) );
+	MIN_CHECK ( min::get ( ap ) == min::NONE() );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Freeze Test!" << endl;
+}
+
+// ACC Mapped File Test
+//
+// Return true if a file whose name contains file_name
+// is mapped into memory.
+//
+static bool is_mapped ( const char * file_name )
+{
+    std::ifstream maps ( "/proc/self/maps" );
+    std::string line;
+    while ( std::getline ( maps, line ) )
+    {
+        if ( line.find ( file_name ) != std::string::npos )
+	    return true;
+    }
+    return false;
+}
+
+void test_acc_mapped_file ( void )
+{
+    cout << endl;
+    cout << "Start ACC Mapped File Test!" << endl;
+
+    const char * name = "min_acc_test_map.in";
+
+    try {
+
+	// Lines 0 through 9 are 7 bytes long with
+	// their line feeds, and the rest are 8.
+	//
+	{
+	    std::ofstream out ( name );
+	    for ( unsigned i = 0; i < 1000; ++ i )
+		out << "Line " << i << endl;
+	}
+
+	// Read part of the file with a one line spool.
+	// The 64 bit offset of the spooled line is its
+	// offset in the file.
+	//
+	{
+	    min::locatable_var<min::file> file;
+	    MIN_CHECK
+		( min::init_input_mapped_file
+		      ( file, min::new_str_gen ( name ),
+			NULL, 1 ) );
+	    MIN_CHECK ( is_mapped ( name ) );
+
+	    bool print_save = min::assert_print;
+	    min::assert_print = false;
+	    bool lines_ok = true;
+	    char buffer[40];
+	    for ( unsigned i = 0; i < 100; ++ i )
+	    {
+		min::uns32 offset =
+		    min::next_line ( file );
+		sprintf ( buffer, "Line %u", i );
+		if ( offset == min::NO_LINE
+		     ||
+		     strcmp ( buffer,
+			      ~ & file->buffer[offset] )
+		     != 0 )
+		    lines_ok = false;
+		min::flush_spool ( file );
+	    }
+	    min::assert_print = print_save;
+
+	    MIN_CHECK ( lines_ok );
+	    MIN_CHECK
+		( min::line ( file, 0 ) == min::NO_LINE );
+	    MIN_CHECK
+		(    min::line64 ( file, 98 )
+		  == min::NO_LINE64 );
+	    MIN_CHECK
+		(    min::line64 ( file, 99 )
+		  == 10 * 7 + 89 * 8 );
+	    MIN_CHECK
+		(    min::line64 ( file, 100 )
+		  == min::NO_LINE64 );
+	    MIN_CHECK ( ! min::file_is_complete ( file ) );
+	    MIN_CHECK ( file->map != NULL );
+	}
+
+	// The file is collected before all its input is
+	// read, which releases the map.
+	//
+	MACC::collect ( 0 );
+	MIN_CHECK ( ! is_mapped ( name ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    remove ( name );
+
+    cout << endl;
+    cout << "Finish ACC Mapped File Test!" << endl;
+}
+
+# if MIN_MUTATOR_THREADS
+
+// ACC Mutator Threads Test
+//
+const unsigned MUTATOR_THREADS = 4;
+const unsigned MUTATOR_OBJECTS = 2000;
+static bool mutator_thread_ok[MUTATOR_THREADS];
+
+// Return element i of the vector of thread t: an
+// object whose elements are the string "t:i", the
+// label made of that string and the number i, and the
+// number i.
+//
+static min::gen mutator_thread_element
+	( unsigned t, min::unsptr i )
+{
+    char buffer[40];
+    sprintf ( buffer, "%u:%u", t, (unsigned) i );
+    min::locatable_gen str, num, lab, obj;
+    str = min::new_str_gen ( buffer );
+    num = min::new_num_gen ( i );
+    min::gen elements[2] = { str, num };
+    lab = min::new_lab_gen ( elements, 2 );
+    obj = min::new_obj_gen ( 3 );
+    min::obj_vec_insptr ep ( obj );
+    min::attr_push(ep) = str;
+    min::attr_push(ep) = lab;
+    min::attr_push(ep) = num;
+    return obj;
+}
+
+// Return true if element i of the vector v of thread t
+// has the same strings, labels, and numbers as a new
+// element made by mutator_thread_element.  As these
+// are atoms, this checks the hash tables shared by the
+// threads.
+//
+static bool mutator_thread_check
+	( unsigned t, min::gen v, min::unsptr i )
+{
+    min::locatable_gen e;
+    e = mutator_thread_element ( t, i );
+    min::obj_vec_ptr vp ( v );
+    min::obj_vec_ptr ep1 ( min::attr ( vp, i ) );
+    min::obj_vec_ptr ep2 ( e );
+    if ( min::attr_size_of ( ep1 ) != 3 ) return false;
+    for ( min::unsptr j = 0; j < 3; ++ j )
+    {
+        if ( min::attr ( ep1, j ) != min::attr ( ep2, j ) )
+	    return false;
+    }
+    return true;
+}
+
+// Each thread builds a vector of objects in a locatable
+// variable at the same time as the other threads build
+// theirs, and then replaces random elements, collects,
+// and yields.  Collector increments run in whichever
+// thread's interrupt or collect stops the others.
+//
+static void * mutator_thread_main ( void * arg )
+{
+    unsigned t = (unsigned) (min::unsptr) arg;
+    min::mutator_thread context;
+    min::uns32 random = t + 1;
+
+    min::locatable_gen v, e;
+    v = min::new_obj_gen ( MUTATOR_OBJECTS );
+    for ( min::unsptr i = 0; i < MUTATOR_OBJECTS; ++ i )
+    {
+	e = mutator_thread_element ( t, i );
+	{
+	    min::obj_vec_insptr vp ( v );
+	    min::attr_push(vp) = e;
+	}
+	min::interrupt();
+    }
+
+    bool ok = true;
+    for ( unsigned round = 0; ok && round < 5; ++ round )
+    {
+	for ( unsigned k = 0; k < 500; ++ k )
+	{
+	    random = 1103515245 * random + 12345;
+	    min::unsptr i =
+	        ( random >> 8 ) % MUTATOR_OBJECTS;
+	    e = mutator_thread_element ( t, i );
+	    {
+		min::obj_vec_updptr vp ( v );
+		min::attr ( vp, i ) = e;
+	    }
+	    min::interrupt();
+	}
+	MACC::collect ( 0 );
+	min::mutator_yield();
+	for ( min::unsptr i = 0;
+	      ok && i < MUTATOR_OBJECTS; ++ i )
+	    ok = mutator_thread_check ( t, v, i );
+    }
+    mutator_thread_ok[t] = ok;
+    return NULL;
+}
+
+void test_acc_mutator_threads ( void )
+{
+    cout << endl;
+    cout << "Start ACC Mutator Threads Test!" << endl;
+
+    // Asserts are not printed, as the threads would
+    // interleave their output.
+    //
+    bool print_save = min::assert_print;
+    min::assert_print = false;
+
+    pthread_t threads[MUTATOR_THREADS];
+    for ( unsigned t = 0; t < MUTATOR_THREADS; ++ t )
+	pthread_create ( & threads[t], NULL,
+	                 mutator_thread_main,
+			 (void *) (min::unsptr) t );
+    {
+	min::mutator_unlock unlock;
+	for ( unsigned t = 0; t < MUTATOR_THREADS;
+	      ++ t )
+	    pthread_join ( threads[t], NULL );
+    }
+    min::assert_print = print_save;
+
+    try {
+
+	bool ok = true;
+	for ( unsigned t = 0; t < MUTATOR_THREADS;
+	      ++ t )
+	    ok = ok && mutator_thread_ok[t];
+	MIN_CHECK ( ok );
+	MIN_CHECK ( MINT::mutator_contexts->next
+	            == NULL );
+	MIN_CHECK
+	    (    ::teststr
+	      == min::new_str_gen
+	                ( "this is a test str" ) );
+
+    } catch ( min::assert_exception * x ) {
+        cout << "EXITING BECAUSE OF FAILED MIN_CHECK"
+	     << endl;
+	exit ( 1 );
+    }
+
+    cout << endl;
+    cout << "Finish ACC Mutator Threads Test!"
+         << endl;
+}
+
+# endif // MIN_MUTATOR_THREADS
+
 // Main Program
 // ---- -------
 
@@ -336,4 +1740,21 @@ int main ()
 
     test_acc_interface();
     test_acc_garbage_collector();
+    test_acc_hash_table_resize();
+    test_acc_compactor();
+    test_acc_evacuation();
+    test_acc_full_collection();
+    test_acc_stub_region();
+    test_acc_statistics();
+    test_acc_pacing();
+    test_acc_fixed_block_runs();
+    test_acc_packed_vec_growth();
+    test_acc_bulk_push();
+    test_acc_rescan();
+    test_acc_aux_compactor();
+    test_acc_freeze();
+    test_acc_mapped_file();
+#   if MIN_MUTATOR_THREADS
+	test_acc_mutator_threads();
+#   endif
 }
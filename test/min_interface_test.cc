@@ -353,6 +353,21 @@ void MUP::deallocate_body
     MUP::set_type_of ( s, min::DEALLOCATED );
 }
 
+// Bodies are never resized in place, and are always
+// copied.
+//
+bool MUP::resize_body_in_place
+	( min::stub * s, min::unsptr new_size,
+	                 min::unsptr old_size )
+{
+    return false;
+}
+void MUP::move_body_contents
+	( void * to, void * from, min::unsptr n )
+{
+    memcpy ( to, from, n );
+}
+
 // Function to relocate a body.  Just allocates a new
 // body, copies the contents of the old body to the
 // new body, and zeros the old body, and deallocates
@@ -2426,6 +2441,35 @@ void test_file ( void )
 		              [min::line(file1,1)] )
 	  == 0 );
 
+    // Lines of many lengths, so line ends fall at
+    // every position of the 16 and 32 character
+    // blocks scanned by load_string.
+    //
+    char lines[2000];
+    char * lp = lines;
+    for ( unsigned i = 0; i < 60; ++ i )
+    {
+        for ( unsigned j = 0; j < i; ++ j )
+	    * lp ++ = 'a' + j % 26;
+	* lp ++ = '\n';
+    }
+    * lp = 0;
+    min::locatable_var<min::file> file1a;
+    min::init_input_string ( file1a, lines );
+    MIN_CHECK ( file1a->file_lines == 60 );
+    bool lines_ok = true;
+    for ( unsigned i = 0; i < 60; ++ i )
+    {
+        min::uns32 offset = min::next_line ( file1a );
+	if (    offset == min::NO_LINE
+	     || ::strlen ( ~ & file1a->buffer[offset] )
+	        != i )
+	    lines_ok = false;
+    }
+    MIN_CHECK ( lines_ok );
+    MIN_CHECK
+        ( min::NO_LINE == min::next_line ( file1a ) );
+
     min::locatable_var<min::file> file2;
     min::init_input_named_file
         ( file2,
@@ -2445,6 +2489,34 @@ void test_file ( void )
     MIN_CHECK
         ( min::NO_LINE == min::next_line ( file2 ) );
 
+    min::locatable_var<min::file> file2m;
+    MIN_CHECK
+        ( min::init_input_mapped_file
+	      ( file2m,
+	        min::new_str_gen
+		    ( "min_interface_test_file.in" ),
+	        NULL, 1 ) );
+    MIN_CHECK ( ! min::file_is_complete ( file2m ) );
+    MIN_CHECK
+        (    strcmp ( "Line 0",
+	              ~ & file2m->buffer
+		              [min::next_line(file2m)] )
+	  == 0 );
+    MIN_CHECK
+        (    strcmp ( "Line 1",
+	              ~ & file2m->buffer
+		              [min::next_line(file2m)] )
+	  == 0 );
+    min::flush_spool ( file2m );
+    MIN_CHECK ( min::line ( file2m, 0 ) == min::NO_LINE );
+    MIN_CHECK ( min::line ( file2m, 1 ) == 0 );
+    MIN_CHECK ( min::line64 ( file2m, 1 ) == 7 );
+    MIN_CHECK
+        ( min::NO_LINE == min::next_line ( file2m ) );
+    MIN_CHECK ( min::file_is_complete ( file2m ) );
+    MIN_CHECK ( file2m->file_lines == 2 );
+    MIN_CHECK ( file2m->map == NULL );
+
     const char * data = "Line A\nLine B\nPartial Line";
     unsigned data_length = strlen ( data );
 
@@ -5038,6 +5110,316 @@ void test_object_attribute_short_cuts ( void )
     cout << "Finish Object Attribute Short-Cut Test!"
 	 << endl;
 }
+
+void test_attribute_cache ( void )
+{
+    cout << endl;
+    cout << "Start Attribute Cache Test!" << endl;
+
+    // The objects have hash size 1, so the attributes
+    // share one hash-list, and a cached name is not
+    // at the head of the list.
+    //
+    min::gen names[3] =
+        { min::new_str_gen ( "cache-attr-1" ),
+          min::new_str_gen ( "cache-attr-2" ),
+          min::new_str_gen ( "cache-attr-3" ) };
+    min::gen objs[4];
+    for ( unsigned i = 0; i < 4; ++ i )
+    {
+        objs[i] = min::new_obj_gen ( 100, 1 );
+	for ( unsigned j = 0; j < 3; ++ j )
+	    min::set ( objs[i], names[j],
+	               min::new_num_gen ( 10 * i + j ) );
+    }
+
+    min::attr_cache cache;
+    for ( unsigned i = 0; i < 4; ++ i )
+    {
+	min::obj_vec_ptr vp ( objs[i] );
+	min::attr_ptr ap ( vp );
+	min::locate ( ap, names[1], cache );
+	MIN_CHECK (    min::get ( ap )
+	            == min::new_num_gen ( 10 * i + 1 ) );
+    }
+    MIN_CHECK ( cache.misses == 1 );
+    MIN_CHECK ( cache.hits == 3 );
+    MIN_CHECK ( cache.pairs == 1 );
+
+    // Attributes set in a different order miss, and
+    // refill the cache.
+    //
+    min::gen reversed = min::new_obj_gen ( 100, 1 );
+    for ( unsigned j = 3; j > 0; -- j )
+	min::set ( reversed, names[j-1],
+		   min::new_num_gen ( j - 1 ) );
+    {
+	min::obj_vec_ptr vp ( objs[0] );
+	min::attr_ptr ap ( vp );
+	min::locate ( ap, names[2], cache );
+	MIN_CHECK
+	    ( min::get ( ap ) == min::new_num_gen ( 2 ) );
+	MIN_CHECK ( cache.pairs == 0 );
+    }
+    {
+	min::obj_vec_ptr vp ( reversed );
+	min::attr_ptr ap ( vp );
+	min::locate ( ap, names[2], cache );
+	MIN_CHECK
+	    ( min::get ( ap ) == min::new_num_gen ( 2 ) );
+	MIN_CHECK ( cache.pairs == 2 );
+    }
+    MIN_CHECK ( cache.misses == 3 );
+
+    // A missing attribute and a different hash size
+    // are not hits.
+    //
+    {
+	min::obj_vec_ptr vp ( objs[0] );
+	min::attr_ptr ap ( vp );
+	min::gen missing =
+	    min::new_str_gen ( "cache-attr-4" );
+	min::locate ( ap, missing, cache );
+	MIN_CHECK ( min::get ( ap ) == min::NONE() );
+	MIN_CHECK ( cache.name == names[2] );
+    }
+    {
+        min::gen obj = min::new_obj_gen ( 100, 7 );
+	min::set ( obj, names[2], names[0] );
+	min::obj_vec_ptr vp ( obj );
+	min::attr_ptr ap ( vp );
+	min::locate ( ap, names[2], cache );
+	MIN_CHECK ( min::get ( ap ) == names[0] );
+	MIN_CHECK ( cache.hash_size == 7 );
+    }
+    MIN_CHECK ( cache.misses == 5 );
+    MIN_CHECK ( cache.hits == 3 );
+
+    cout << endl;
+    cout << "Finish Attribute Cache Test!" << endl;
+}
+
+void test_freeze ( void )
+{
+    cout << endl;
+    cout << "Start Freeze Test!" << endl;
+
+    const unsigned N = 20;
+    min::gen names[N];
+    char buffer[40];
+    min::gen obj = min::new_obj_gen ( 500, 3 );
+    for ( unsigned i = 0; i < N; ++ i )
+    {
+        sprintf ( buffer, "frozen-attr-%u", i );
+	names[i] = min::new_str_gen ( buffer );
+	min::set ( obj, names[i], min::new_num_gen ( i ) );
+    }
+    min::gen lab = min::new_lab_gen ( names, 2 );
+    min::set ( obj, lab, names[0] );
+    min::gen missing =
+        min::new_str_gen ( "frozen-attr-missing" );
+
+    MIN_CHECK ( ! min::public_flag_of ( obj ) );
+    min::freeze ( obj );
+    MIN_CHECK ( min::public_flag_of ( obj ) );
+
+    min::obj_vec_ptr vp ( obj );
+    MIN_CHECK ( min::frozen_flag_of ( vp ) );
+    MIN_CHECK ( min::hash_size_of ( vp ) >= N );
+    MIN_CHECK ( min::hash_size_of ( vp ) <= 8 * N );
+
+    // Every hash-list holds at most one name-descriptor
+    // pair.
+    //
+    bool one_pair = true;
+    bool found = true;
+    min::assert_print = false;
+    min::list_ptr lp ( vp );
+    for ( unsigned i = 0; i < min::hash_size_of ( vp );
+	  ++ i )
+    {
+        min::unsptr count = 0;
+	for ( min::gen c = min::start_hash ( lp, i );
+	      ! min::is_list_end ( c );
+	      c = min::next ( lp ) )
+	    ++ count;
+	if ( count > 2 ) one_pair = false;
+    }
+    min::attr_ptr ap ( vp );
+    for ( unsigned i = 0; i < N; ++ i )
+    {
+	min::locate ( ap, names[i] );
+	if ( min::get ( ap ) != min::new_num_gen ( i ) )
+	    found = false;
+    }
+    min::assert_print = true;
+    MIN_CHECK ( one_pair );
+    MIN_CHECK ( found );
+
+    min::locate ( ap, lab );
+    MIN_CHECK ( min::get ( ap ) == names[0] );
+    min::locate ( ap, missing );
+    MIN_CHECK ( min::get ( ap ) == min::NONE() );
+    min::attr_cache cache;
+    min::locate ( ap, missing, cache );
+    MIN_CHECK ( min::get ( ap ) == min::NONE() );
+    min::locate ( ap, names[3], cache );
+    MIN_CHECK ( min::get ( ap ) == min::new_num_gen ( 3 ) );
+    MIN_CHECK ( cache.pairs == 0 );
+
+    cout << endl;
+    cout << "Finish Freeze Test!" << endl;
+}
+
+void test_grow_hash ( void )
+{
+    cout << endl;
+    cout << "Start Grow Hash Test!" << endl;
+
+    const unsigned N = 60;
+    min::gen names[N];
+    char buffer[40];
+    min::gen obj = min::new_obj_gen ( 500, 1 );
+    min::gen lab;
+    {
+	min::obj_vec_insptr vp ( obj );
+	MIN_CHECK ( ! min::grow_hash_flag_of ( vp ) );
+	min::set_grow_hash_flag_of ( vp );
+	MIN_CHECK ( min::grow_hash_flag_of ( vp ) );
+
+	min::attr_insptr ap ( vp );
+	min::attr_insptr ap0 ( vp );
+	min::assert_print = false;
+	for ( unsigned i = 0; i < N; ++ i )
+	{
+	    sprintf ( buffer, "grow-attr-%u", i );
+	    names[i] = min::new_str_gen ( buffer );
+	    min::locate ( ap, names[i] );
+	    min::set ( ap, min::new_num_gen ( i ) );
+	    MIN_CHECK (    min::get ( ap )
+	                == min::new_num_gen ( i ) );
+	    if ( i == 0 ) min::locate ( ap0, names[0] );
+	}
+	min::assert_print = true;
+	MIN_CHECK ( min::grow_hash_flag_of ( vp ) );
+	MIN_CHECK ( min::hash_size_of ( vp ) > 1 );
+	MIN_CHECK ( min::hash_count_of ( vp ) == N );
+
+	// Attribute pointers survive via min::relocate.
+	//
+	min::relocate ( ap0 );
+	MIN_CHECK (    min::get ( ap0 )
+	            == min::new_num_gen ( 0 ) );
+
+	lab = min::new_lab_gen ( names, 2 );
+	min::locate ( ap, lab );
+	min::set ( ap, names[1] );
+	MIN_CHECK ( min::get ( ap ) == names[1] );
+    }
+
+    // No hash-list is much longer than min::max_hash_
+    // chain, and every attribute is still found.
+    //
+    min::obj_vec_ptr vp ( obj );
+    bool short_lists = true;
+    bool found = true;
+    min::assert_print = false;
+    min::list_ptr lp ( vp );
+    for ( unsigned i = 0; i < min::hash_size_of ( vp );
+	  ++ i )
+    {
+        min::unsptr count = 0;
+	for ( min::gen c = min::start_hash ( lp, i );
+	      ! min::is_list_end ( c );
+	      c = min::next ( lp ) )
+	    ++ count;
+	if ( count > 4 * min::max_hash_chain )
+	    short_lists = false;
+    }
+    min::attr_ptr ap ( vp );
+    for ( unsigned i = 0; i < N; ++ i )
+    {
+	min::locate ( ap, names[i] );
+	if ( min::get ( ap ) != min::new_num_gen ( i ) )
+	    found = false;
+    }
+    min::assert_print = true;
+    MIN_CHECK ( short_lists );
+    MIN_CHECK ( found );
+    min::locate ( ap, lab );
+    MIN_CHECK ( min::get ( ap ) == names[1] );
+
+    cout << endl;
+    cout << "Finish Grow Hash Test!" << endl;
+}
+
+void test_sort_attr_info ( void )
+{
+    cout << endl;
+    cout << "Start Sort Attribute Info Test!" << endl;
+
+    // Names of every kind, including strings longer
+    // than 8 characters that agree in their first 8.
+    //
+    const char * strings[] =
+        { "b", "abcdefghij-2", "a", "abcdefgh",
+	  "abcdefghij-1", "abcdefgi", "abcdefghi" };
+    const unsigned S = sizeof ( strings )
+                     / sizeof ( strings[0] );
+    const unsigned N = S + 8;
+    min::locatable_gen names[N];
+    for ( unsigned i = 0; i < S; ++ i )
+        names[i] = min::new_str_gen ( strings[i] );
+    names[S+0] = min::new_num_gen ( 10 );
+    names[S+1] = min::new_num_gen ( -3.5 );
+    names[S+2] = min::new_num_gen ( 2 );
+    names[S+3] = min::new_num_gen ( -100 );
+    {
+	min::gen e[2] = { names[0], names[S+2] };
+	names[S+4] = min::new_lab_gen ( e, 2 );
+	e[1] = names[S+1];
+	names[S+5] = min::new_lab_gen ( e, 2 );
+	names[S+6] = min::new_lab_gen ( e, 1 );
+    }
+    names[S+7] = min::TRUE();
+
+    min::attr_info info[N];
+    min::reverse_attr_info rinfo[N];
+    for ( unsigned i = 0; i < N; ++ i )
+    {
+	info[i].name = names[i];
+	info[i].value = min::new_num_gen ( i );
+	rinfo[i].name = names[i];
+	rinfo[i].value = min::new_num_gen ( i );
+    }
+    min::sort_attr_info ( info, N );
+    min::sort_reverse_attr_info ( rinfo, N );
+
+    bool sorted = true;
+    for ( unsigned i = 0; i + 1 < N; ++ i )
+    {
+        if ( min::compare
+	         ( info[i].name, info[i+1].name ) >= 0 )
+	    sorted = false;
+        if ( rinfo[i].name != info[i].name )
+	    sorted = false;
+    }
+    bool values_kept = true;
+    for ( unsigned i = 0; i < N; ++ i )
+    {
+        unsigned j = (unsigned)
+	    min::float_of ( info[i].value );
+	if ( names[j] != info[i].name )
+	    values_kept = false;
+    }
+    MIN_CHECK ( sorted );
+    MIN_CHECK ( values_kept );
+    MIN_CHECK ( info[0].name == names[S+3] );
+    MIN_CHECK ( info[N-1].name == min::TRUE() );
+
+    cout << endl;
+    cout << "Finish Sort Attribute Info Test!" << endl;
+}
 
 // Object Printing
 // ------ --------
@@ -5706,6 +6088,10 @@ int main ( int argc, const char * argv[] )
 	test_object_list_level();
 	test_object_attribute_level();
 	test_object_attribute_short_cuts();
+	test_attribute_cache();
+	test_freeze();
+	test_grow_hash();
+	test_sort_attr_info();
 	test_object_printing();
 	test_object_debugging();
 
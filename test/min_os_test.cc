@@ -15,6 +15,7 @@
 //	Debugging Tests
 //	Parameter Tests
 //	Memory Management Tests
+//	Reservation Tests
 //	Memory File Tests
 
 // Setup
@@ -448,6 +449,12 @@ int main ( int argc, const char ** argv )
     MOS::trace_pools = 0;
     create_compare = true;
 
+    // These tests check changes to the process memory
+    // map, so they are run without a reservation (see
+    // Reservation Tests below).
+    //
+    reserve_size = 0;
+
     void * lower = (void *) 0x00FF0000;
     void * upper = (void *) 0xFFFF0000;
 
@@ -567,6 +574,69 @@ int main ( int argc, const char ** argv )
     cout << "Finish Memory Management Test" << endl
          << endl;
 
+// Reservation Tests
+// ----------- -----
+
+    cout << endl
+         << "Start Reservation Test" << endl;
+
+    create_compare = false;
+    reserve_inited = false;
+    reserve_size = 1000 * ::pagesize();
+
+    void * r100 = MOS::new_pool ( 100 );
+    MIN_CHECK ( MOS::pool_error ( r100 ) == NULL );
+    MIN_CHECK ( r100 == reserve_begin );
+    void * r200 = MOS::new_pool ( 200 );
+    MIN_CHECK ( r200 == page ( r100, 100 ) );
+    MIN_CHECK ( free_ranges_count == 1 );
+
+    set_pages ( 200, r200, 2000000 );
+    MOS::free_pool ( 100, r100 );
+    MIN_CHECK ( ! test_address ( r100 ) );
+    MIN_CHECK ( free_ranges_count == 2 );
+    MIN_CHECK ( check_pages ( 200, r200, 2000000 ) );
+
+    void * r50 = MOS::new_pool_between
+        ( 50, page ( r100, 10 ), page ( r100, 100 ) );
+    MIN_CHECK ( r50 == page ( r100, 10 ) );
+    MIN_CHECK ( free_ranges_count == 3 );
+    MIN_CHECK
+        (    MOS::pool_error ( MOS::new_pool_between
+	         ( 50, page ( r100, 70 ),
+		       page ( r100, 100 ) ) )
+	  != NULL );
+
+    MIN_CHECK
+        (    MOS::pool_error ( MOS::new_pool_at
+	         ( 20, page ( r100, 50 ) ) )
+	  != NULL );
+    void * r60 = MOS::new_pool_at
+        ( 40, page ( r100, 60 ) );
+    MIN_CHECK ( r60 == page ( r100, 60 ) );
+    void * r0 = MOS::new_pool_at ( 10, r100 );
+    MIN_CHECK ( r0 == r100 );
+    MIN_CHECK ( free_ranges_count == 1 );
+    MIN_CHECK ( free_ranges[0].start
+                == (char *) page ( r100, 300 ) );
+
+    void * big = MOS::new_pool ( 2000 );
+    MIN_CHECK ( MOS::pool_error ( big ) == NULL );
+    MIN_CHECK
+        ( ! in_reserve ( big, 2000 * ::pagesize() ) );
+    MOS::free_pool ( 2000, big );
+
+    MOS::free_pool ( 10, r0 );
+    MOS::free_pool ( 40, r60 );
+    MOS::free_pool ( 200, r200 );
+    MOS::free_pool ( 50, r50 );
+    MIN_CHECK ( free_ranges_count == 1 );
+    MIN_CHECK ( free_ranges[0].start == reserve_begin );
+    MIN_CHECK ( free_ranges[0].end == reserve_end );
+
+    cout << "Finish Reservation Test" << endl
+         << endl;
+
 // Memory File Tests
 // ------ ---- -----
 
@@ -0,0 +1,198 @@
+// MIN Attribute Info Sort Benchmark
+//
+// File:	min_sort_benchmark.cc
+// Author:	Bob Walton (walton@acm.org)
+// Date:	Sat Oct 17 09:00:00 EDT 2026
+//
+// The authors have placed this program in the public
+// domain; they make no warranty and accept no liability
+// for this program.
+
+// Table of Contents:
+//
+//	Setup
+//	Test Vectors
+//	Benchmarks
+//	Main Program
+
+// Setup
+// -----
+
+// This program is compiled with MIN_PARALLEL_SORT=1
+// (see min_parameters.h) and run by `make benchmark'.
+// It times min::sort_attr_info, with and without
+// threads, against the qsort it replaced.  It is not
+// part of `make test' as its output is timing
+// dependent.
+
+# include <iostream>
+# include <iomanip>
+# include <cstdlib>
+# include <cstring>
+# include <ctime>
+using std::cout;
+using std::endl;
+using std::setw;
+
+# define MIN_ASSERT MIN_ASSERT_CALL_ON_FAIL
+# include <min.h>
+# define MUP min::unprotected
+
+// Number of times each sort is timed.
+//
+const unsigned REPEAT = 5;
+
+static unsigned random_uns32 ( void )
+{
+    static unsigned long long x = 12345;
+    x = x * 6364136223846793005ull
+      + 1442695040888963407ull;
+    return (unsigned) ( x >> 33 );
+}
+
+// Test Vectors
+// ---- -------
+
+// Fill v[0..n-1] with names like those of a large
+// object: mostly strings with common prefixes, and
+// some numbers and labels, in random order.
+//
+static void make_info
+	( min::attr_info * v, min::unsptr n,
+	  min::gen names )
+{
+    min::obj_vec_insptr np ( names );
+    char buffer[40];
+    for ( min::unsptr i = 0; i < n; ++ i )
+    {
+	unsigned r = random_uns32();
+	min::gen name;
+	if ( i % 10 == 0 )
+	    name = min::new_num_gen ( r % 1000000 );
+	else
+	{
+	    sprintf ( buffer, "attribute-%u", r );
+	    name = min::new_str_gen ( buffer );
+	    if ( i % 10 == 1 )
+	    {
+		min::gen e[2] = { name, name };
+		name = min::new_lab_gen ( e, 2 );
+	    }
+	}
+	min::attr_push(np) = name;
+	v[i].name = name;
+	v[i].value = min::new_num_gen ( i );
+	v[i].flags = 0;
+	v[i].value_count = 1;
+	v[i].flag_count = 0;
+	v[i].reverse_attr_count = 0;
+    }
+}
+
+// Benchmarks
+// ----------
+
+static int compare_attr_info
+	( const void * aip1, const void * aip2 )
+{
+    min::gen name1 = ( (min::attr_info *) aip1 )->name;
+    min::gen name2 = ( (min::attr_info *) aip2 )->name;
+    return min::compare ( name1, name2 );
+}
+
+// Wall clock time in seconds, as clock() would count
+// the time of every sort thread.
+//
+static double now ( void )
+{
+    struct timespec ts;
+    clock_gettime ( CLOCK_MONOTONIC, & ts );
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+// Time REPEAT sorts of copies of v, leaving the last
+// sorted copy in out.  If use_qsort is true, use qsort
+// with min::compare, else min::sort_attr_info.
+//
+static double time_sort
+	( const char * title,
+	  min::attr_info * out,
+	  const min::attr_info * v, min::unsptr n,
+	  bool use_qsort )
+{
+    double time = 0;
+    for ( unsigned r = 0; r < REPEAT; ++ r )
+    {
+	memcpy ( (void *) out, v,
+	         n * sizeof ( min::attr_info ) );
+	double begin = now();
+	if ( use_qsort )
+	    qsort ( out, n, sizeof ( min::attr_info ),
+		    compare_attr_info );
+	else
+	    min::sort_attr_info ( out, n );
+	time += now() - begin;
+    }
+    cout << setw ( 30 ) << title
+         << setw ( 12 ) << std::fixed
+	 << std::setprecision ( 4 )
+	 << time / REPEAT << " seconds" << endl;
+    return time;
+}
+
+static bool same_names
+	( const min::attr_info * v1,
+	  const min::attr_info * v2, min::unsptr n )
+{
+    for ( min::unsptr i = 0; i < n; ++ i )
+    {
+	if ( v1[i].name != v2[i].name ) return false;
+    }
+    return true;
+}
+
+static void benchmark ( min::unsptr n )
+{
+    cout << n << " attributes:" << endl;
+
+    min::locatable_gen names;
+    names = min::new_obj_gen ( n );
+    min::attr_info * v = new min::attr_info[n];
+    min::attr_info * out1 = new min::attr_info[n];
+    min::attr_info * out2 = new min::attr_info[n];
+    make_info ( v, n, names );
+
+    time_sort ( "qsort:", out1, v, n, true );
+
+    min::parallel_sort_threshold = (min::unsptr) -1;
+    time_sort ( "sort_attr_info:", out2, v, n, false );
+    bool ok = same_names ( out1, out2, n );
+
+    min::parallel_sort_threshold = 0;
+    time_sort ( "parallel sort_attr_info:",
+                out2, v, n, false );
+    ok = ok && same_names ( out1, out2, n );
+
+    if ( ! ok )
+    {
+	cout << "ERROR: sorts disagree" << endl;
+	exit ( 1 );
+    }
+
+    delete [] v;
+    delete [] out1;
+    delete [] out2;
+}
+
+// Main Program
+// ---- -------
+
+int main ()
+{
+    min::initialize();
+
+    cout << "sort_threads = " << min::sort_threads
+         << endl;
+    benchmark ( 10000 );
+    benchmark ( 200000 );
+}
@@ -0,0 +1,297 @@
+// MIN String Hash Benchmark
+//
+// File:	min_strhash_benchmark.cc
+// Author:	Bob Walton (walton@acm.org)
+// Date:	Sat Oct 17 09:00:00 EDT 2026
+//
+// The authors have placed this program in the public
+// domain; they make no warranty and accept no liability
+// for this program.
+
+// Table of Contents:
+//
+//	Setup
+//	Test Strings
+//	Hash Checks
+//	Benchmarks
+//	Main Program
+
+// Setup
+// -----
+
+// This program is compiled once for each value of
+// MIN_STRHASH (see min_parameters.h) by `make
+// benchmark', and the outputs compared.  It is not
+// part of `make test' as its output is timing
+// dependent.
+
+# include <iostream>
+# include <iomanip>
+# include <cstdlib>
+# include <cstring>
+# include <ctime>
+using std::cout;
+using std::endl;
+using std::setw;
+
+# define MIN_ASSERT MIN_ASSERT_CALL_ON_FAIL
+# include <min.h>
+# include <min_acc.h>
+# define MUP min::unprotected
+# define MINT min::internal
+# define MACC min::acc
+
+// Test Strings
+// ---- -------
+
+// Number of test strings and their minimum and maximum
+// lengths.  Lengths include short strings (<= 8 char-
+// acters) and long identifier strings (<= min::max_
+// id_strlen).
+//
+const unsigned N = 200000;
+const unsigned MIN_LENGTH = 4;
+const unsigned MAX_LENGTH = 32;
+static char * strings[N];
+
+// Length of the long string used to measure hash speed
+// on long strings.
+//
+const unsigned LONG_LENGTH = 256;
+
+// Number of times each benchmark loop is repeated.
+//
+const unsigned REPEAT = 20;
+
+static unsigned random_uns32 ( void )
+{
+    static unsigned long long x = 12345;
+    x = x * 6364136223846793005ull
+      + 1442695040888963407ull;
+    return (unsigned) ( x >> 33 );
+}
+
+// Make identifier like strings, many sharing prefixes
+// as identifiers in programs do.
+//
+static void make_strings ( void )
+{
+    const char * chars =
+        "abcdefghijklmnopqrstuvwxyz"
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+	"0123456789_";
+    unsigned nchars = ::strlen ( chars );
+    for ( unsigned i = 0; i < N; ++ i )
+    {
+	unsigned length =
+	      MIN_LENGTH
+	    +   random_uns32()
+	      % ( MAX_LENGTH - MIN_LENGTH + 1 );
+	char * p = new char[length+1];
+	unsigned j = 0;
+	if ( i > 0 && random_uns32() % 2 == 0 )
+	{
+	    // Share a prefix with the last string.
+	    //
+	    unsigned prefix =
+	        random_uns32() % ( length + 1 );
+	    for ( ; j < prefix
+	            && strings[i-1][j] != 0; ++ j )
+	        p[j] = strings[i-1][j];
+	}
+	for ( ; j < length; ++ j )
+	    p[j] = chars[random_uns32() % nchars];
+	p[length] = 0;
+	strings[i] = p;
+    }
+}
+
+// Hash Checks
+// ---- ------
+
+// Check that hashes are non-zero and depend only on
+// the characters before the first NUL.
+//
+static bool check_hashes ( void )
+{
+    char buffer[MAX_LENGTH+10];
+    for ( unsigned i = 0; i < N; ++ i )
+    {
+	const char * p = strings[i];
+	min::unsptr n = ::strlen ( p );
+	min::uns32 hash = min::strhash ( p );
+	if ( hash == 0 )
+	    return false;
+	if ( hash != min::strnhash ( p, n ) )
+	    return false;
+	if ( hash != min::strnhash ( p, n + 5 ) )
+	    return false;
+
+	// Short string stubs hash 8 NUL padded
+	// characters.
+	//
+	if ( n <= 8 )
+	{
+	    memset ( buffer, 0, 8 );
+	    memcpy ( buffer, p, n );
+	    if ( hash != min::strnhash ( buffer, 8 ) )
+	        return false;
+	}
+	if ( n > 1 )
+	{
+	    strcpy ( buffer, p );
+	    buffer[n-1] = 0;
+	    if (    min::strnhash ( p, n - 1 )
+	         != min::strhash ( buffer ) )
+	        return false;
+	}
+    }
+    return true;
+}
+
+// Benchmarks
+// ----------
+
+static double seconds ( clock_t begin )
+{
+    return (double) ( clock() - begin )
+         / CLOCKS_PER_SEC;
+}
+
+static void print_rate
+	( const char * name, unsigned count,
+	  double time )
+{
+    cout << setw ( 30 ) << name
+         << setw ( 12 ) << std::fixed
+	 << std::setprecision ( 1 )
+	 << ( count / time ) / 1e6
+	 << " million/second" << endl;
+}
+
+// Print statistics of the lists of a hash table of
+// the given size holding all the test strings.
+//
+static void print_spread ( min::unsptr size )
+{
+    unsigned * count = new unsigned[size];
+    memset ( count, 0, size * sizeof ( unsigned ) );
+    for ( unsigned i = 0; i < N; ++ i )
+	++ count[min::strhash ( strings[i] )
+	         & ( size - 1 )];
+    unsigned empty = 0, max = 0;
+    double squares = 0;
+    for ( min::unsptr i = 0; i < size; ++ i )
+    {
+	if ( count[i] == 0 ) ++ empty;
+	if ( count[i] > max ) max = count[i];
+	squares += (double) count[i] * count[i];
+    }
+    // Expected number of string comparisons per
+    // successful lookup, which is 1 + load/2 for a
+    // uniformly random hash.
+    //
+    double probes = 0.5 + squares / ( 2.0 * N );
+    cout << setw ( 30 ) << "table size " << size
+         << ": empty lists " << empty
+	 << ", max list " << max
+	 << ", probes/lookup " << std::fixed
+	 << std::setprecision ( 2 ) << probes
+	 << endl;
+    delete[] count;
+}
+
+static void benchmark ( void )
+{
+    min::uns32 sum = 0;
+    clock_t begin = clock();
+    for ( unsigned r = 0; r < REPEAT; ++ r )
+    for ( unsigned i = 0; i < N; ++ i )
+        sum += min::strhash ( strings[i] );
+    print_rate ( "strhash:", REPEAT * N,
+                 seconds ( begin ) );
+
+    // Hash one long string repeatedly, to measure
+    // hash latency on long strings without cache
+    // misses.
+    //
+    char long_string[LONG_LENGTH+1];
+    for ( unsigned i = 0; i < LONG_LENGTH; ++ i )
+        long_string[i] = 'a' + i % 26;
+    long_string[LONG_LENGTH] = 0;
+    begin = clock();
+    for ( unsigned r = 0; r < REPEAT * N / 16; ++ r )
+    {
+        long_string[r % LONG_LENGTH] = 'a' + r % 26;
+        sum += min::strhash ( long_string );
+    }
+    print_rate ( "strhash 256 characters:",
+                 REPEAT * N / 16,
+                 seconds ( begin ) );
+
+    min::locatable_gen v;
+    v = min::new_obj_gen ( N );
+    min::obj_vec_insptr vp ( v );
+
+    begin = clock();
+    for ( unsigned i = 0; i < N; ++ i )
+	min::attr_push(vp) =
+	    min::new_str_gen ( strings[i] );
+    print_rate ( "new string interning:", N,
+                 seconds ( begin ) );
+
+    // Let collector increments resize the string
+    // hash tables.
+    //
+    while ( MINT::str_acc_hash_old != NULL
+            ||
+	       MINT::str_hash_count
+	    >    MACC::hash_max_load
+	       * MINT::str_hash_size )
+        MACC::collector_increment ( 0 );
+    cout << setw ( 30 ) << "string hash table size:"
+         << setw ( 12 ) << MINT::str_hash_size
+	 << endl;
+
+    unsigned found = 0;
+    begin = clock();
+    for ( unsigned r = 0; r < REPEAT; ++ r )
+    for ( unsigned i = 0; i < N; ++ i )
+	found +=
+	    (    min::new_str_gen ( strings[i] )
+	      == min::attr ( vp, i ) );
+    print_rate ( "existing string interning:",
+                 REPEAT * N, seconds ( begin ) );
+    if ( found != REPEAT * N )
+	cout << "ERROR: only " << found << " of "
+	     << REPEAT * N << " strings found"
+	     << endl;
+
+    print_spread ( MIN_DEFAULT_STR_HASH_SIZE );
+    print_spread ( 1 << 16 );
+
+    // Prevent the hash loop from being optimized
+    // away.
+    //
+    if ( sum == 0 ) cout << endl;
+}
+
+// Main Program
+// ---- -------
+
+int main ()
+{
+    min::initialize();
+
+    cout << "MIN_STRHASH = " << MIN_STRHASH
+         << ": " << N << " strings of length "
+	 << MIN_LENGTH << " to " << MAX_LENGTH << endl;
+
+    make_strings();
+    if ( ! check_hashes() )
+    {
+        cout << "ERROR: hash checks failed" << endl;
+	exit ( 1 );
+    }
+    benchmark();
+}